@@ -0,0 +1,78 @@
+/**
+ * @file Cpu.c
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Runtime CPU feature detection
+ *
+ */
+
+#include <intrin.h>
+#include <immintrin.h>
+#include "Cpu.h"
+
+static int cpu_feature_mask = -1;
+
+/**
+ * @brief Detects the instruction sets available
+ *
+ * The result is computed once with @c cpuid and cached. AVX2 and AVX-512
+ * are only reported when the operating system saves the extended registers
+ * on context switches (checked with @c xgetbv).
+ *
+ * @return A bit mask of @c CpuFeature values
+ */
+int cpu_features(void)
+{
+	if (cpu_feature_mask >= 0)
+		return cpu_feature_mask;
+
+	int info[4];
+	int mask = 0;
+
+	__cpuid(info, 0);
+
+	int max_leaf = info[0];
+
+	__cpuid(info, 1);
+
+	if (info[3] & (1 << 26))
+		mask |= CPU_SSE2;
+	if (info[2] & (1 << 19))
+		mask |= CPU_SSE41;
+	if (info[2] & (1 << 23))
+		mask |= CPU_POPCNT;
+
+	bool os_avx = false, os_avx512 = false;
+
+	// OSXSAVE and AVX
+	if ((info[2] & (1 << 27)) && (info[2] & (1 << 28)))
+	{
+		unsigned long long xcr0 = _xgetbv(0);
+
+		os_avx = (xcr0 & 0x06) == 0x06;
+		os_avx512 = (xcr0 & 0xE6) == 0xE6;
+	}
+
+	if (max_leaf >= 7)
+	{
+		__cpuidex(info, 7, 0);
+
+		if (os_avx && (info[1] & (1 << 5)))
+			mask |= CPU_AVX2;
+		if (os_avx512 && (info[1] & (1 << 16)))
+			mask |= CPU_AVX512F;
+		if (os_avx512 && (info[1] & (1 << 30)))
+			mask |= CPU_AVX512BW;
+	}
+
+	cpu_feature_mask = mask;
+
+	return mask;
+}
+
+bool cpu_has(CpuFeature feature)
+{
+	return (cpu_features() & feature) == (int)feature;
+}
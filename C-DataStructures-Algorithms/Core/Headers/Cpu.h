@@ -0,0 +1,40 @@
+/**
+ * @file Cpu.h
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Header for runtime CPU feature detection
+ *
+ * Used by structures that have SIMD kernels to pick, at runtime, the widest
+ * instruction set supported by the processor and the operating system.
+ *
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "Core.h"
+
+	/**
+	 * @brief Instruction set extensions that can be queried at runtime
+	 */
+	typedef enum CpuFeature {
+		CPU_SSE2     = 0x01, /**< SSE2, always present on x64 */
+		CPU_SSE41    = 0x02, /**< SSE4.1 */
+		CPU_AVX2     = 0x04, /**< AVX2 with OS support for YMM registers */
+		CPU_AVX512F  = 0x08, /**< AVX-512 Foundation with OS support for ZMM registers */
+		CPU_AVX512BW = 0x10, /**< AVX-512 Byte and Word instructions */
+		CPU_POPCNT   = 0x20  /**< POPCNT instruction */
+	} CpuFeature;
+
+	int cpu_features(void);
+
+	bool cpu_has(CpuFeature feature);
+
+#ifdef __cplusplus
+}
+#endif
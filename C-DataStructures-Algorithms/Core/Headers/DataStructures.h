@@ -16,6 +16,7 @@ extern "C" {
 
 #include "Array.h"
 #include "DynamicArray.h"
+#include "Scan.h"
 
 #include "SinglyLinkedList.h"
 #include "CircularLinkedList.h"
@@ -38,9 +39,20 @@ extern "C" {
 #include "Vector.h"
 
 #include "SString.h"
+#include "StringArena.h"
 
+#include "HashFunctions.h"
 #include "HashMap.h"
 #include "HashSet.h"
+#include "IntHashMap.h"
+#include "IntHashSet.h"
+#include "ConcurrentHashMap.h"
+#include "RCUHashMap.h"
+#include "GenericHashMap.h"
+#include "FileHashMap.h"
+#include "PerfectHash.h"
+#include "BloomFilter.h"
+#include "CuckooFilter.h"
 
 	int DataStructuresMenu(void);
 
@@ -47,6 +47,18 @@ extern "C" {
 
 	int HashMapTests(void);
 	int HashSetTests(void);
+	int IntHashMapTests(void);
+	int IntHashSetTests(void);
+	int ConcurrentHashMapTests(void);
+	int RCUHashMapTests(void);
+	int GenericHashMapTests(void);
+	int FileHashMapTests(void);
+	int PerfectHashTests(void);
+	int HashFunctionsTests(void);
+	int StringArenaTests(void);
+	int BloomFilterTests(void);
+	int CuckooFilterTests(void);
+	int ScanTests(void);
 
 	int ClockTests(void);
 
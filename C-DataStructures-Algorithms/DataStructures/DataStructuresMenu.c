@@ -186,23 +186,35 @@ int ds_all(void)
 	AVLTreeTests();
 	BinarySearchTreeTests();
 	BinaryTreeTests();
+	BloomFilterTests();
 	CircularBufferTests();
 	CircularLinkedListTests();
 	ClockTests();
+	ConcurrentHashMapTests();
+	CuckooFilterTests();
 	DequeArrayTests();
 	DequeTests();
 	DoublyLinkedListTests();
 	DynamicArrayTests();
+	FileHashMapTests();
+	GenericHashMapTests();
+	HashFunctionsTests();
 	HashMapTests();
 	HashSetTests();
+	IntHashMapTests();
+	IntHashSetTests();
+	PerfectHashTests();
 	PriorityQueueTests();
 	QueueArrayTests();
 	QueueTests();
+	RCUHashMapTests();
+	ScanTests();
 	SinglyLinkedListTests();
 	SparseMatrixTests();
 	SStringTests();
 	StackArrayTests();
 	StackTests();
+	StringArenaTests();
 	StructureConversionsTests();
 	TrieTests();
 	VectorTests();
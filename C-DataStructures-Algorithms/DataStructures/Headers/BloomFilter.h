@@ -0,0 +1,90 @@
+/**
+ * @file BloomFilter.h
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Header file for @c BloomFilter implementations in C
+ *
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "Core.h"
+
+#ifndef HASH_FUNCTION_TYPE
+#define HASH_FUNCTION_TYPE
+
+	typedef Status (*hash_function_t)(char *, size_t *);
+
+#endif
+
+#ifndef BLOOM_FILTER_SPEC
+#define BLOOM_FILTER_SPEC
+
+#define BLOOM_FILTER_BLOCK_BITS 512
+#define BLOOM_FILTER_BLOCK_WORDS (BLOOM_FILTER_BLOCK_BITS / 64)
+#define BLOOM_FILTER_MAX_HASHES 16
+
+#endif
+
+	/**
+	 * @brief A blocked Bloom filter of strings
+	 *
+	 * Answers whether a key may have been inserted: a key that was inserted
+	 * is always reported, while one that was not is reported with a
+	 * probability close to the @c fp_rate the filter was sized for. Keys can
+	 * not be removed, see @c CuckooFilter for that.
+	 *
+	 * The bits are split in blocks of @c BLOOM_FILTER_BLOCK_BITS, one cache
+	 * line each. A key selects a single block and sets @c hashes bits inside
+	 * it, so an insertion or a query touches one cache line no matter how
+	 * many bits are set. Blocks fill unevenly, so @c blf_init sizes the
+	 * filter and picks @c hashes from the false positive rate of a blocked
+	 * filter rather than that of a plain one.
+	 *
+	 * Keys are hashed once with @c hash_function, any @c hash_function_t used
+	 * by @c HashMap or @c HashSet works, and that hash is mixed with
+	 * @c hash_fmix64 before choosing the block and bits. The @c _hashed
+	 * functions take a hash the caller already has.
+	 *
+	 * @b Functions
+	 *
+	 * @c BloomFilter.c
+	 */
+	typedef struct BloomFilter
+	{
+		uint64_t *blocks;			   /*!< Bits of every block, 64 byte aligned */
+		size_t block_count;			   /*!< Number of blocks */
+		size_t hashes;				   /*!< Bits set per key */
+		size_t size;				   /*!< Keys inserted */
+		size_t capacity;			   /*!< Keys the filter was sized for */
+		double fp_rate;				   /*!< Target false positive rate at @c capacity keys */
+		double bits_per_key;		   /*!< Bits of the filter per key at @c capacity */
+		hash_function_t hash_function; /*!< Function used to hash keys */
+	} BloomFilter;
+
+	Status blf_init(BloomFilter **filter, size_t capacity, double fp_rate, hash_function_t hash_function);
+
+	Status blf_insert(BloomFilter *filter, char *key);
+	Status blf_insert_hashed(BloomFilter *filter, size_t hash);
+
+	bool blf_contains(BloomFilter *filter, char *key);
+	bool blf_contains_hashed(BloomFilter *filter, size_t hash);
+
+	Status blf_count_bits(BloomFilter *filter, size_t *result);
+	Status blf_estimate_fp_rate(size_t capacity, size_t bits, size_t hashes, double *result);
+
+	Status blf_display(BloomFilter *filter);
+
+	Status blf_erase(BloomFilter *filter);
+	Status blf_delete(BloomFilter **filter);
+
+#ifdef __cplusplus
+}
+#endif
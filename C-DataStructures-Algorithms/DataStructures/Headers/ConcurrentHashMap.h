@@ -0,0 +1,93 @@
+/**
+ * @file ConcurrentHashMap.h
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Header file for @c ConcurrentHashMap implementations in C
+ *
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <Windows.h>
+#include "Core.h"
+#include "HashMap.h"
+
+#ifndef CONCURRENT_HASH_MAP_SPEC
+#define CONCURRENT_HASH_MAP_SPEC
+
+#define CONCURRENT_HASH_MAP_SHARDS 64
+#define CONCURRENT_HASH_MAP_CACHE_LINE 64
+
+#endif
+
+	/**
+	 * @brief A @c HashMap and the lock that protects it
+	 *
+	 * Shards are padded so two locks never share a cache line.
+	 */
+	typedef struct ConcurrentHashMapShard
+	{
+		SRWLOCK lock;		   /*!< Reader-writer lock for @c map */
+		struct HashMap *map; /*!< Entries whose hash selects this shard */
+		char padding[CONCURRENT_HASH_MAP_CACHE_LINE - 2 * sizeof(void *)];
+	} ConcurrentHashMapShard;
+
+	/**
+	 * @brief A thread safe hash map with string keys and integer values
+	 *
+	 * A @c ConcurrentHashMap splits its keys across a power of two number of
+	 * shards, each one a regular @c HashMap behind its own @c SRWLOCK. Keys
+	 * are hashed once, outside of any lock, and the top bits of the scrambled
+	 * hash select the shard while the shard table keeps using the low bits.
+	 * Searches take the shard lock in shared mode so readers of the same
+	 * shard never block each other, and writers only block the shard they
+	 * modify.
+	 *
+	 * Shards always rehash at once, never incrementally, so a search never
+	 * modifies a shard. Counting takes every shard lock one at a time and is
+	 * therefore only a snapshot while other threads are writing.
+	 *
+	 * @b Functions
+	 *
+	 * @c ConcurrentHashMap.c
+	 */
+	typedef struct ConcurrentHashMap
+	{
+		struct ConcurrentHashMapShard *shards; /*!< Array of shards */
+		size_t shard_count;					   /*!< Number of shards, always a power of two */
+		size_t shard_bits;					   /*!< log2 of @c shard_count */
+		hash_function_t hash_function;		   /*!< Function used to hash keys */
+		hash_function_n_t hash_function_n;	   /*!< Length aware @c hash_function or @c NULL */
+	} ConcurrentHashMap;
+
+	Status cmap_init_map(ConcurrentHashMap **map, size_t shards, size_t size, hash_function_t hash_function);
+
+	Status cmap_insert(ConcurrentHashMap *map, char *key, int value);
+	Status cmap_insert_n(ConcurrentHashMap *map, char *key, size_t length, int value);
+
+	Status cmap_remove(ConcurrentHashMap *map, char *key);
+	Status cmap_remove_n(ConcurrentHashMap *map, char *key, size_t length);
+
+	Status cmap_search(ConcurrentHashMap *map, char *key, int *value);
+	Status cmap_search_n(ConcurrentHashMap *map, char *key, size_t length, int *value);
+	bool cmap_contains(ConcurrentHashMap *map, char *key);
+	bool cmap_contains_n(ConcurrentHashMap *map, char *key, size_t length);
+
+	Status cmap_count_entries(ConcurrentHashMap *map, size_t *result);
+	Status cmap_count_shard_max(ConcurrentHashMap *map, size_t *result);
+
+	Status cmap_display_map(ConcurrentHashMap *map);
+
+	Status cmap_delete_map(ConcurrentHashMap **map);
+	Status cmap_erase_map(ConcurrentHashMap *map);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,96 @@
+/**
+ * @file CuckooFilter.h
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Header file for @c CuckooFilter implementations in C
+ *
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "Core.h"
+
+#ifndef HASH_FUNCTION_TYPE
+#define HASH_FUNCTION_TYPE
+
+	typedef Status (*hash_function_t)(char *, size_t *);
+
+#endif
+
+#ifndef CUCKOO_FILTER_SPEC
+#define CUCKOO_FILTER_SPEC
+
+#define CUCKOO_FILTER_BUCKET_SIZE 4
+#define CUCKOO_FILTER_LOAD_FACTOR 0.95
+#define CUCKOO_FILTER_MAX_KICKS 500
+#define CUCKOO_FILTER_MIN_FINGERPRINT 4
+#define CUCKOO_FILTER_MAX_FINGERPRINT 16
+
+#endif
+
+	/**
+	 * @brief A cuckoo filter of strings
+	 *
+	 * Like a @c BloomFilter it answers whether a key may have been inserted,
+	 * with no false negatives, but it also supports removing keys that were
+	 * inserted. Removing a key that was never inserted may remove another
+	 * key with the same fingerprint instead.
+	 *
+	 * Each key is reduced to a fingerprint of @c fingerprint_bits bits that
+	 * is stored in one of two buckets of @c CUCKOO_FILTER_BUCKET_SIZE slots.
+	 * The second bucket is a hash of the fingerprint minus the first one,
+	 * so either bucket can be found from the other and a full
+	 * bucket evicts one of its fingerprints to its alternate bucket. The
+	 * false positive rate is about <code> 8 / 2^fingerprint_bits </code>
+	 * and fingerprints are packed, so each key costs a little over
+	 * @c fingerprint_bits bits.
+	 *
+	 * When @c CUCKOO_FILTER_MAX_KICKS evictions do not find a free slot the
+	 * last evicted fingerprint is kept aside in @c victim, so no key is ever
+	 * lost, and further insertions fail with @c DS_ERR_FULL.
+	 *
+	 * @b Functions
+	 *
+	 * @c CuckooFilter.c
+	 */
+	typedef struct CuckooFilter
+	{
+		uint64_t *slots;			   /*!< Packed fingerprints by slot, 0 marks a free slot */
+		size_t bucket_count;		   /*!< Number of buckets */
+		size_t fingerprint_bits;	   /*!< Bits of each fingerprint */
+		size_t size;				   /*!< Fingerprints stored, including @c victim */
+		size_t victim_bucket;		   /*!< Bucket @c victim was evicted from */
+		uint16_t victim;			   /*!< Fingerprint that found no slot or 0 */
+		uint64_t random;			   /*!< State used to pick the slot to evict */
+		hash_function_t hash_function; /*!< Function used to hash keys */
+	} CuckooFilter;
+
+	Status ckf_init(CuckooFilter **filter, size_t capacity, size_t fingerprint_bits, hash_function_t hash_function);
+
+	Status ckf_insert(CuckooFilter *filter, char *key);
+	Status ckf_insert_hashed(CuckooFilter *filter, size_t hash);
+
+	Status ckf_remove(CuckooFilter *filter, char *key);
+	Status ckf_remove_hashed(CuckooFilter *filter, size_t hash);
+
+	bool ckf_contains(CuckooFilter *filter, char *key);
+	bool ckf_contains_hashed(CuckooFilter *filter, size_t hash);
+
+	Status ckf_count_entries(CuckooFilter *filter, size_t *result);
+	Status ckf_count_bits(CuckooFilter *filter, size_t *result);
+
+	Status ckf_display(CuckooFilter *filter);
+
+	Status ckf_erase(CuckooFilter *filter);
+	Status ckf_delete(CuckooFilter **filter);
+
+#ifdef __cplusplus
+}
+#endif
@@ -17,11 +17,19 @@ extern "C"
 
 #include "Core.h"
 
+#ifndef INT_PREDICATE_TYPE
+#define INT_PREDICATE_TYPE
+
+	typedef bool (*int_predicate_t)(int, void *);
+
+#endif
+
 #ifndef DYNAMIC_ARRAY_SPEC
 #define DYNAMIC_ARRAY_SPEC
 
 #define DYNAMIC_ARRAY_INIT_SIZE 8
-#define DYNAMIC_ARRAY_GROW_RATE 2
+#define DYNAMIC_ARRAY_GROW_RATE 2.0
+#define DYNAMIC_ARRAY_COMMIT_SIZE 65536
 
 #endif
 
@@ -40,6 +48,38 @@ extern "C"
 	 * - As the array increases in size, shifting elements becomes more
 	 * time-consuming
 	 *
+	 * When full the capacity is multiplied by @c growth_rate, which can be
+	 * any value above 1 through @c dar_set_growth_rate. A factor below the
+	 * golden ratio, such as 1.5, lets the allocator reuse blocks freed by
+	 * earlier growths. @c dar_reserve allocates an exact capacity up front
+	 * and @c dar_shrink_to_fit returns unused capacity.
+	 *
+	 * An array created with @c dar_init_reserved reserves address space for
+	 * its maximum capacity and commits memory in chunks of
+	 * @c DYNAMIC_ARRAY_COMMIT_SIZE bytes as it grows, so the buffer never
+	 * moves and growing never copies elements. Growing past the reserved
+	 * capacity fails with @c DS_ERR_FULL.
+	 *
+	 * The free capacity is a gap that lies at the end of @c buffer, so that
+	 * insertions and removals move the elements after them with a single
+	 * @c memmove. With @c dar_set_gap_buffer the gap instead stays where the
+	 * last edit happened and is moved to the next one, which costs only the
+	 * distance between them. @c buffer then holds the elements before
+	 * @c gap followed by the gap and the remaining elements at the end.
+	 * Every function accounts for the gap, and @c dar_close_gap moves it
+	 * back to the end for code that reads @c buffer directly.
+	 *
+	 * @c dar_remove_keys and @c dar_remove_if compact the array in a single
+	 * pass that keeps the order of the remaining elements, the first with a
+	 * vectorized kernel from @c Scan.h. Both leave the gap at the end.
+	 *
+	 * A sorted array without repeated elements, as left by @c dar_sort and
+	 * @c dar_unique, works as a set of integers that takes four bytes per
+	 * element. Lookups are binary searches and @c dar_sorted_union,
+	 * @c dar_sorted_intersection and @c dar_sorted_difference walk both
+	 * arrays once, galloping over runs without matches. Sorting, merging
+	 * and set operations move the gap of their arrays to the end.
+	 *
 	 * @b Functions
 	 *
 	 * @c DynamicArray.c
@@ -49,10 +89,14 @@ extern "C"
 		int *buffer;		/*!< @c DynamicArray data buffer */
 		size_t size;		/*!< @c DynamicArray size */
 		size_t capacity;	/*!< @c DynamicArray total capacity */
-		size_t growth_rate; /*!< @c DynamicArray buffer growth rate */
+		double growth_rate; /*!< @c DynamicArray buffer growth rate */
+		size_t reserved;	/*!< Capacity of the reserved address space, 0 for a heap buffer */
+		bool gap_buffer;	/*!< If edits move the gap instead of shifting elements */
+		size_t gap;			/*!< Number of elements before the gap, @c size when it is at the end */
 	} DynamicArray;
 
 	Status dar_init(DynamicArray **dar);
+	Status dar_init_reserved(DynamicArray **dar, size_t max_capacity);
 	Status dar_make(DynamicArray **dar, int *array, size_t arr_size);
 
 	Status dar_insert(DynamicArray *dar, int *array, size_t arr_size, size_t index);
@@ -68,6 +112,7 @@ extern "C"
 	Status dar_remove_back(DynamicArray *dar);
 
 	Status dar_remove_keys(DynamicArray *dar, int value);
+	Status dar_remove_if(DynamicArray *dar, int_predicate_t predicate, void *data);
 
 	Status dar_display(DynamicArray *dar);
 	Status dar_display_raw(DynamicArray *dar);
@@ -98,20 +143,38 @@ extern "C"
 	Status dar_find_occurrance_last(DynamicArray *dar, int value, size_t *position);
 
 	Status dar_copy(DynamicArray *dar, DynamicArray **result);
-	//Status dar_merge_sorted(DynamicArray *dar1, DynamicArray *dar2, DynamicArray **result);
+	Status dar_merge_sorted(DynamicArray *dar1, DynamicArray *dar2, DynamicArray **result);
+	Status dar_merge_sorted_many(DynamicArray **dars, size_t count, DynamicArray **result);
 
 	Status dar_append(DynamicArray *dar1, DynamicArray *dar2);
 	Status dar_add(DynamicArray *dar1, DynamicArray *dar2, size_t index);
 	Status dar_prepend(DynamicArray *dar1, DynamicArray *dar2);
 
-	//Status dar_is_sorted(DynamicArray *dar, bool *result);
+	Status dar_is_sorted(DynamicArray *dar, bool *result);
 	//Status dar_reverse(DynamicArray *dar);
 	//Status dar_sort_bubble(DynamicArray *dar);
 	//Status dar_sort_selection(DynamicArray *dar);
 	//Status dar_sort_insertion(DynamicArray *dar);
+	Status dar_sort(DynamicArray *dar);
+	Status dar_unique(DynamicArray *dar);
+
+	Status dar_lower_bound(DynamicArray *dar, int value, size_t *position);
+	Status dar_upper_bound(DynamicArray *dar, int value, size_t *position);
+	Status dar_find_sorted(DynamicArray *dar, int value, size_t *position);
+	bool dar_contains_sorted(DynamicArray *dar, int value);
+
+	Status dar_sorted_union(DynamicArray *dar1, DynamicArray *dar2, DynamicArray **result);
+	Status dar_sorted_intersection(DynamicArray *dar1, DynamicArray *dar2, DynamicArray **result);
+	Status dar_sorted_difference(DynamicArray *dar1, DynamicArray *dar2, DynamicArray **result);
 
 	Status dar_grow(DynamicArray *dar, size_t size);
 	Status dar_realloc(DynamicArray *dar);
+	Status dar_reserve(DynamicArray *dar, size_t capacity);
+	Status dar_shrink_to_fit(DynamicArray *dar);
+	Status dar_set_growth_rate(DynamicArray *dar, double growth_rate);
+
+	Status dar_set_gap_buffer(DynamicArray *dar, bool enabled);
+	Status dar_close_gap(DynamicArray *dar);
 
 #ifdef __cplusplus
 }
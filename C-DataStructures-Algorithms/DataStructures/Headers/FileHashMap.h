@@ -0,0 +1,110 @@
+/**
+ * @file FileHashMap.h
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Header file for @c FileHashMap implementations in C
+ *
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <Windows.h>
+#include "Core.h"
+#include "HashMap.h"
+
+#ifndef FILE_HASH_MAP_SPEC
+#define FILE_HASH_MAP_SPEC
+
+#define FILE_HASH_MAP_MAGIC "DSHMAP01"
+#define FILE_HASH_MAP_VERSION 1
+#define FILE_HASH_MAP_LOAD_FACTOR 0.75
+
+#endif
+
+	/**
+	 * @brief Header at offset 0 of a @c FileHashMap file
+	 *
+	 * Every field has a fixed width and every reference inside the file is an
+	 * offset from its start, so the file can be mapped at any address.
+	 */
+	typedef struct FileHashMapHeader
+	{
+		char magic[8];			/*!< @c FILE_HASH_MAP_MAGIC */
+		uint32_t version;		/*!< @c FILE_HASH_MAP_VERSION */
+		uint32_t hash_id;		/*!< Built-in hash function used or 0 if unknown */
+		uint64_t size;			/*!< Number of entries */
+		uint64_t capacity;		/*!< Number of slots, always a power of two */
+		uint64_t slots_offset;	/*!< Offset of the slot array */
+		uint64_t keys_offset;	/*!< Offset of the key bytes */
+		uint64_t file_size;		/*!< Total bytes of the file */
+	} FileHashMapHeader;
+
+	/**
+	 * @brief A slot of a @c FileHashMap file
+	 *
+	 * A slot is empty when @c key_offset is 0. Keys are stored with a NUL
+	 * terminator that is not counted in @c length.
+	 */
+	typedef struct FileHashMapSlot
+	{
+		uint64_t hash;		 /*!< Full hash of the key */
+		uint64_t key_offset; /*!< Offset of the key or 0 if the slot is empty */
+		uint32_t length;	 /*!< Length of the key in bytes */
+		int32_t value;		 /*!< Entry value */
+	} FileHashMapSlot;
+
+	/**
+	 * @brief A read-only @c HashMap served directly from a mapped file
+	 *
+	 * @c fmap_write stores the entries of a @c HashMap in a Robin Hood table
+	 * laid out exactly as it is searched. @c fmap_open maps that file into
+	 * memory and @c fmap_search probes the mapping in place: nothing is
+	 * parsed, copied or allocated per entry, so opening a map costs the same
+	 * regardless of its size and pages are only read from disk as searches
+	 * touch them.
+	 *
+	 * Function pointers can not be stored in a file. The built-in hash
+	 * functions are recorded by an id and found again when the file is
+	 * opened; maps using any other function, or a custom length aware one,
+	 * are recorded with id 0 and must be opened with that same function and
+	 * given the length aware one with @c fmap_set_hash_function_n. Hashes
+	 * are stored with 64 bits.
+	 *
+	 * @b Functions
+	 *
+	 * @c FileHashMap.c
+	 */
+	typedef struct FileHashMap
+	{
+		const unsigned char *base;			 /*!< Start of the mapped file */
+		const struct FileHashMapHeader *header; /*!< Header at @c base */
+		const struct FileHashMapSlot *slots; /*!< Slot array inside the mapping */
+		HANDLE file;						 /*!< Open file */
+		HANDLE mapping;						 /*!< File mapping object */
+		hash_function_t hash_function;		 /*!< Function used to hash keys */
+		hash_function_n_t hash_function_n;	 /*!< Length aware @c hash_function or @c NULL */
+	} FileHashMap;
+
+	Status fmap_write(HashMap *map, const char *path);
+
+	Status fmap_open(FileHashMap **fmap, const char *path, hash_function_t hash_function);
+	Status fmap_close(FileHashMap **fmap);
+
+	Status fmap_set_hash_function_n(FileHashMap *fmap, hash_function_n_t hash_function_n);
+
+	Status fmap_search(FileHashMap *fmap, char *key, int *value);
+	Status fmap_search_n(FileHashMap *fmap, char *key, size_t length, int *value);
+	bool fmap_contains(FileHashMap *fmap, char *key);
+
+	Status fmap_count_entries(FileHashMap *fmap, size_t *result);
+
+#ifdef __cplusplus
+}
+#endif
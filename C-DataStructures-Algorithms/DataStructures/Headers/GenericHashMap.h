@@ -0,0 +1,113 @@
+/**
+ * @file GenericHashMap.h
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Header file for @c GenericHashMap implementations in C
+ *
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "Core.h"
+
+#ifndef GENERIC_HASH_FUNCTION_TYPE
+#define GENERIC_HASH_FUNCTION_TYPE
+
+	typedef Status (*generic_hash_function_t)(const void *, size_t, size_t *);
+
+#endif
+
+#ifndef COMPARE_FUNCTION_TYPE
+#define COMPARE_FUNCTION_TYPE
+
+	typedef int (*compare_function_t)(const void *, const void *, size_t);
+
+#endif
+
+#ifndef GENERIC_HASH_MAP_SPEC
+#define GENERIC_HASH_MAP_SPEC
+
+#define GENERIC_HASH_MAP_INIT_SIZE 16
+#define GENERIC_HASH_MAP_GROW_RATE 2
+#define GENERIC_HASH_MAP_LOAD_FACTOR 0.85
+#define GENERIC_HASH_MAP_ALIGNMENT 8
+
+#endif
+
+	/**
+	 * @brief An open-addressing hash map with keys and values of any fixed
+	 * size
+	 *
+	 * A @c GenericHashMap copies keys and values into its table, so a slot
+	 * is a small header followed by @c key_size bytes of key and
+	 * @c value_size bytes of value, each one aligned to
+	 * @c GENERIC_HASH_MAP_ALIGNMENT. Nothing is allocated per entry and a
+	 * lookup touches a single slot, the same Robin Hood linear probing and
+	 * backward shift deletion used by @c HashMap.
+	 *
+	 * Keys are hashed by @c hash_function and compared by @c compare_function,
+	 * which returns 0 for equal keys like @c memcmp does. Either can be
+	 * @c NULL at initialization to hash or compare the raw bytes of the key,
+	 * which is right for integers and plain structures without padding.
+	 * Keys holding pointers, like strings, need their own functions.
+	 *
+	 * Pointers returned by @c gmap_get and @c gmap_emplace point inside the
+	 * table and stay valid until the next insertion or removal.
+	 *
+	 * @b Functions
+	 *
+	 * @c GenericHashMap.c
+	 */
+	typedef struct GenericHashMap
+	{
+		unsigned char *table;				/*!< Flat array of slots */
+		unsigned char *scratch;				/*!< Two slots used while moving entries */
+		size_t size;						/*!< Number of entries */
+		size_t capacity;					/*!< Number of slots, always a power of two */
+		size_t key_size;					/*!< Bytes of a key */
+		size_t value_size;					/*!< Bytes of a value */
+		size_t value_offset;				/*!< Offset of the value inside a slot */
+		size_t stride;						/*!< Bytes of a slot */
+		double load_factor;					/*!< Maximum size / capacity ratio before growing */
+		generic_hash_function_t hash_function; /*!< Function used to hash keys */
+		compare_function_t compare_function;   /*!< Function used to compare keys */
+	} GenericHashMap;
+
+	Status gmap_init_map(GenericHashMap **map, size_t key_size, size_t value_size, size_t size, generic_hash_function_t hash_function, compare_function_t compare_function);
+
+	Status gmap_insert(GenericHashMap *map, const void *key, const void *value);
+	Status gmap_emplace(GenericHashMap *map, const void *key, void **value);
+
+	Status gmap_remove(GenericHashMap *map, const void *key);
+
+	Status gmap_search(GenericHashMap *map, const void *key, void *value);
+	Status gmap_get(GenericHashMap *map, const void *key, void **value);
+	bool gmap_contains(GenericHashMap *map, const void *key);
+
+	bool gmap_iter_next(GenericHashMap *map, size_t *cursor, void **key, void **value);
+
+	Status gmap_count_entries(GenericHashMap *map, size_t *result);
+	Status gmap_count_collisions_max(GenericHashMap *map, size_t *result);
+
+	Status gmap_display_map(GenericHashMap *map);
+
+	Status gmap_delete_map(GenericHashMap **map);
+	Status gmap_erase_map(GenericHashMap **map);
+
+	Status gmap_set_load_factor(GenericHashMap *map, double load_factor);
+	Status gmap_rehash(GenericHashMap *map, size_t size);
+
+	Status gmap_hash_bytes(const void *key, size_t size, size_t *hash);
+	Status gmap_hash_string(const void *key, size_t size, size_t *hash);
+	int gmap_compare_string(const void *key1, const void *key2, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,67 @@
+/**
+ * @file HashFunctions.h
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Header file for high throughput string hash functions
+ *
+ * These functions follow the @c hash_function_t signature and can be used
+ * by @c HashMap and @c HashSet in place of the byte at a time functions
+ * like @c map_hash_djb2. @c hash_fmix64 mixes integer keys for
+ * @c IntHashSet and @c IntHashMap.
+ *
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "Core.h"
+
+#ifndef HASH_FUNCTION_TYPE
+#define HASH_FUNCTION_TYPE
+
+	typedef Status (*hash_function_t)(char *, size_t *);
+
+#endif
+
+#ifndef HASH_FUNCTION_N_TYPE
+#define HASH_FUNCTION_N_TYPE
+
+	typedef Status (*hash_function_n_t)(char *, size_t, size_t *);
+
+#endif
+
+	/**
+	 * @brief Implementation used by @c hash_xxh3 for keys longer than 128
+	 * bytes
+	 *
+	 * Every kernel produces exactly the same hashes, they only differ in
+	 * speed. @c HASH_KERNEL_AUTO picks the widest one supported by the CPU.
+	 */
+	typedef enum HashKernel
+	{
+		HASH_KERNEL_AUTO = 0,	/**< Best kernel available */
+		HASH_KERNEL_SCALAR = 1, /**< Portable 64-bit implementation */
+		HASH_KERNEL_SSE2 = 2,	/**< Two 64-bit lanes per instruction */
+		HASH_KERNEL_AVX2 = 3	/**< Four 64-bit lanes per instruction */
+	} HashKernel;
+
+	Status hash_wyhash(char *key, size_t *hash);
+	Status hash_xxh3(char *key, size_t *hash);
+
+	Status hash_wyhash_n(char *key, size_t length, size_t *hash);
+	Status hash_xxh3_n(char *key, size_t length, size_t *hash);
+
+	size_t hash_fmix64(uint64_t key);
+
+	Status hash_set_kernel(HashKernel kernel);
+	HashKernel hash_get_kernel(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -16,6 +16,7 @@ extern "C"
 #endif
 
 #include "Core.h"
+#include "StringArena.h"
 
 #ifndef HASH_FUNCTION_TYPE
 #define HASH_FUNCTION_TYPE
@@ -24,29 +25,129 @@ extern "C"
 
 #endif
 
+#ifndef HASH_FUNCTION_N_TYPE
+#define HASH_FUNCTION_N_TYPE
+
+	typedef Status (*hash_function_n_t)(char *, size_t, size_t *);
+
+#endif
+
+#ifndef HASH_MAP_SPEC
+#define HASH_MAP_SPEC
+
+#define HASH_MAP_INIT_SIZE 16
+#define HASH_MAP_GROW_RATE 2
+#define HASH_MAP_LOAD_FACTOR 0.85
+#define HASH_MAP_REHASH_STEP 64
+#define HASH_MAP_BATCH 16
+#define HASH_MAP_STATS_PROBES 16
+
+#endif
+
+	/**
+	 * @brief A slot of a @c HashMap table
+	 *
+	 * Entries are stored inline in the table. A slot is empty when its @c key
+	 * is @c NULL.
+	 */
 	typedef struct HashMapEntry
 	{
-		char *key;
-		int value;
-		size_t hash;
-		struct HashMapEntry *next;
+		char *key;		/*!< Entry key or @c NULL if the slot is empty */
+		int value;		/*!< Entry value */
+		size_t hash;	/*!< Full hash of @c key */
+		size_t length;	/*!< Length of @c key in bytes */
 	} HashMapEntry;
 
+	/**
+	 * @brief Counters kept by a @c HashMap while it is used
+	 *
+	 * Counters are updated as a side effect of each operation and never
+	 * require a scan of the table. @c map_stats copies them together with
+	 * the current size and capacity of the map.
+	 */
+	typedef struct HashMapStats
+	{
+		size_t inserts;		/*!< Entries added */
+		size_t updates;		/*!< Inserts that replaced the value of an existing key */
+		size_t removes;		/*!< Entries removed */
+		size_t searches;	/*!< Searches, found or not */
+		size_t misses;		/*!< Searches of keys that were not in the map */
+		size_t probes;		/*!< Slots compared by all searches */
+		size_t probe_histogram[HASH_MAP_STATS_PROBES]; /*!< Searches by slots compared, the last bucket also counts longer ones */
+		size_t probe_max;	/*!< Longest probe sequence of an entry placed in the current table */
+		size_t resizes;		/*!< Tables allocated by growing or rehashing */
+		size_t size;		/*!< Number of entries when the snapshot was taken */
+		size_t capacity;	/*!< Number of slots when the snapshot was taken */
+		double load;		/*!< @c size / @c capacity when the snapshot was taken */
+	} HashMapStats;
+
+	/**
+	 * @brief An open-addressing hash map with string keys and integer values
+	 *
+	 * A @c HashMap stores its entries in a flat array using Robin Hood
+	 * linear probing: an entry that is farther from its home slot takes the
+	 * place of one that is closer to its own, keeping probe sequences short
+	 * and lookups cache friendly. The table capacity is always a power of two
+	 * and it grows by @c HASH_MAP_GROW_RATE once @c size exceeds
+	 * <code> capacity * load_factor </code>. Removed entries are deleted by
+	 * shifting the following entries back so no tombstones are left behind.
+	 *
+	 * By default growing rehashes the whole table at once. With a non-zero
+	 * @c rehash_step the map keeps the previous table around and migrates
+	 * at least @c rehash_step of its slots on every insert, search and
+	 * remove, so no single operation pays for the whole resize. While
+	 * migrating, lookups check both tables and new entries only go to the
+	 * new one.
+	 *
+	 * Every function taking a NUL terminated key has a @c _n counterpart
+	 * taking a pointer and a length. Entries store their key length so keys
+	 * are compared by hash, then length and then @c memcmp. When the map
+	 * knows a @c hash_function_n_t that matches @c hash_function, which is
+	 * automatic for the built-in functions, keys are scanned only once.
+	 *
+	 * After @c map_use_arena keys are copied into a @c StringArena owned by
+	 * the map instead of being allocated one by one. Keys of removed entries
+	 * are not reclaimed until the map is erased or deleted, which suits maps
+	 * that are built once and mostly read.
+	 *
+	 * Every map keeps a @c HashMapStats with a few counters per operation,
+	 * including the number of slots each search compared. These are cheap
+	 * enough to leave on and can be read at any time with @c map_stats to
+	 * tune the table size and hash function from real traffic. Maps shared
+	 * by concurrent readers should turn them off with @c map_set_stats.
+	 *
+	 * @b Functions
+	 *
+	 * @c HashMap.c
+	 */
 	typedef struct HashMap
 	{
-		struct HashMapEntry **hash_table;
-		size_t size;
-		hash_function_t hash_function;
+		struct HashMapEntry *hash_table; /*!< Flat array of slots */
+		size_t size;					 /*!< Number of entries */
+		size_t capacity;				 /*!< Number of slots, always a power of two */
+		double load_factor;				 /*!< Maximum size / capacity ratio before growing */
+		struct HashMapEntry *old_table;	 /*!< Table being migrated or @c NULL */
+		size_t old_capacity;			 /*!< Number of slots of @c old_table */
+		size_t rehash_index;			 /*!< Next slot of @c old_table to be migrated */
+		size_t rehash_left;				 /*!< Slots of @c old_table not yet visited */
+		size_t rehash_step;				 /*!< Slots migrated per operation, 0 to rehash at once */
+		hash_function_t hash_function;	 /*!< Function used to hash keys */
+		hash_function_n_t hash_function_n; /*!< Length aware @c hash_function or @c NULL */
+		struct StringArena *arena;		 /*!< Storage for keys or @c NULL to use @c malloc */
+		struct HashMapStats stats;		 /*!< Operation counters, see @c map_stats */
+		bool track_stats;				 /*!< Whether @c stats is updated */
 	} HashMap;
 
 	Status map_init_map(HashMap **map, size_t size, hash_function_t hash_function);
-	Status map_init_entry(HashMapEntry **entry, int value);
-
-	Status map_make_entry(HashMapEntry **entry, char *key, int value, size_t hash);
 
 	Status map_insert(HashMap *map, char *key, int value);
+	Status map_insert_n(HashMap *map, char *key, size_t length, int value);
+	Status map_insert_hashed(HashMap *map, char *key, size_t length, size_t hash, int value);
+	Status map_insert_bulk(HashMap *map, char **keys, int *values, size_t count);
 
-	//Status map_remove(HashMap *map, char *key);
+	Status map_remove(HashMap *map, char *key);
+	Status map_remove_n(HashMap *map, char *key, size_t length);
+	Status map_remove_hashed(HashMap *map, char *key, size_t length, size_t hash);
 
 	Status map_display_entry(HashMapEntry *entry);
 	Status map_display_map(HashMap *map);
@@ -57,17 +158,46 @@ extern "C"
 	Status map_erase_map(HashMap **map);
 
 	Status map_search(HashMap *map, char *key, int *value);
-	//Status map_search_all(HashMap *map, char *key, int **value);
+	Status map_search_n(HashMap *map, char *key, size_t length, int *value);
+	Status map_search_hashed(HashMap *map, char *key, size_t length, size_t hash, int *value);
+	Status map_search_batch(HashMap *map, char **keys, size_t count, int *values, bool *found);
+	bool map_contains(HashMap *map, char *key);
+	bool map_contains_n(HashMap *map, char *key, size_t length);
 
 	Status map_count_entries(HashMap *map, size_t *result);
 	Status map_count_collisions(HashMap *map, size_t *result);
 	Status map_count_empty(HashMap *map, size_t *result);
 	Status map_count_collisions_max(HashMap *map, size_t *result);
 
+	Status map_stats(HashMap *map, HashMapStats *stats);
+	Status map_stats_reset(HashMap *map);
+	Status map_display_stats(HashMapStats *stats);
+
+	Status map_set_load_factor(HashMap *map, double load_factor);
+	Status map_set_hash_function_n(HashMap *map, hash_function_n_t hash_function_n);
+	Status map_set_rehash_step(HashMap *map, size_t rehash_step);
+	Status map_use_arena(HashMap *map, size_t slab_size);
+	Status map_set_stats(HashMap *map, bool enabled);
+
+	Status map_rehash(HashMap *map, size_t size);
+	Status map_rehash_start(HashMap *map, size_t size);
+	Status map_rehash_step(HashMap *map);
+	Status map_rehash_finish(HashMap *map);
+
+	bool map_is_rehashing(HashMap *map);
+
 	Status map_hash_java(char *key, size_t *hash);
 	Status map_hash_djb2(char *key, size_t *hash);
 	Status map_hash_sdbm(char *key, size_t *hash);
 
+	Status map_hash_java_n(char *key, size_t length, size_t *hash);
+	Status map_hash_djb2_n(char *key, size_t length, size_t *hash);
+	Status map_hash_sdbm_n(char *key, size_t length, size_t *hash);
+
+	Status map_hash(HashMap *map, char *key, size_t length, size_t *hash);
+
+	hash_function_n_t map_hash_length_variant(hash_function_t hash_function);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
@@ -16,6 +16,7 @@ extern "C"
 #endif
 
 #include "Core.h"
+#include "StringArena.h"
 
 #ifndef HASH_FUNCTION_TYPE
 #define HASH_FUNCTION_TYPE
@@ -24,6 +25,13 @@ extern "C"
 
 #endif
 
+#ifndef HASH_FUNCTION_N_TYPE
+#define HASH_FUNCTION_N_TYPE
+
+	typedef Status (*hash_function_n_t)(char *, size_t, size_t *);
+
+#endif
+
 #ifndef REHASH_FUNCTION_TYPE
 #define REHASH_FUNCTION_TYPE
 
@@ -31,30 +39,95 @@ extern "C"
 
 #endif
 
+	// Receives an element and its length from the streaming set operations,
+	// which stop and return anything other than DS_OK
+	typedef Status (*set_visitor_t)(char *, size_t, void *);
+
+#ifndef HASH_SET_SPEC
+#define HASH_SET_SPEC
+
+#define HASH_SET_INIT_SIZE 16
+#define HASH_SET_GROW_RATE 2
+#define HASH_SET_LOAD_FACTOR 0.75
+#define HASH_SET_EMPTY 0
+#define HASH_SET_DISTANCE_MAX 0x0F
+#define HASH_SET_MAX_THREADS 64
+#define HASH_SET_PARALLEL_MIN 4096
+
+#endif
+
+	/**
+	 * @brief A slot of a @c HashSet table
+	 *
+	 * Slots are stored inline in the table. Whether a slot holds an element
+	 * is recorded in the metadata of the set, not here.
+	 */
 	typedef struct HashSetEntry
 	{
-		char *value;
-		size_t hash;
+		char *value;   /*!< Element or @c NULL if the slot is free */
+		size_t hash;   /*!< Full hash of @c value */
+		size_t length; /*!< Length of @c value in bytes */
 	} HashSetEntry;
 
+	/**
+	 * @brief An open-addressing hash set of strings
+	 *
+	 * The table capacity is always a power of two and it grows by
+	 * @c HASH_SET_GROW_RATE once @c size exceeds
+	 * <code> capacity * load_factor </code>, so a set never becomes full.
+	 *
+	 * Collisions are resolved with Robin Hood linear probing: an element
+	 * that is farther from its home slot takes the place of one that is
+	 * closer to its own. Removed elements are deleted by shifting the
+	 * following elements of their cluster back, so no tombstones are left
+	 * and long insert and remove churn does not make probes longer.
+	 *
+	 * Elements are stored inline in a flat slot array and every slot has a
+	 * byte of @c metadata: @c HASH_SET_EMPTY or four bits of the element
+	 * hash above the distance of the element from its home slot plus one,
+	 * saturated at @c HASH_SET_DISTANCE_MAX. Probes read the metadata first
+	 * and only touch slots whose element has the same home slot and the
+	 * same four hash bits as the key searched.
+	 *
+	 * The @c rehash_function is an optional policy for the home slot. When
+	 * set, its result is mixed into the hash before the home slot is taken,
+	 * which spreads the low bits of weak hash functions over the table.
+	 *
+	 * Set operations scan the smaller set where the result allows it and
+	 * presize their result. The @c _parallel variants split the scanned
+	 * tables among threads, which only read both sets, and the @c _each
+	 * variants hand every element of the result to a @c set_visitor_t
+	 * instead of building it. Stored hashes are reused whenever both sets
+	 * share their hash functions.
+	 *
+	 * @b Functions
+	 *
+	 * @c HashSet.c
+	 */
 	typedef struct HashSet
 	{
-		struct HashSetEntry **hash_table;
-		size_t size;
-		size_t max_size;
-		hash_function_t hash_function;
-		rehash_function_t rehash_function;
+		struct HashSetEntry *hash_table;   /*!< Flat array of slots */
+		uint8_t *metadata;				   /*!< State of each slot, probed before @c hash_table */
+		size_t size;					   /*!< Number of elements */
+		size_t capacity;				   /*!< Number of slots, always a power of two */
+		double load_factor;				   /*!< Maximum size / capacity ratio before growing */
+		hash_function_t hash_function;	   /*!< Function used to hash elements */
+		hash_function_n_t hash_function_n; /*!< Length aware @c hash_function or @c NULL */
+		rehash_function_t rehash_function; /*!< Home slot policy or @c NULL to use the hash */
+		struct StringArena *arena;		   /*!< Storage for keys or @c NULL to use @c malloc */
 	} HashSet;
 
-	Status set_init_set(HashSet **set, size_t max_size, hash_function_t hash_function, rehash_function_t rehash_function);
+	Status set_init_set(HashSet **set, size_t size, hash_function_t hash_function, rehash_function_t rehash_function);
 
 	Status set_init_entry(HashSetEntry **entry, char *value);
 
-	Status set_make_entry(HashSetEntry **entry, char *key, size_t hash);
+	Status set_make_entry(HashSetEntry **entry, char *key, size_t length, size_t hash);
 
 	Status set_insert(HashSet *set, char *value);
+	Status set_insert_n(HashSet *set, char *value, size_t length);
 
 	Status set_remove(HashSet *set, char *value);
+	Status set_remove_n(HashSet *set, char *value, size_t length);
 
 	Status set_display_entry(HashSetEntry *entry);
 	Status set_display_entry_raw(HashSetEntry *entry);
@@ -69,7 +142,16 @@ extern "C"
 	bool set_is_empty(HashSet *set);
 
 	Status set_contains(HashSet *set, char *value, bool *result);
+	Status set_contains_n(HashSet *set, char *value, size_t length, bool *result);
 	bool set_exists(HashSet *set, char *value);
+	bool set_exists_n(HashSet *set, char *value, size_t length);
+
+	Status set_set_load_factor(HashSet *set, double load_factor);
+	Status set_set_hash_function_n(HashSet *set, hash_function_n_t hash_function_n);
+	Status set_use_arena(HashSet *set, size_t slab_size);
+
+	Status set_rehash(HashSet *set, size_t size);
+	Status set_reserve(HashSet *set, size_t size);
 
 	Status set_count_elements(HashSet *set, size_t *result);
 	Status set_count_empty(HashSet *set, size_t *result);
@@ -80,10 +162,26 @@ extern "C"
 	Status set_complement(HashSet *set1, HashSet *set2, HashSet *result);
 	Status set_sym_diff(HashSet *set1, HashSet *set2, HashSet *result);
 
+	Status set_union_parallel(HashSet *set1, HashSet *set2, HashSet *result, size_t threads);
+	Status set_intersection_parallel(HashSet *set1, HashSet *set2, HashSet *result, size_t threads);
+	Status set_difference_parallel(HashSet *set1, HashSet *set2, HashSet *result, size_t threads);
+	Status set_sym_diff_parallel(HashSet *set1, HashSet *set2, HashSet *result, size_t threads);
+
+	Status set_union_each(HashSet *set1, HashSet *set2, set_visitor_t visitor, void *data);
+	Status set_intersection_each(HashSet *set1, HashSet *set2, set_visitor_t visitor, void *data);
+	Status set_difference_each(HashSet *set1, HashSet *set2, set_visitor_t visitor, void *data);
+	Status set_sym_diff_each(HashSet *set1, HashSet *set2, set_visitor_t visitor, void *data);
+
 	Status set_hash_djb2(char *key, size_t *hash);
 	Status set_hash_sdbm(char *key, size_t *hash);
 	Status set_hash_prime(char *key, size_t *hash);
 
+	Status set_hash_djb2_n(char *key, size_t length, size_t *hash);
+	Status set_hash_sdbm_n(char *key, size_t length, size_t *hash);
+	Status set_hash_prime_n(char *key, size_t length, size_t *hash);
+
+	hash_function_n_t set_hash_length_variant(hash_function_t hash_function);
+
 	Status set_rehash_rj(size_t *hash);
 	Status set_rehash_prime(size_t *hash);
 
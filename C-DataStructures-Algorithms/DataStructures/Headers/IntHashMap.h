@@ -0,0 +1,90 @@
+/**
+ * @file IntHashMap.h
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Header file for @c IntHashMap implementations in C
+ *
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "Core.h"
+
+#ifndef INT_HASH_MAP_SPEC
+#define INT_HASH_MAP_SPEC
+
+#define INT_HASH_MAP_INIT_SIZE 16
+#define INT_HASH_MAP_GROW_RATE 2
+#define INT_HASH_MAP_LOAD_FACTOR 0.85
+#define INT_HASH_MAP_EMPTY 0
+#define INT_HASH_MAP_DISTANCE_MAX 255
+
+#endif
+
+	/**
+	 * @brief A slot of an @c IntHashMap table
+	 */
+	typedef struct IntHashMapEntry
+	{
+		int64_t key; /*!< Entry key */
+		int value;	 /*!< Entry value */
+	} IntHashMapEntry;
+
+	/**
+	 * @brief A hash map from 64-bit integers to @c int
+	 *
+	 * Works like @c HashMap without any string handling: keys are stored
+	 * directly in the slots and hashed with @c hash_fmix64, so no operation
+	 * allocates or formats a key. 32-bit keys are simply widened.
+	 *
+	 * Collisions are resolved with Robin Hood linear probing and removals
+	 * shift the rest of their cluster back, so there are no tombstones.
+	 * Each slot has a byte of @c metadata holding @c INT_HASH_MAP_EMPTY or
+	 * the distance of its entry from its home slot plus one, saturated at
+	 * @c INT_HASH_MAP_DISTANCE_MAX.
+	 *
+	 * @b Functions
+	 *
+	 * @c IntHashMap.c
+	 */
+	typedef struct IntHashMap
+	{
+		struct IntHashMapEntry *hash_table; /*!< Flat array of slots */
+		uint8_t *metadata;					/*!< State of each slot, probed before @c hash_table */
+		size_t size;						/*!< Number of entries */
+		size_t capacity;					/*!< Number of slots, always a power of two */
+		double load_factor;					/*!< Maximum size / capacity ratio before growing */
+	} IntHashMap;
+
+	Status imap_init_map(IntHashMap **map, size_t size);
+
+	Status imap_insert(IntHashMap *map, int64_t key, int value);
+	Status imap_insert_bulk(IntHashMap *map, int64_t *keys, int *values, size_t count);
+
+	Status imap_remove(IntHashMap *map, int64_t key);
+
+	Status imap_display_map(IntHashMap *map);
+
+	Status imap_delete_map(IntHashMap **map);
+	Status imap_erase_map(IntHashMap **map);
+
+	Status imap_search(IntHashMap *map, int64_t key, int *value);
+	bool imap_contains(IntHashMap *map, int64_t key);
+
+	Status imap_count_entries(IntHashMap *map, size_t *result);
+
+	Status imap_set_load_factor(IntHashMap *map, double load_factor);
+
+	Status imap_rehash(IntHashMap *map, size_t size);
+	Status imap_reserve(IntHashMap *map, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
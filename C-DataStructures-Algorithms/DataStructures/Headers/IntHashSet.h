@@ -0,0 +1,100 @@
+/**
+ * @file IntHashSet.h
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Header file for @c IntHashSet implementations in C
+ *
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "Core.h"
+
+#ifndef INT_HASH_SET_SPEC
+#define INT_HASH_SET_SPEC
+
+#define INT_HASH_SET_INIT_SIZE 16
+#define INT_HASH_SET_GROW_RATE 2
+#define INT_HASH_SET_LOAD_FACTOR 0.75
+#define INT_HASH_SET_EMPTY 0
+#define INT_HASH_SET_DISTANCE_MAX 255
+
+#endif
+
+	// Receives every element produced by the streaming set operations, which
+	// stop and return anything other than DS_OK
+	typedef Status (*iset_visitor_t)(int64_t, void *);
+
+	/**
+	 * @brief A hash set of 64-bit integers
+	 *
+	 * Works like @c HashSet without any string handling: elements are
+	 * stored directly in a flat array of keys and hashed with
+	 * @c hash_fmix64, so inserting or searching an integer never allocates
+	 * or formats anything. 32-bit keys are simply widened.
+	 *
+	 * Collisions are resolved with Robin Hood linear probing and removals
+	 * shift the rest of their cluster back, so there are no tombstones.
+	 * Each slot has a byte of @c metadata holding @c INT_HASH_SET_EMPTY or
+	 * the distance of its element from its home slot plus one, saturated at
+	 * @c INT_HASH_SET_DISTANCE_MAX.
+	 *
+	 * @b Functions
+	 *
+	 * @c IntHashSet.c
+	 */
+	typedef struct IntHashSet
+	{
+		int64_t *keys;		/*!< Flat array of slots */
+		uint8_t *metadata;	/*!< State of each slot, probed before @c keys */
+		size_t size;		/*!< Number of elements */
+		size_t capacity;	/*!< Number of slots, always a power of two */
+		double load_factor; /*!< Maximum size / capacity ratio before growing */
+	} IntHashSet;
+
+	Status iset_init_set(IntHashSet **set, size_t size);
+
+	Status iset_insert(IntHashSet *set, int64_t key);
+	Status iset_insert_bulk(IntHashSet *set, int64_t *keys, size_t count);
+
+	Status iset_remove(IntHashSet *set, int64_t key);
+
+	Status iset_display_set(IntHashSet *set);
+	Status iset_display_elements(IntHashSet *set);
+
+	Status iset_delete_set(IntHashSet **set);
+	Status iset_erase_set(IntHashSet **set);
+
+	bool iset_is_empty(IntHashSet *set);
+
+	Status iset_contains(IntHashSet *set, int64_t key, bool *result);
+	bool iset_exists(IntHashSet *set, int64_t key);
+
+	Status iset_count_elements(IntHashSet *set, size_t *result);
+
+	Status iset_set_load_factor(IntHashSet *set, double load_factor);
+
+	Status iset_rehash(IntHashSet *set, size_t size);
+	Status iset_reserve(IntHashSet *set, size_t size);
+
+	Status iset_union(IntHashSet *set1, IntHashSet *set2, IntHashSet *result);
+	Status iset_intersection(IntHashSet *set1, IntHashSet *set2, IntHashSet *result);
+	Status iset_difference(IntHashSet *set1, IntHashSet *set2, IntHashSet *result);
+	Status iset_complement(IntHashSet *set1, IntHashSet *set2, IntHashSet *result);
+	Status iset_sym_diff(IntHashSet *set1, IntHashSet *set2, IntHashSet *result);
+
+	Status iset_union_each(IntHashSet *set1, IntHashSet *set2, iset_visitor_t visitor, void *data);
+	Status iset_intersection_each(IntHashSet *set1, IntHashSet *set2, iset_visitor_t visitor, void *data);
+	Status iset_difference_each(IntHashSet *set1, IntHashSet *set2, iset_visitor_t visitor, void *data);
+	Status iset_sym_diff_each(IntHashSet *set1, IntHashSet *set2, iset_visitor_t visitor, void *data);
+
+#ifdef __cplusplus
+}
+#endif
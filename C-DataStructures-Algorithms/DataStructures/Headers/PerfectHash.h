@@ -0,0 +1,97 @@
+/**
+ * @file PerfectHash.h
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Header file for @c PerfectHash implementations in C
+ *
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "Core.h"
+#include "HashMap.h"
+
+#ifndef PERFECT_HASH_SPEC
+#define PERFECT_HASH_SPEC
+
+#define PERFECT_HASH_GAMMA 1.0
+#define PERFECT_HASH_MAX_LEVELS 32
+#define PERFECT_HASH_MAX_FINGERPRINT 16
+#define PERFECT_HASH_KEY_BUFFER 256
+
+#endif
+
+	/**
+	 * @brief A minimal perfect hash function built from a fixed set of keys
+	 *
+	 * @c mph_build maps every one of @c size keys to a distinct index in
+	 * <code> [0, size) </code> using the BBHash scheme: each level is a bit
+	 * array of <code> gamma * n </code> bits for the @c n keys still left.
+	 * A key hashes to one bit per level and keeps the first bit no other
+	 * remaining key hashed to. The index of a key is the number of bits set
+	 * before its own, found with a table of counts sampled every 512 bits.
+	 * With the default @c gamma of 1.0 this takes a little over 3 bits per
+	 * key and most keys are found at the first or second level.
+	 *
+	 * Keys are hashed once with @c hash_function and every level mixes that
+	 * hash with its own seed, so any @c hash_function_t used by @c HashMap
+	 * works. Keys whose hashes are equal can not be told apart by any level
+	 * and are kept in a small @c HashMap after the last one.
+	 *
+	 * Like any perfect hash, a key that was not in the set still gets some
+	 * index. With @c fingerprint_bits set, each index also stores that many
+	 * bits of its key's hash and searches reject a non-member with
+	 * probability <code> 1 - 2^-fingerprint_bits </code>. The structure is
+	 * immutable once built.
+	 *
+	 * @b Functions
+	 *
+	 * @c PerfectHash.c
+	 */
+	typedef struct PerfectHash
+	{
+		uint64_t *bits;					   /*!< Bit arrays of every level, one after the other */
+		size_t *ranks;					   /*!< Set bits before each block of 512 bits */
+		size_t words;					   /*!< Total words of @c bits */
+		size_t levels;					   /*!< Number of levels */
+		size_t level_offset[PERFECT_HASH_MAX_LEVELS]; /*!< First bit of each level */
+		size_t level_size[PERFECT_HASH_MAX_LEVELS];	  /*!< Bits of each level */
+		size_t size;					   /*!< Number of keys */
+		size_t placed;					   /*!< Keys found by a level, the rest are in @c fallback */
+		struct HashMap *fallback;		   /*!< Keys no level could place or @c NULL */
+		uint64_t *fingerprints;			   /*!< Packed fingerprints by index or @c NULL */
+		size_t fingerprint_bits;		   /*!< Bits of each fingerprint, 0 to disable them */
+		int *values;					   /*!< Values by index or @c NULL */
+		double gamma;					   /*!< Bits per remaining key of each level */
+		hash_function_t hash_function;	   /*!< Function used to hash keys */
+		hash_function_n_t hash_function_n; /*!< Length aware @c hash_function or @c NULL */
+	} PerfectHash;
+
+	Status mph_build(PerfectHash **mph, char **keys, size_t count, int *values, size_t fingerprint_bits, hash_function_t hash_function);
+	Status mph_build_gamma(PerfectHash **mph, char **keys, size_t count, int *values, size_t fingerprint_bits, double gamma, hash_function_t hash_function);
+
+	Status mph_index(PerfectHash *mph, char *key, size_t *index);
+	Status mph_index_n(PerfectHash *mph, char *key, size_t length, size_t *index);
+
+	Status mph_search(PerfectHash *mph, char *key, int *value);
+	Status mph_search_n(PerfectHash *mph, char *key, size_t length, int *value);
+
+	bool mph_contains(PerfectHash *mph, char *key);
+
+	Status mph_count_entries(PerfectHash *mph, size_t *result);
+	Status mph_count_bits(PerfectHash *mph, size_t *result);
+
+	Status mph_display(PerfectHash *mph);
+
+	Status mph_delete(PerfectHash **mph);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,131 @@
+/**
+ * @file RCUHashMap.h
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Header file for @c RCUHashMap implementations in C
+ *
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <Windows.h>
+#include "Core.h"
+#include "HashMap.h"
+
+#ifndef RCU_HASH_MAP_SPEC
+#define RCU_HASH_MAP_SPEC
+
+#define RCU_HASH_MAP_INIT_SIZE 16
+#define RCU_HASH_MAP_LOAD_FACTOR 0.5
+#define RCU_HASH_MAP_MAX_READERS 128
+#define RCU_HASH_MAP_RECLAIM_BATCH 64
+#define RCU_HASH_MAP_CACHE_LINE 64
+
+#endif
+
+	/**
+	 * @brief Epoch announced by one reader thread
+	 *
+	 * Each reader only ever writes to its own slot, which is padded to a
+	 * cache line so readers never contend with each other.
+	 */
+	typedef struct RCUHashMapReader
+	{
+		volatile ULONG_PTR epoch; /*!< Epoch the reader entered or 0 when outside */
+		volatile LONG in_use;	  /*!< 1 if the slot belongs to a registered reader */
+		char padding[RCU_HASH_MAP_CACHE_LINE - sizeof(ULONG_PTR) - sizeof(LONG)];
+	} RCUHashMapReader;
+
+	/**
+	 * @brief A snapshot of the slots of a @c RCUHashMap
+	 *
+	 * Slots point to immutable @c HashMapEntry structures allocated together
+	 * with their key. The array of slots follows the table header.
+	 */
+	typedef struct RCUHashMapTable
+	{
+		size_t capacity;			   /*!< Number of slots, always a power of two */
+		size_t used;				   /*!< Slots holding an entry or a tombstone */
+		HashMapEntry *volatile *slots; /*!< Pointers to entries, @c NULL or a tombstone */
+	} RCUHashMapTable;
+
+	/**
+	 * @brief Memory unlinked by a writer, waiting for readers to move on
+	 */
+	typedef struct RCUHashMapRetired
+	{
+		void *pointer;	 /*!< Entry or table to be freed */
+		ULONG_PTR epoch; /*!< Global epoch when it was unlinked */
+	} RCUHashMapRetired;
+
+	/**
+	 * @brief A read-optimized concurrent hash map with string keys and
+	 * integer values
+	 *
+	 * Searches take no lock and perform no interlocked read-modify-write.
+	 * Writers are serialized by @c write_lock and never modify anything a
+	 * reader can see in place: inserting or updating a key publishes a new
+	 * @c HashMapEntry with a single pointer store, removing a key replaces
+	 * its pointer with a tombstone and growing builds a whole new table that
+	 * is published by swapping @c table.
+	 *
+	 * Unlinked entries and tables are freed through epoch based reclamation.
+	 * Every reader thread registers once and gets a private slot where
+	 * searches announce the global epoch they started in. Memory retired in
+	 * epoch @c e is only freed once no reader is still announcing an epoch
+	 * less than or equal to @c e. Announcing costs a plain store and a memory
+	 * fence on a cache line owned by the reader.
+	 *
+	 * Keys are hashed with the same @c hash_function_t plug-in as
+	 * @c HashMap.
+	 *
+	 * @b Functions
+	 *
+	 * @c RCUHashMap.c
+	 */
+	typedef struct RCUHashMap
+	{
+		struct RCUHashMapTable *volatile table;	 /*!< Current table, read without locks */
+		size_t size;							 /*!< Number of entries */
+		volatile ULONG_PTR epoch;				 /*!< Global epoch, starts at 1 */
+		struct RCUHashMapReader *readers;		 /*!< RCU_HASH_MAP_MAX_READERS reader slots */
+		struct RCUHashMapRetired *retired;		 /*!< Memory waiting to be freed */
+		size_t retired_size;					 /*!< Number of elements in @c retired */
+		size_t retired_capacity;				 /*!< Allocated length of @c retired */
+		SRWLOCK write_lock;						 /*!< Serializes writers */
+		hash_function_t hash_function;			 /*!< Function used to hash keys */
+		hash_function_n_t hash_function_n;		 /*!< Length aware @c hash_function or @c NULL */
+	} RCUHashMap;
+
+	Status rmap_init_map(RCUHashMap **map, size_t size, hash_function_t hash_function);
+
+	Status rmap_register_reader(RCUHashMap *map, size_t *reader);
+	Status rmap_unregister_reader(RCUHashMap *map, size_t reader);
+
+	Status rmap_insert(RCUHashMap *map, char *key, int value);
+	Status rmap_insert_n(RCUHashMap *map, char *key, size_t length, int value);
+
+	Status rmap_remove(RCUHashMap *map, char *key);
+	Status rmap_remove_n(RCUHashMap *map, char *key, size_t length);
+
+	Status rmap_search(RCUHashMap *map, size_t reader, char *key, int *value);
+	Status rmap_search_n(RCUHashMap *map, size_t reader, char *key, size_t length, int *value);
+	bool rmap_contains(RCUHashMap *map, size_t reader, char *key);
+
+	Status rmap_count_entries(RCUHashMap *map, size_t *result);
+	Status rmap_count_retired(RCUHashMap *map, size_t *result);
+
+	Status rmap_reclaim(RCUHashMap *map);
+
+	Status rmap_delete_map(RCUHashMap **map);
+
+#ifdef __cplusplus
+}
+#endif
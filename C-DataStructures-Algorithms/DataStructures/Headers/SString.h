@@ -20,11 +20,41 @@ extern "C"
 #ifndef STRING_SPEC
 #define STRING_SPEC
 
-#define STRING_INIT_SIZE 8
+#define STRING_INLINE_SIZE 24
 #define STRING_GROW_RATE 2
+#define STRING_PIECE_MAX 4096
 
 #endif
 
+	/**
+	 * @brief A run of characters of a @c String in piece table mode
+	 */
+	typedef struct StringPiece
+	{
+		size_t start;  /*!< Offset of the first character in its source */
+		size_t length; /*!< Number of characters */
+		bool added;	   /*!< If the characters are in @c added instead of @c buffer */
+	} StringPiece;
+
+	/**
+	 * @brief Edits of a @c String in piece table mode
+	 *
+	 * The characters of the string are the concatenation of @c pieces, each
+	 * one a run of the original @c buffer of the string, which is no longer
+	 * written, or of @c added, where inserted characters are appended.
+	 */
+	typedef struct StringPieceTable
+	{
+		StringPiece *pieces;   /*!< Pieces in string order */
+		size_t count;		   /*!< Number of pieces */
+		size_t capacity;	   /*!< Capacity of @c pieces */
+		char *added;		   /*!< Every character inserted since the last flatten */
+		size_t added_len;	   /*!< Characters in @c added */
+		size_t added_capacity; /*!< Capacity of @c added */
+		size_t cursor;		   /*!< Piece found by the last lookup */
+		size_t cursor_start;   /*!< Position in the string where @c cursor starts */
+	} StringPieceTable;
+
 	/**
 	 * @brief A wrapper for an array of characters
 	 *
@@ -39,16 +69,36 @@ extern "C"
 	 * @b Drawbacks
 	 * - None
 	 *
+	 * Strings shorter than @c STRING_INLINE_SIZE characters are kept in
+	 * @c small, inside the structure, and only move to the heap when they
+	 * outgrow it. @c buffer always points to the characters.
+	 *
+	 * Inserting into or removing from the middle of a large string moves
+	 * everything after that position. @c str_set_piece_table makes edits
+	 * cheap instead by describing the string as a table of pieces of its
+	 * original buffer and of a buffer of inserted characters, so an edit
+	 * only splits a piece. @c buffer then no longer holds the string and
+	 * @c str_flatten, which every other function calls first, copies the
+	 * pieces back into it. Edits close to the previous one find their piece
+	 * quickly and more than @c STRING_PIECE_MAX pieces flatten the string.
+	 *
+	 * Substrings are found with @c scan_find_bytes, which only compares the
+	 * needle where its first and last characters match and falls back to
+	 * the Two-Way algorithm when too many of those positions fail, so no
+	 * search is quadratic. @c str_find_next visits every occurrence.
+	 *
 	 * @b Functions
 	 *
 	 * @c SString.c
 	 */
 	typedef struct String
 	{
-		char *buffer;		/*!< Character buffer */
-		size_t len;			/*!< Word length */
-		size_t capacity;	/*!< Buffer capacity */
-		size_t growth_rate; /*!< Buffer capacity growth rate */
+		char *buffer;					 /*!< Character buffer, @c small while it fits */
+		size_t len;						 /*!< Word length */
+		size_t capacity;				 /*!< Buffer capacity */
+		size_t growth_rate;				 /*!< Buffer capacity growth rate */
+		struct StringPieceTable *pieces; /*!< Edits in piece table mode or NULL */
+		char small[STRING_INLINE_SIZE];	 /*!< Inline buffer for short strings */
 	} String;
 
 	Status str_init(String **str);
@@ -72,7 +122,7 @@ extern "C"
 	Status str_pop_char_at(String *str, size_t index);
 	Status str_pop_char_back(String *str);
 
-	//Status str_remove(String *str, size_t from, size_t to);
+	Status str_remove(String *str, size_t from, size_t to);
 	//Status str_slice(String *str, size_t from, size_t to, String *result);
 
 	Status str_display(String *str);
@@ -94,11 +144,13 @@ extern "C"
 
 	bool str_equals_str(String *str, char *string);
 
-	//bool str_substring(String *str1, String *str2);
-	//bool str_substr(String *str, char *ch);
+	bool str_substring(String *str1, String *str2);
+	bool str_substr(String *str, char *ch);
+
+	Status str_find_substring(String *str, String *key, size_t *pos);
+	Status str_find_substr(String *str, char *string, size_t *pos);
 
-	//Status str_find_substring(String *str, String *key, size_t *pos);
-	//Status str_find_substr(String *str, char *string, size_t *pos);
+	bool str_find_next(String *str, char *string, size_t *cursor, size_t *pos);
 
 	//Status str_reverse(String *str);
 
@@ -116,6 +168,9 @@ extern "C"
 
 	Status str_realloc(String *str);
 
+	Status str_set_piece_table(String *str, bool enabled);
+	Status str_flatten(String *str);
+
 #ifdef __cplusplus
 }
 #endif
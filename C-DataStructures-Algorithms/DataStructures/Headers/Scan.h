@@ -0,0 +1,61 @@
+/**
+ * @file Scan.h
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Header file for vectorized scans over buffers of integers and
+ * characters
+ *
+ * These functions back the search queries of @c Array and @c DynamicArray,
+ * the removal of keys from @c DynamicArray and the substring searches of
+ * @c String.
+ * Each one has a scalar, an SSE4.1, an AVX2 and an AVX-512 kernel and the
+ * widest one supported by the CPU is chosen at runtime.
+ *
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "Core.h"
+
+	/**
+	 * @brief Implementation used by the scan functions
+	 *
+	 * Every kernel returns exactly the same results, they only differ in
+	 * speed. @c SCAN_KERNEL_AUTO picks the widest one supported by the CPU.
+	 */
+	typedef enum ScanKernel
+	{
+		SCAN_KERNEL_AUTO = 0,	/**< Best kernel available */
+		SCAN_KERNEL_SCALAR = 1, /**< One element at a time */
+		SCAN_KERNEL_SSE41 = 2,	/**< Four 32-bit lanes per instruction */
+		SCAN_KERNEL_AVX2 = 3,	/**< Eight 32-bit lanes per instruction */
+		SCAN_KERNEL_AVX512 = 4	/**< Sixteen 32-bit lanes per instruction */
+	} ScanKernel;
+
+	size_t scan_count(const int *data, size_t size, int value);
+
+	size_t scan_find_first(const int *data, size_t size, int value);
+	size_t scan_find_last(const int *data, size_t size, int value);
+
+	int scan_max(const int *data, size_t size);
+	int scan_min(const int *data, size_t size);
+	size_t scan_max_pos(const int *data, size_t size);
+	size_t scan_min_pos(const int *data, size_t size);
+
+	size_t scan_remove(int *data, size_t size, int value);
+
+	size_t scan_find_bytes(const char *data, size_t size, const char *needle, size_t length);
+
+	Status scan_set_kernel(ScanKernel kernel);
+	ScanKernel scan_get_kernel(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -17,6 +17,13 @@ extern "C"
 
 #include "Core.h"
 
+#ifndef INT_PREDICATE_TYPE
+#define INT_PREDICATE_TYPE
+
+	typedef bool (*int_predicate_t)(int, void *);
+
+#endif
+
 	/**
 	 * A @c SinglyLinkedNode is what a @c SinglyLinkedList is composed of. It
 	 * has an integer as its data and only one pointer to the next @c
@@ -138,6 +145,7 @@ extern "C"
 	//Status sll_merge_sorted(SinglyLinkedList *sll1, SinglyLinkedList *sll2, SinglyLinkedList **result);
 
 	Status sll_remove_keys(SinglyLinkedList *sll, int key);
+	Status sll_remove_if(SinglyLinkedList *sll, int_predicate_t predicate, void *data);
 
 	Status sll_is_set_wrapper(SinglyLinkedList *sll, bool *result);
 	bool sll_is_set(SinglyLinkedList *sll);
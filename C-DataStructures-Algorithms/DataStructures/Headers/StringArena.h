@@ -0,0 +1,78 @@
+/**
+ * @file StringArena.h
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Header file for @c StringArena implementations in C
+ *
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "Core.h"
+
+#ifndef STRING_ARENA_SPEC
+#define STRING_ARENA_SPEC
+
+#define STRING_ARENA_SLAB_SIZE 65536
+#define STRING_ARENA_ALIGNMENT 16
+
+#endif
+
+	/**
+	 * @brief A block of memory owned by a @c StringArena
+	 *
+	 * The slab header is followed in the same allocation by @c size bytes.
+	 */
+	typedef struct StringArenaSlab
+	{
+		struct StringArenaSlab *next; /*!< Previously filled slab */
+		size_t size;				  /*!< Usable bytes after the header */
+		size_t used;				  /*!< Bytes already handed out */
+	} StringArenaSlab;
+
+	/**
+	 * @brief A bump allocator for many small strings with a shared lifetime
+	 *
+	 * A @c StringArena hands out memory from large slabs by bumping an offset,
+	 * so storing a string costs a @c memcpy instead of a call to @c malloc.
+	 * Memory is never returned one string at a time. Everything is released
+	 * at once by @c arn_delete_arena, or recycled by @c arn_reset which keeps
+	 * a single slab around for reuse.
+	 *
+	 * Requests larger than a quarter of @c slab_size get a slab of their own
+	 * so they do not waste the space left in the current one.
+	 *
+	 * @b Functions
+	 *
+	 * @c StringArena.c
+	 */
+	typedef struct StringArena
+	{
+		struct StringArenaSlab *head; /*!< Slab currently being filled */
+		size_t slab_size;			  /*!< Usable bytes of a regular slab */
+		size_t slabs;				  /*!< Number of slabs */
+		size_t reserved;			  /*!< Usable bytes across all slabs */
+		size_t used;				  /*!< Bytes handed out, including padding */
+	} StringArena;
+
+	Status arn_init_arena(StringArena **arena, size_t slab_size);
+
+	Status arn_alloc(StringArena *arena, size_t size, void **result);
+	Status arn_strdup(StringArena *arena, char *string, char **result);
+	Status arn_strndup(StringArena *arena, char *string, size_t length, char **result);
+
+	Status arn_display_arena(StringArena *arena);
+
+	Status arn_reset(StringArena *arena);
+	Status arn_delete_arena(StringArena **arena);
+
+#ifdef __cplusplus
+}
+#endif
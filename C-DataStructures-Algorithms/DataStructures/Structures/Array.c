@@ -9,6 +9,7 @@
  */
 
 #include "Array.h"
+#include "Scan.h"
 
 // +-------------------------------------------------------------------------------------------------+
 // |                                          Initializers                                           |
@@ -363,20 +364,7 @@ Status arr_max(Array *arr, int *result)
 	if (arr == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	size_t i;
-	int min = arr->buffer[0];
-
-	for (i = 1; i < arr->size; i++)
-	{
-
-		if (arr->buffer[i] > min)
-		{
-
-			min = arr->buffer[i];
-		}
-	}
-
-	*result = min;
+	*result = scan_max(arr->buffer, arr->size);
 
 	return DS_OK;
 }
@@ -388,20 +376,7 @@ Status arr_min(Array *arr, int *result)
 	if (arr == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	size_t i;
-	int min = arr->buffer[0];
-
-	for (i = 1; i < arr->size; i++)
-	{
-
-		if (arr->buffer[i] < min)
-		{
-
-			min = arr->buffer[i];
-		}
-	}
-
-	*result = min;
+	*result = scan_min(arr->buffer, arr->size);
 
 	return DS_OK;
 }
@@ -413,13 +388,7 @@ Status arr_frequency(Array *arr, int key, int *result)
 	if (arr == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	size_t i;
-	for (i = 0; i < arr->size; i++)
-	{
-
-		if (arr->buffer[i] == key)
-			(*result)++;
-	}
+	*result = (int)scan_count(arr->buffer, arr->size, key);
 
 	return DS_OK;
 }
@@ -0,0 +1,323 @@
+/**
+ * @file BloomFilter.c
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Source file for @c BloomFilter implementations in C
+ *
+ */
+
+#include <malloc.h>
+#include <intrin.h>
+#include "BloomFilter.h"
+#include "HashFunctions.h"
+
+#define BLOOM_FILTER_STEP 0.25
+#define BLOOM_FILTER_MAX_BITS_PER_KEY 64.0
+#define BLOOM_FILTER_MULTIPLIER 0x9E3779B9u
+#define BLOOM_FILTER_BIT_SHIFT 23 // 32 - log2(BLOOM_FILTER_BLOCK_BITS)
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Helpers                                             |
+// +-------------------------------------------------------------------------------------------------+
+
+// The block of a mixed hash, taken from its high bits
+static size_t blf_block(BloomFilter *filter, uint64_t x)
+{
+#if defined(_M_X64)
+	return (size_t)__umulh(x, (uint64_t)filter->block_count);
+#else
+	return (size_t)((x >> 32) * filter->block_count >> 32);
+#endif
+}
+
+// Bits are chosen inside the block from the low 32 bits of the hash, away
+// from the high bits that picked the block. Each bit takes the top bits of
+// the value, which is then multiplied by an odd constant for the next one.
+static uint64_t *blf_bits(BloomFilter *filter, uint64_t x, uint32_t *h)
+{
+	*h = (uint32_t)x;
+
+	return filter->blocks + blf_block(filter, x) * BLOOM_FILTER_BLOCK_WORDS;
+}
+
+// Probability that a block holding keys keys of hashes bits each reports a
+// key that was not inserted into it
+static double blf_block_fp_rate(double keys, size_t hashes)
+{
+	double zero = pow(1.0 - 1.0 / BLOOM_FILTER_BLOCK_BITS, keys * (double)hashes);
+
+	return pow(1.0 - zero, (double)hashes);
+}
+
+// Blocks receive a Poisson distributed number of keys, so the rate of the
+// whole filter is the rate of each block load weighted by its probability.
+// Probabilities are computed in log space as exp(-lambda) underflows for
+// small bits per key.
+static double blf_fp_rate(double bits_per_key, size_t hashes)
+{
+	double lambda = BLOOM_FILTER_BLOCK_BITS / bits_per_key;
+	double spread = 10.0 * sqrt(lambda) + 20.0;
+	double rate = 0.0;
+
+	size_t first = lambda > spread ? (size_t)(lambda - spread) : 0;
+	size_t last = (size_t)(lambda + spread);
+
+	size_t j;
+	for (j = first; j <= last; j++)
+		rate += exp((double)j * log(lambda) - lambda - lgamma((double)j + 1.0)) * blf_block_fp_rate((double)j, hashes);
+
+	return rate;
+}
+
+// Number of bits set per key close to optimal for bits_per_key
+static size_t blf_hashes(double bits_per_key)
+{
+	size_t hashes = (size_t)(bits_per_key * 0.6931471805599453 + 0.5);
+
+	if (hashes < 1)
+		return 1;
+
+	if (hashes > BLOOM_FILTER_MAX_HASHES)
+		return BLOOM_FILTER_MAX_HASHES;
+
+	return hashes;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                          Initializers                                           |
+// +-------------------------------------------------------------------------------------------------+
+
+// Creates a filter that holds capacity keys with a false positive rate of
+// at most fp_rate
+Status blf_init(BloomFilter **filter, size_t capacity, double fp_rate, hash_function_t hash_function)
+{
+	if (capacity == 0)
+		return DS_ERR_INVALID_SIZE;
+
+	if (fp_rate <= 0.0 || fp_rate >= 1.0 || hash_function == NULL)
+		return DS_ERR_INVALID_ARGUMENT;
+
+	double bits_per_key = BLOOM_FILTER_STEP;
+
+	while (bits_per_key < BLOOM_FILTER_MAX_BITS_PER_KEY && blf_fp_rate(bits_per_key, blf_hashes(bits_per_key)) > fp_rate)
+		bits_per_key += BLOOM_FILTER_STEP;
+
+	double bits = bits_per_key * (double)capacity;
+
+	size_t block_count = (size_t)(bits / BLOOM_FILTER_BLOCK_BITS) + 1;
+
+	*filter = malloc(sizeof(BloomFilter));
+
+	if (!(*filter))
+		return DS_ERR_ALLOC;
+
+	(*filter)->blocks = _aligned_malloc(block_count * BLOOM_FILTER_BLOCK_BITS / 8, 64);
+
+	if (!((*filter)->blocks))
+	{
+		free(*filter);
+
+		*filter = NULL;
+
+		return DS_ERR_ALLOC;
+	}
+
+	memset((*filter)->blocks, 0, block_count * BLOOM_FILTER_BLOCK_BITS / 8);
+
+	(*filter)->block_count = block_count;
+	(*filter)->hashes = blf_hashes(bits_per_key);
+	(*filter)->size = 0;
+	(*filter)->capacity = capacity;
+	(*filter)->fp_rate = fp_rate;
+	(*filter)->bits_per_key = bits_per_key;
+	(*filter)->hash_function = hash_function;
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                            Insertion                                            |
+// +-------------------------------------------------------------------------------------------------+
+
+Status blf_insert_hashed(BloomFilter *filter, size_t hash)
+{
+	if (filter == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	uint32_t h, bit;
+
+	uint64_t *block = blf_bits(filter, hash_fmix64(hash), &h);
+
+	size_t i;
+	for (i = 0; i < filter->hashes; i++)
+	{
+		bit = h >> BLOOM_FILTER_BIT_SHIFT;
+
+		block[bit >> 6] |= 1ull << (bit & 63);
+
+		h *= BLOOM_FILTER_MULTIPLIER;
+	}
+
+	(filter->size)++;
+
+	return DS_OK;
+}
+
+Status blf_insert(BloomFilter *filter, char *key)
+{
+	if (filter == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	size_t hash;
+
+	Status st = filter->hash_function(key, &hash);
+
+	if (st != DS_OK)
+		return st;
+
+	return blf_insert_hashed(filter, hash);
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Search                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+// The bits of a key are gathered into a mask per word of its block, so a
+// query is a handful of ANDs over a single cache line
+bool blf_contains_hashed(BloomFilter *filter, size_t hash)
+{
+	if (filter == NULL)
+		return false;
+
+	uint32_t h, bit;
+
+	uint64_t mask[BLOOM_FILTER_BLOCK_WORDS] = {0};
+
+	uint64_t *block = blf_bits(filter, hash_fmix64(hash), &h);
+
+	size_t i;
+	for (i = 0; i < filter->hashes; i++)
+	{
+		bit = h >> BLOOM_FILTER_BIT_SHIFT;
+
+		mask[bit >> 6] |= 1ull << (bit & 63);
+
+		h *= BLOOM_FILTER_MULTIPLIER;
+	}
+
+	uint64_t missing = 0;
+
+	for (i = 0; i < BLOOM_FILTER_BLOCK_WORDS; i++)
+		missing |= mask[i] & ~block[i];
+
+	return missing == 0;
+}
+
+bool blf_contains(BloomFilter *filter, char *key)
+{
+	if (filter == NULL || key == NULL)
+		return false;
+
+	size_t hash;
+
+	if (filter->hash_function(key, &hash) != DS_OK)
+		return false;
+
+	return blf_contains_hashed(filter, hash);
+}
+
+Status blf_count_bits(BloomFilter *filter, size_t *result)
+{
+	*result = 0;
+
+	if (filter == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	*result = filter->block_count * BLOOM_FILTER_BLOCK_BITS;
+
+	return DS_OK;
+}
+
+// Expected false positive rate of a filter of bits bits holding capacity
+// keys with hashes bits set per key
+Status blf_estimate_fp_rate(size_t capacity, size_t bits, size_t hashes, double *result)
+{
+	*result = 0.0;
+
+	if (capacity == 0 || bits == 0 || hashes == 0)
+		return DS_ERR_INVALID_ARGUMENT;
+
+	*result = blf_fp_rate((double)bits / (double)capacity, hashes);
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Display                                             |
+// +-------------------------------------------------------------------------------------------------+
+
+Status blf_display(BloomFilter *filter)
+{
+	if (filter == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	size_t bits = filter->block_count * BLOOM_FILTER_BLOCK_BITS;
+	size_t set = 0, i, j;
+
+	uint64_t x;
+
+	for (i = 0; i < filter->block_count * BLOOM_FILTER_BLOCK_WORDS; i++)
+	{
+		x = filter->blocks[i];
+
+		for (j = 0; x != 0; j++)
+			x &= x - 1;
+
+		set += j;
+	}
+
+	double expected = 0.0;
+
+	if (filter->size > 0)
+		expected = blf_fp_rate((double)bits / (double)filter->size, filter->hashes);
+
+	printf("\nBloom Filter");
+	printf("\n Keys: %zu of %zu  Target false positive rate: %lf", filter->size, filter->capacity, filter->fp_rate);
+	printf("\n Blocks: %zu  Bits: %zu  Bits per key: %.2lf  Hashes: %zu", filter->block_count, bits, filter->bits_per_key, filter->hashes);
+	printf("\n Bits set: %zu (%.2lf%%)  Expected false positive rate now: %lf", set, 100.0 * (double)set / (double)bits, expected);
+	printf("\n");
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Resets                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+Status blf_erase(BloomFilter *filter)
+{
+	if (filter == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	memset(filter->blocks, 0, filter->block_count * BLOOM_FILTER_BLOCK_BITS / 8);
+
+	filter->size = 0;
+
+	return DS_OK;
+}
+
+Status blf_delete(BloomFilter **filter)
+{
+	if ((*filter) == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	_aligned_free((*filter)->blocks);
+
+	free(*filter);
+
+	*filter = NULL;
+
+	return DS_OK;
+}
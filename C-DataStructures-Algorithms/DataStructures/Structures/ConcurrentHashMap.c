@@ -0,0 +1,396 @@
+/**
+ * @file ConcurrentHashMap.c
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Source file for @c ConcurrentHashMap implementations in C
+ *
+ */
+
+#include "ConcurrentHashMap.h"
+
+#define CONCURRENT_HASH_MAP_KEY_BUFFER 256
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                          Initializers                                           |
+// +-------------------------------------------------------------------------------------------------+
+
+// shards is rounded up to a power of two and size is the initial capacity
+// of the whole map, split evenly between shards
+Status cmap_init_map(ConcurrentHashMap **map, size_t shards, size_t size, hash_function_t hash_function)
+{
+	if (shards == 0 || size == 0)
+		return DS_ERR_INVALID_SIZE;
+
+	if (hash_function == NULL)
+		return DS_ERR_INVALID_ARGUMENT;
+
+	size_t count = 1, bits = 0;
+
+	while (count < shards)
+	{
+		count <<= 1;
+		bits++;
+	}
+
+	*map = malloc(sizeof(ConcurrentHashMap));
+
+	if (!(*map))
+		return DS_ERR_ALLOC;
+
+	(*map)->shards = malloc(sizeof(ConcurrentHashMapShard) * count);
+
+	if (!((*map)->shards))
+	{
+		free(*map);
+
+		*map = NULL;
+
+		return DS_ERR_ALLOC;
+	}
+
+	size_t i;
+	for (i = 0; i < count; i++)
+	{
+		Status st = map_init_map(&((*map)->shards[i].map), size / count + 1, hash_function);
+
+		if (st != DS_OK)
+		{
+			while (i > 0)
+				map_delete_map(&((*map)->shards[--i].map));
+
+			free((*map)->shards);
+			free(*map);
+
+			*map = NULL;
+
+			return st;
+		}
+
+		// Searches only take the shard lock shared and must not write
+		map_set_stats((*map)->shards[i].map, false);
+
+		InitializeSRWLock(&((*map)->shards[i].lock));
+	}
+
+	(*map)->shard_count = count;
+	(*map)->shard_bits = bits;
+	(*map)->hash_function = hash_function;
+	(*map)->hash_function_n = (*map)->shards[0].map->hash_function_n;
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                            Getters                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+// Same bytes hashed by every shard, computed before taking any lock
+static Status cmap_hash_key(ConcurrentHashMap *map, char *key, size_t length, bool terminated, size_t *hash)
+{
+	if (map->hash_function_n != NULL)
+		return map->hash_function_n(key, length, hash);
+
+	if (terminated)
+		return map->hash_function(key, hash);
+
+	char small[CONCURRENT_HASH_MAP_KEY_BUFFER];
+	char *buffer = small;
+
+	if (length >= CONCURRENT_HASH_MAP_KEY_BUFFER)
+	{
+		buffer = malloc(length + 1);
+
+		if (!buffer)
+			return DS_ERR_ALLOC;
+	}
+
+	memcpy(buffer, key, length);
+	buffer[length] = '\0';
+
+	Status st = map->hash_function(buffer, hash);
+
+	if (buffer != small)
+		free(buffer);
+
+	return st;
+}
+
+// Fibonacci hashing moves every bit of hash into the top bits, which are
+// independent from the low bits each shard uses to pick a slot
+static ConcurrentHashMapShard *cmap_shard(ConcurrentHashMap *map, size_t hash)
+{
+	if (map->shard_bits == 0)
+		return map->shards;
+
+#if SIZE_MAX > 0xFFFFFFFF
+	size_t mixed = hash * (size_t)0x9E3779B97F4A7C15;
+#else
+	size_t mixed = hash * (size_t)0x9E3779B9;
+#endif
+
+	return map->shards + (mixed >> (sizeof(size_t) * 8 - map->shard_bits));
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                            Insertion                                            |
+// +-------------------------------------------------------------------------------------------------+
+
+static Status cmap_insert_key(ConcurrentHashMap *map, char *key, size_t length, bool terminated, int value)
+{
+	size_t hash;
+
+	Status st = cmap_hash_key(map, key, length, terminated, &hash);
+
+	if (st != DS_OK)
+		return st;
+
+	ConcurrentHashMapShard *shard = cmap_shard(map, hash);
+
+	AcquireSRWLockExclusive(&(shard->lock));
+
+	st = map_insert_hashed(shard->map, key, length, hash, value);
+
+	ReleaseSRWLockExclusive(&(shard->lock));
+
+	return st;
+}
+
+Status cmap_insert(ConcurrentHashMap *map, char *key, int value)
+{
+	if (map == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return cmap_insert_key(map, key, strlen(key), true, value);
+}
+
+Status cmap_insert_n(ConcurrentHashMap *map, char *key, size_t length, int value)
+{
+	if (map == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return cmap_insert_key(map, key, length, false, value);
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Removal                                             |
+// +-------------------------------------------------------------------------------------------------+
+
+static Status cmap_remove_key(ConcurrentHashMap *map, char *key, size_t length, bool terminated)
+{
+	size_t hash;
+
+	Status st = cmap_hash_key(map, key, length, terminated, &hash);
+
+	if (st != DS_OK)
+		return st;
+
+	ConcurrentHashMapShard *shard = cmap_shard(map, hash);
+
+	AcquireSRWLockExclusive(&(shard->lock));
+
+	st = map_remove_hashed(shard->map, key, length, hash);
+
+	ReleaseSRWLockExclusive(&(shard->lock));
+
+	// An empty shard is not an error for the whole map
+	return st == DS_ERR_INVALID_OPERATION ? DS_ERR_NOT_FOUND : st;
+}
+
+Status cmap_remove(ConcurrentHashMap *map, char *key)
+{
+	if (map == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return cmap_remove_key(map, key, strlen(key), true);
+}
+
+Status cmap_remove_n(ConcurrentHashMap *map, char *key, size_t length)
+{
+	if (map == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return cmap_remove_key(map, key, length, false);
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Display                                             |
+// +-------------------------------------------------------------------------------------------------+
+
+Status cmap_display_map(ConcurrentHashMap *map)
+{
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	printf("\nConcurrent Hash Map\n");
+
+	size_t i;
+	for (i = 0; i < map->shard_count; i++)
+	{
+		ConcurrentHashMapShard *shard = map->shards + i;
+
+		AcquireSRWLockShared(&(shard->lock));
+
+		printf("\n[ %3zu ] %8zu entries %8zu slots", i, shard->map->size, shard->map->capacity);
+
+		ReleaseSRWLockShared(&(shard->lock));
+	}
+
+	printf("\n");
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Resets                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+// Not thread safe, no other thread may be using the map
+Status cmap_delete_map(ConcurrentHashMap **map)
+{
+	if ((*map) == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	size_t i;
+	for (i = 0; i < (*map)->shard_count; i++)
+		map_delete_map(&((*map)->shards[i].map));
+
+	free((*map)->shards);
+	free(*map);
+
+	*map = NULL;
+
+	return DS_OK;
+}
+
+// Empties one shard at a time, entries inserted concurrently might survive
+Status cmap_erase_map(ConcurrentHashMap *map)
+{
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	Status st = DS_OK;
+
+	size_t i;
+	for (i = 0; i < map->shard_count && st == DS_OK; i++)
+	{
+		ConcurrentHashMapShard *shard = map->shards + i;
+
+		AcquireSRWLockExclusive(&(shard->lock));
+
+		st = map_erase_map(&(shard->map));
+
+		ReleaseSRWLockExclusive(&(shard->lock));
+	}
+
+	return st;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Search                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+static Status cmap_search_key(ConcurrentHashMap *map, char *key, size_t length, bool terminated, int *value)
+{
+	size_t hash;
+
+	Status st = cmap_hash_key(map, key, length, terminated, &hash);
+
+	if (st != DS_OK)
+		return st;
+
+	ConcurrentHashMapShard *shard = cmap_shard(map, hash);
+
+	AcquireSRWLockShared(&(shard->lock));
+
+	st = map_search_hashed(shard->map, key, length, hash, value);
+
+	ReleaseSRWLockShared(&(shard->lock));
+
+	return st;
+}
+
+Status cmap_search(ConcurrentHashMap *map, char *key, int *value)
+{
+	*value = 0;
+
+	if (map == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return cmap_search_key(map, key, strlen(key), true, value);
+}
+
+Status cmap_search_n(ConcurrentHashMap *map, char *key, size_t length, int *value)
+{
+	*value = 0;
+
+	if (map == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return cmap_search_key(map, key, length, false, value);
+}
+
+bool cmap_contains(ConcurrentHashMap *map, char *key)
+{
+	int value;
+
+	return cmap_search(map, key, &value) == DS_OK;
+}
+
+bool cmap_contains_n(ConcurrentHashMap *map, char *key, size_t length)
+{
+	int value;
+
+	return cmap_search_n(map, key, length, &value) == DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Counts                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+Status cmap_count_entries(ConcurrentHashMap *map, size_t *result)
+{
+	*result = 0;
+
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	size_t i;
+	for (i = 0; i < map->shard_count; i++)
+	{
+		ConcurrentHashMapShard *shard = map->shards + i;
+
+		AcquireSRWLockShared(&(shard->lock));
+
+		*result += shard->map->size;
+
+		ReleaseSRWLockShared(&(shard->lock));
+	}
+
+	return DS_OK;
+}
+
+// Entries in the fullest shard, a measure of how evenly keys are spread
+Status cmap_count_shard_max(ConcurrentHashMap *map, size_t *result)
+{
+	*result = 0;
+
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	size_t i;
+	for (i = 0; i < map->shard_count; i++)
+	{
+		ConcurrentHashMapShard *shard = map->shards + i;
+
+		AcquireSRWLockShared(&(shard->lock));
+
+		if (shard->map->size > *result)
+			*result = shard->map->size;
+
+		ReleaseSRWLockShared(&(shard->lock));
+	}
+
+	return DS_OK;
+}
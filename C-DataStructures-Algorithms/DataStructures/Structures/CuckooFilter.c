@@ -0,0 +1,424 @@
+/**
+ * @file CuckooFilter.c
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Source file for @c CuckooFilter implementations in C
+ *
+ */
+
+#include <intrin.h>
+#include "CuckooFilter.h"
+#include "HashFunctions.h"
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Helpers                                             |
+// +-------------------------------------------------------------------------------------------------+
+
+static uint16_t ckf_get(CuckooFilter *filter, size_t slot)
+{
+	size_t pos = slot * filter->fingerprint_bits;
+	size_t word = pos >> 6, offset = pos & 63;
+
+	uint64_t value = filter->slots[word] >> offset;
+
+	if (offset + filter->fingerprint_bits > 64)
+		value |= filter->slots[word + 1] << (64 - offset);
+
+	return (uint16_t)(value & ((1ull << filter->fingerprint_bits) - 1));
+}
+
+static void ckf_set(CuckooFilter *filter, size_t slot, uint16_t fingerprint)
+{
+	size_t pos = slot * filter->fingerprint_bits;
+	size_t word = pos >> 6, offset = pos & 63;
+
+	uint64_t mask = (1ull << filter->fingerprint_bits) - 1;
+
+	filter->slots[word] = (filter->slots[word] & ~(mask << offset)) | ((uint64_t)fingerprint << offset);
+
+	if (offset + filter->fingerprint_bits > 64)
+	{
+		size_t high = 64 - offset;
+
+		filter->slots[word + 1] = (filter->slots[word + 1] & ~(mask >> high)) | ((uint64_t)fingerprint >> high);
+	}
+}
+
+// Maps x to [0, n) using its high bits
+static size_t ckf_range(uint64_t x, size_t n)
+{
+#if defined(_M_X64)
+	return (size_t)__umulh(x, (uint64_t)n);
+#else
+	return (size_t)((x >> 32) * n >> 32);
+#endif
+}
+
+// First bucket and fingerprint of a hash. A fingerprint is never 0, which
+// marks free slots.
+static void ckf_locate(CuckooFilter *filter, size_t hash, size_t *bucket, uint16_t *fingerprint)
+{
+	uint64_t x = hash_fmix64(hash);
+
+	*bucket = ckf_range(x, filter->bucket_count);
+	*fingerprint = (uint16_t)(x & ((1ull << filter->fingerprint_bits) - 1));
+
+	if (*fingerprint == 0)
+		*fingerprint = 1;
+}
+
+// The other bucket of a fingerprint, from either of its two buckets. Taking
+// bucket away from a hash of the fingerprint maps each bucket to the other
+// one for any number of buckets, where an XOR would need a power of two.
+static size_t ckf_alternate(CuckooFilter *filter, size_t bucket, uint16_t fingerprint)
+{
+	size_t target = ckf_range(hash_fmix64(fingerprint), filter->bucket_count);
+
+	return target >= bucket ? target - bucket : target + filter->bucket_count - bucket;
+}
+
+static bool ckf_bucket_has(CuckooFilter *filter, size_t bucket, uint16_t fingerprint)
+{
+	size_t i;
+	for (i = 0; i < CUCKOO_FILTER_BUCKET_SIZE; i++)
+	{
+		if (ckf_get(filter, bucket * CUCKOO_FILTER_BUCKET_SIZE + i) == fingerprint)
+			return true;
+	}
+
+	return false;
+}
+
+static bool ckf_bucket_add(CuckooFilter *filter, size_t bucket, uint16_t fingerprint)
+{
+	size_t i;
+	for (i = 0; i < CUCKOO_FILTER_BUCKET_SIZE; i++)
+	{
+		if (ckf_get(filter, bucket * CUCKOO_FILTER_BUCKET_SIZE + i) == 0)
+		{
+			ckf_set(filter, bucket * CUCKOO_FILTER_BUCKET_SIZE + i, fingerprint);
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool ckf_bucket_remove(CuckooFilter *filter, size_t bucket, uint16_t fingerprint)
+{
+	size_t i;
+	for (i = 0; i < CUCKOO_FILTER_BUCKET_SIZE; i++)
+	{
+		if (ckf_get(filter, bucket * CUCKOO_FILTER_BUCKET_SIZE + i) == fingerprint)
+		{
+			ckf_set(filter, bucket * CUCKOO_FILTER_BUCKET_SIZE + i, 0);
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static uint64_t ckf_random(CuckooFilter *filter)
+{
+	filter->random ^= filter->random << 13;
+	filter->random ^= filter->random >> 7;
+	filter->random ^= filter->random << 17;
+
+	return filter->random;
+}
+
+// Places a fingerprint in bucket or its alternate, evicting fingerprints to
+// their own alternate bucket while both are full. The fingerprint left over
+// after CUCKOO_FILTER_MAX_KICKS evictions becomes the victim.
+static void ckf_place(CuckooFilter *filter, size_t bucket, uint16_t fingerprint)
+{
+	if (ckf_bucket_add(filter, bucket, fingerprint))
+		return;
+
+	bucket = ckf_alternate(filter, bucket, fingerprint);
+
+	if (ckf_bucket_add(filter, bucket, fingerprint))
+		return;
+
+	size_t kick, slot;
+	uint16_t evicted;
+
+	for (kick = 0; kick < CUCKOO_FILTER_MAX_KICKS; kick++)
+	{
+		slot = bucket * CUCKOO_FILTER_BUCKET_SIZE + ckf_random(filter) % CUCKOO_FILTER_BUCKET_SIZE;
+
+		evicted = ckf_get(filter, slot);
+		ckf_set(filter, slot, fingerprint);
+		fingerprint = evicted;
+
+		bucket = ckf_alternate(filter, bucket, fingerprint);
+
+		if (ckf_bucket_add(filter, bucket, fingerprint))
+			return;
+	}
+
+	filter->victim = fingerprint;
+	filter->victim_bucket = bucket;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                          Initializers                                           |
+// +-------------------------------------------------------------------------------------------------+
+
+// Creates a filter with room for at least capacity keys. Fingerprints of
+// fingerprint_bits bits, from CUCKOO_FILTER_MIN_FINGERPRINT to
+// CUCKOO_FILTER_MAX_FINGERPRINT, set the false positive rate.
+Status ckf_init(CuckooFilter **filter, size_t capacity, size_t fingerprint_bits, hash_function_t hash_function)
+{
+	if (capacity == 0)
+		return DS_ERR_INVALID_SIZE;
+
+	if (fingerprint_bits < CUCKOO_FILTER_MIN_FINGERPRINT || fingerprint_bits > CUCKOO_FILTER_MAX_FINGERPRINT)
+		return DS_ERR_INVALID_ARGUMENT;
+
+	if (hash_function == NULL)
+		return DS_ERR_INVALID_ARGUMENT;
+
+	size_t bucket_count = (size_t)((double)capacity / (CUCKOO_FILTER_BUCKET_SIZE * CUCKOO_FILTER_LOAD_FACTOR)) + 1;
+
+	// One spare word so a fingerprint can always be read as two words
+	size_t words = (bucket_count * CUCKOO_FILTER_BUCKET_SIZE * fingerprint_bits + 63) / 64 + 1;
+
+	*filter = malloc(sizeof(CuckooFilter));
+
+	if (!(*filter))
+		return DS_ERR_ALLOC;
+
+	(*filter)->slots = calloc(words, sizeof(uint64_t));
+
+	if (!((*filter)->slots))
+	{
+		free(*filter);
+
+		*filter = NULL;
+
+		return DS_ERR_ALLOC;
+	}
+
+	(*filter)->bucket_count = bucket_count;
+	(*filter)->fingerprint_bits = fingerprint_bits;
+	(*filter)->size = 0;
+	(*filter)->victim_bucket = 0;
+	(*filter)->victim = 0;
+	(*filter)->random = 0x9E3779B97F4A7C15ull;
+	(*filter)->hash_function = hash_function;
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                            Insertion                                            |
+// +-------------------------------------------------------------------------------------------------+
+
+Status ckf_insert_hashed(CuckooFilter *filter, size_t hash)
+{
+	if (filter == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (filter->victim != 0)
+		return DS_ERR_FULL;
+
+	size_t bucket;
+	uint16_t fingerprint;
+
+	ckf_locate(filter, hash, &bucket, &fingerprint);
+
+	ckf_place(filter, bucket, fingerprint);
+
+	(filter->size)++;
+
+	return DS_OK;
+}
+
+Status ckf_insert(CuckooFilter *filter, char *key)
+{
+	if (filter == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	size_t hash;
+
+	Status st = filter->hash_function(key, &hash);
+
+	if (st != DS_OK)
+		return st;
+
+	return ckf_insert_hashed(filter, hash);
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Removal                                             |
+// +-------------------------------------------------------------------------------------------------+
+
+// Removes one copy of the fingerprint of a key. A slot freed this way lets
+// the victim, if any, go back into the table.
+Status ckf_remove_hashed(CuckooFilter *filter, size_t hash)
+{
+	if (filter == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	size_t bucket;
+	uint16_t fingerprint;
+
+	ckf_locate(filter, hash, &bucket, &fingerprint);
+
+	size_t alternate = ckf_alternate(filter, bucket, fingerprint);
+
+	if (filter->victim == fingerprint && (filter->victim_bucket == bucket || filter->victim_bucket == alternate))
+		filter->victim = 0;
+	else if (!ckf_bucket_remove(filter, bucket, fingerprint) && !ckf_bucket_remove(filter, alternate, fingerprint))
+		return DS_ERR_NOT_FOUND;
+
+	(filter->size)--;
+
+	if (filter->victim != 0)
+	{
+		fingerprint = filter->victim;
+		bucket = filter->victim_bucket;
+
+		filter->victim = 0;
+
+		ckf_place(filter, bucket, fingerprint);
+	}
+
+	return DS_OK;
+}
+
+Status ckf_remove(CuckooFilter *filter, char *key)
+{
+	if (filter == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	size_t hash;
+
+	Status st = filter->hash_function(key, &hash);
+
+	if (st != DS_OK)
+		return st;
+
+	return ckf_remove_hashed(filter, hash);
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Search                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+bool ckf_contains_hashed(CuckooFilter *filter, size_t hash)
+{
+	if (filter == NULL)
+		return false;
+
+	size_t bucket;
+	uint16_t fingerprint;
+
+	ckf_locate(filter, hash, &bucket, &fingerprint);
+
+	size_t alternate = ckf_alternate(filter, bucket, fingerprint);
+
+	if (filter->victim == fingerprint && (filter->victim_bucket == bucket || filter->victim_bucket == alternate))
+		return true;
+
+	return ckf_bucket_has(filter, bucket, fingerprint) || ckf_bucket_has(filter, alternate, fingerprint);
+}
+
+bool ckf_contains(CuckooFilter *filter, char *key)
+{
+	if (filter == NULL || key == NULL)
+		return false;
+
+	size_t hash;
+
+	if (filter->hash_function(key, &hash) != DS_OK)
+		return false;
+
+	return ckf_contains_hashed(filter, hash);
+}
+
+Status ckf_count_entries(CuckooFilter *filter, size_t *result)
+{
+	*result = 0;
+
+	if (filter == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	*result = filter->size;
+
+	return DS_OK;
+}
+
+// Bits used by fingerprint slots
+Status ckf_count_bits(CuckooFilter *filter, size_t *result)
+{
+	*result = 0;
+
+	if (filter == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	*result = filter->bucket_count * CUCKOO_FILTER_BUCKET_SIZE * filter->fingerprint_bits;
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Display                                             |
+// +-------------------------------------------------------------------------------------------------+
+
+Status ckf_display(CuckooFilter *filter)
+{
+	if (filter == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	size_t slots = filter->bucket_count * CUCKOO_FILTER_BUCKET_SIZE;
+
+	printf("\nCuckoo Filter");
+	printf("\n Keys: %zu  Buckets: %zu  Slots: %zu  Load: %.2lf%%", filter->size, filter->bucket_count, slots, 100.0 * (double)filter->size / (double)slots);
+	printf("\n Fingerprint bits: %zu  Expected false positive rate: %lf", filter->fingerprint_bits, 2.0 * CUCKOO_FILTER_BUCKET_SIZE / (double)(1ull << filter->fingerprint_bits));
+
+	if (filter->victim != 0)
+		printf("\n Full, holding a victim fingerprint");
+
+	printf("\n");
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Resets                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+Status ckf_erase(CuckooFilter *filter)
+{
+	if (filter == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	size_t words = (filter->bucket_count * CUCKOO_FILTER_BUCKET_SIZE * filter->fingerprint_bits + 63) / 64 + 1;
+
+	memset(filter->slots, 0, words * sizeof(uint64_t));
+
+	filter->size = 0;
+	filter->victim = 0;
+
+	return DS_OK;
+}
+
+Status ckf_delete(CuckooFilter **filter)
+{
+	if ((*filter) == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	free((*filter)->slots);
+	free(*filter);
+
+	*filter = NULL;
+
+	return DS_OK;
+}
@@ -8,266 +8,677 @@
  *
  */
 
+#include <Windows.h>
 #include "DynamicArray.h"
+#include "Scan.h"
+
+// Ranges this small are sorted by insertion
+#define DAR_INSERTION_SORT_SIZE 16
 
 // +-------------------------------------------------------------------------------------------------+
-// |                                          Initializers                                           |
+// |                                            Helpers                                              |
 // +-------------------------------------------------------------------------------------------------+
 
-Status dar_init(DynamicArray **dar)
+// Smallest capacity reached by the growth policy that holds size elements
+static size_t dar_next_capacity(DynamicArray *dar, size_t size)
 {
-	(*dar) = malloc(sizeof(DynamicArray));
+	size_t capacity = dar->capacity, next;
 
-	if (!(*dar))
-		return DS_ERR_ALLOC;
+	while (capacity < size)
+	{
+		next = (size_t)((double)capacity * dar->growth_rate);
 
-	(*dar)->buffer = calloc(DYNAMIC_ARRAY_INIT_SIZE, sizeof(int));
+		// Small capacities may not grow when multiplied by a low rate
+		capacity = next > capacity ? next : capacity + 1;
+	}
 
-	if (!((*dar)->buffer))
-		return DS_ERR_ALLOC;
+	// Growth stops at the end of the reserved address space
+	if (dar->reserved != 0 && capacity > dar->reserved && size <= dar->reserved)
+		return dar->reserved;
 
-	(*dar)->capacity = DYNAMIC_ARRAY_INIT_SIZE;
-	(*dar)->growth_rate = DYNAMIC_ARRAY_GROW_RATE;
+	return capacity;
+}
 
-	(*dar)->size = 0;
+// Elements after the gap, which always end at the end of the buffer
+static int *dar_tail(DynamicArray *dar)
+{
+	return dar->buffer + dar->capacity - (dar->size - dar->gap);
+}
+
+// Position in the buffer of the element at index
+static size_t dar_slot(DynamicArray *dar, size_t index)
+{
+	return index < dar->gap ? index : index + dar->capacity - dar->size;
+}
+
+// Moves the gap to index by moving the elements in between across it
+static void dar_move_gap(DynamicArray *dar, size_t index)
+{
+	size_t length = dar->capacity - dar->size;
+
+	if (index < dar->gap)
+		memmove(dar->buffer + index + length, dar->buffer + index, sizeof(int) * (dar->gap - index));
+	else if (index > dar->gap)
+		memmove(dar->buffer + dar->gap, dar->buffer + dar->gap + length, sizeof(int) * (index - dar->gap));
+
+	dar->gap = index;
+}
+
+// Sets the capacity of the buffer, moving the elements after the gap so
+// that they still end at the end of the buffer. Reserved arrays commit or
+// decommit whole chunks at the end of their address space and never move.
+static Status dar_resize(DynamicArray *dar, size_t capacity)
+{
+	if (capacity == 0)
+		capacity = 1;
+
+	if (dar->reserved != 0)
+	{
+		if (capacity > dar->reserved)
+			return DS_ERR_FULL;
+
+		size_t chunk = DYNAMIC_ARRAY_COMMIT_SIZE / sizeof(int);
+
+		capacity = (capacity + chunk - 1) / chunk * chunk;
+	}
+
+	size_t tail = dar->size - dar->gap, old_capacity = dar->capacity;
+
+	if (capacity < old_capacity && tail != 0)
+		memmove(dar->buffer + capacity - tail, dar->buffer + old_capacity - tail, sizeof(int) * tail);
+
+	if (dar->reserved == 0)
+	{
+		int *new_buffer = realloc(dar->buffer, sizeof(int) * capacity);
+
+		if (!new_buffer)
+		{
+			if (capacity < old_capacity && tail != 0)
+				memmove(dar->buffer + old_capacity - tail, dar->buffer + capacity - tail, sizeof(int) * tail);
+
+			return DS_ERR_ALLOC;
+		}
+
+		dar->buffer = new_buffer;
+	}
+	else if (capacity > old_capacity)
+	{
+		if (!VirtualAlloc(dar->buffer + old_capacity, (capacity - old_capacity) * sizeof(int), MEM_COMMIT, PAGE_READWRITE))
+			return DS_ERR_ALLOC;
+	}
+	else if (capacity < old_capacity)
+	{
+		VirtualFree(dar->buffer + capacity, (old_capacity - capacity) * sizeof(int), MEM_DECOMMIT);
+	}
+
+	if (capacity > old_capacity && tail != 0)
+		memmove(dar->buffer + capacity - tail, dar->buffer + old_capacity - tail, sizeof(int) * tail);
+
+	dar->capacity = capacity;
 
 	return DS_OK;
 }
 
-Status dar_make(DynamicArray **dar, int *array, size_t arr_size)
+// Makes room for count elements at index, which must be at most size, and
+// returns where they go. Without a gap buffer the elements from index on
+// are moved up at once; with one the gap is moved to index.
+static Status dar_open(DynamicArray *dar, size_t index, size_t count, int **slot)
 {
-	Status st = dar_init(dar);
+	Status st = dar_grow(dar, dar->size + count);
 
 	if (st != DS_OK)
 		return st;
 
-	size_t i;
-	for (i = 0; i < arr_size; i++)
+	if (dar->gap_buffer)
+		dar_move_gap(dar, index);
+	else
+		memmove(dar->buffer + index + count, dar->buffer + index, sizeof(int) * (dar->size - index));
+
+	*slot = dar->buffer + index;
+
+	dar->gap += count;
+	dar->size += count;
+
+	return DS_OK;
+}
+
+// Removes count elements starting at index
+static void dar_close(DynamicArray *dar, size_t index, size_t count)
+{
+	if (dar->gap_buffer)
+	{
+		// The removed elements follow the gap, which simply grows over them
+		dar_move_gap(dar, index);
+	}
+	else
 	{
-		st = dar_insert_back((*dar), array[i]);
+		memmove(dar->buffer + index, dar->buffer + index + count, sizeof(int) * (dar->size - index - count));
 
-		if (st != DS_OK)
-			return st;
+		dar->gap -= count;
 	}
 
-	return DS_OK;
+	dar->size -= count;
 }
 
-// +-------------------------------------------------------------------------------------------------+
-// |                                            Insertion                                            |
-// +-------------------------------------------------------------------------------------------------+
+// Scans run over the elements before the gap and then over the ones after
+// it, so searching never has to close the gap
 
-Status dar_insert(DynamicArray *dar, int *array, size_t arr_size, size_t index)
+static size_t dar_scan_count(DynamicArray *dar, int value)
 {
-	if (dar == NULL)
-		return DS_ERR_NULL_POINTER;
+	return scan_count(dar->buffer, dar->gap, value) + scan_count(dar_tail(dar), dar->size - dar->gap, value);
+}
 
-	if (index > dar->size)
-		return DS_ERR_INVALID_POSITION;
+static size_t dar_scan_first(DynamicArray *dar, int value)
+{
+	size_t i = scan_find_first(dar->buffer, dar->gap, value);
 
-	Status st;
+	if (i < dar->gap)
+		return i;
 
-	while (!dar_fits(dar, arr_size))
-	{
-		st = dar_realloc(dar);
+	i = scan_find_first(dar_tail(dar), dar->size - dar->gap, value);
 
-		if (st != DS_OK)
-			return st;
-	}
+	return dar->gap + i;
+}
+
+static size_t dar_scan_last(DynamicArray *dar, int value)
+{
+	size_t i = scan_find_last(dar_tail(dar), dar->size - dar->gap, value);
 
-	for (size_t i = dar->size; i > index; i--)
+	if (i < dar->size - dar->gap)
+		return dar->gap + i;
+
+	i = scan_find_last(dar->buffer, dar->gap, value);
+
+	return i < dar->gap ? i : dar->size;
+}
+
+static int dar_scan_max(DynamicArray *dar)
+{
+	int head = scan_max(dar->buffer, dar->gap);
+	int tail = scan_max(dar_tail(dar), dar->size - dar->gap);
+
+	if (dar->gap == 0)
+		return tail;
+
+	if (dar->gap == dar->size)
+		return head;
+
+	return head > tail ? head : tail;
+}
+
+static int dar_scan_min(DynamicArray *dar)
+{
+	int head = scan_min(dar->buffer, dar->gap);
+	int tail = scan_min(dar_tail(dar), dar->size - dar->gap);
+
+	if (dar->gap == 0)
+		return tail;
+
+	if (dar->gap == dar->size)
+		return head;
+
+	return head < tail ? head : tail;
+}
+
+// Keeps the elements for which predicate is false at the front of items, in
+// order, and returns how many were kept
+static size_t dar_filter(int *items, size_t size, int_predicate_t predicate, void *data)
+{
+	size_t kept = 0, i;
+
+	for (i = 0; i < size; i++)
 	{
-		dar->buffer[i + arr_size - 1] = dar->buffer[i - 1];
+		if (!predicate(items[i], data))
+			items[kept++] = items[i];
 	}
 
-	for (size_t i = index, j = 0; j < arr_size; i++, j++)
+	return kept;
+}
+
+// Joins the kept elements of each side of the gap, head elements already at
+// the start of the buffer and tail elements at its old position
+static void dar_join(DynamicArray *dar, int *tail, size_t head, size_t kept)
+{
+	memmove(dar->buffer + head, tail, sizeof(int) * kept);
+
+	dar->size = head + kept;
+	dar->gap = dar->size;
+}
+
+static bool dar_sorted_run(const int *data, size_t size)
+{
+	size_t i;
+	for (i = 1; i < size; i++)
 	{
-		dar->buffer[i] = array[j];
+		if (data[i - 1] > data[i])
+			return false;
 	}
 
-	dar->size += arr_size;
+	return true;
+}
 
-	return DS_OK;
+static void dar_sort_insertion_range(int *data, size_t size)
+{
+	size_t i, j;
+	int value;
+
+	for (i = 1; i < size; i++)
+	{
+		value = data[i];
+
+		for (j = i; j > 0 && data[j - 1] > value; j--)
+			data[j] = data[j - 1];
+
+		data[j] = value;
+	}
 }
 
-Status dar_insert_front(DynamicArray *dar, int value)
+static void dar_sift_down(int *data, size_t size, size_t root)
 {
-	if (dar == NULL)
-		return DS_ERR_NULL_POINTER;
+	int value = data[root];
+	size_t child;
 
-	if (dar_is_full(dar))
+	while ((child = 2 * root + 1) < size)
 	{
-		Status st = dar_realloc(dar);
+		if (child + 1 < size && data[child + 1] > data[child])
+			child++;
 
-		if (st != DS_OK)
-			return st;
+		if (data[child] <= value)
+			break;
+
+		data[root] = data[child];
+		root = child;
 	}
 
+	data[root] = value;
+}
+
+static void dar_sort_heap(int *data, size_t size)
+{
 	size_t i;
-	for (i = dar->size; i > 0; i--)
+	int temp;
+
+	for (i = size / 2; i > 0; i--)
+		dar_sift_down(data, size, i - 1);
+
+	for (i = size - 1; i > 0; i--)
 	{
-		dar->buffer[i] = dar->buffer[i - 1];
+		temp = data[0];
+		data[0] = data[i];
+		data[i] = temp;
+
+		dar_sift_down(data, i, 0);
 	}
+}
 
-	dar->buffer[0] = value;
+// Quicksort with a median of three pivot that leaves small ranges to
+// insertion sort and switches to heapsort once depth runs out, so that
+// inputs which keep unbalancing the partitions still take O(n log n)
+static void dar_sort_intro(int *data, size_t size, size_t depth)
+{
+	size_t i, j, left;
+	int a, b, c, pivot, temp;
 
-	(dar->size)++;
+	while (size > DAR_INSERTION_SORT_SIZE)
+	{
+		if (depth == 0)
+		{
+			dar_sort_heap(data, size);
+			return;
+		}
 
-	return DS_OK;
+		depth--;
+
+		a = data[0];
+		b = data[size / 2];
+		c = data[size - 1];
+
+		pivot = a < b ? (b < c ? b : (a < c ? c : a)) : (a < c ? a : (b < c ? c : b));
+
+		// Hoare partition, the median guarantees that neither side is empty
+		for (i = 0, j = size - 1;; i++, j--)
+		{
+			while (data[i] < pivot)
+				i++;
+			while (data[j] > pivot)
+				j--;
+
+			if (i >= j)
+				break;
+
+			temp = data[i];
+			data[i] = data[j];
+			data[j] = temp;
+		}
+
+		// Recursing into the smaller side bounds the stack to O(log n)
+		left = j + 1;
+
+		if (left < size - left)
+		{
+			dar_sort_intro(data, left, depth);
+			data += left;
+			size -= left;
+		}
+		else
+		{
+			dar_sort_intro(data + left, size - left, depth);
+			size = left;
+		}
+	}
+
+	dar_sort_insertion_range(data, size);
 }
 
-Status dar_insert_at(DynamicArray *dar, int value, size_t index)
+// Index of the first of size sorted elements that is not less than value
+static size_t dar_search_lower(const int *data, size_t size, int value)
 {
-	if (dar == NULL)
-		return DS_ERR_NULL_POINTER;
-
-	if (index > dar->size)
-		return DS_ERR_INVALID_POSITION;
+	if (size == 0)
+		return 0;
 
-	Status st;
+	const int *base = data;
+	size_t half;
 
-	if (index == 0)
+	while (size > 1)
 	{
-		st = dar_insert_front(dar, value);
+		half = size / 2;
 
-		if (st != DS_OK)
-			return st;
+		if (base[half] < value)
+			base += half;
+
+		size -= half;
 	}
-	else if (index == dar->size)
+
+	return (size_t)(base - data) + (*base < value);
+}
+
+// Index of the first of size sorted elements that is greater than value
+static size_t dar_search_upper(const int *data, size_t size, int value)
+{
+	if (size == 0)
+		return 0;
+
+	const int *base = data;
+	size_t half;
+
+	while (size > 1)
 	{
-		st = dar_insert_back(dar, value);
+		half = size / 2;
 
-		if (st != DS_OK)
-			return st;
+		if (base[half] <= value)
+			base += half;
+
+		size -= half;
 	}
-	else
+
+	return (size_t)(base - data) + (*base <= value);
+}
+
+// Same as dar_search_lower but probes 1, 2, 4... elements ahead before the
+// binary search, so it costs the log of the distance to the answer instead
+// of the log of size. Set operations use it to skip runs of one array that
+// have no match in the other.
+static size_t dar_gallop(const int *data, size_t size, int value)
+{
+	if (size == 0 || data[0] >= value)
+		return 0;
+
+	// data[low] is always less than value
+	size_t low = 0, step = 1;
+
+	while (step < size - low && data[low + step] < value)
 	{
-		if (dar_is_full(dar))
-		{
-			st = dar_realloc(dar);
+		low += step;
+		step <<= 1;
+	}
 
-			if (st != DS_OK)
-				return st;
-		}
+	size_t high = step < size - low ? low + step : size;
 
-		size_t i;
-		for (i = dar->size; i > index; i--)
-		{
-			dar->buffer[i] = dar->buffer[i - 1];
-		}
+	return low + 1 + dar_search_lower(data + low + 1, high - low - 1, value);
+}
 
-		dar->buffer[index] = value;
+// Creates the array that receives the result of a sorted operation with
+// room for capacity elements
+static Status dar_init_result(DynamicArray **result, size_t capacity)
+{
+	Status st = dar_init(result);
+
+	if (st != DS_OK)
+		return st;
+
+	return dar_reserve(*result, capacity);
+}
+
+// Moves the heap entry at root down to its place in a heap of the sources
+// of a k-way merge, ordered by their next element
+static void dar_merge_sift(DynamicArray **dars, size_t *positions, size_t *heap, size_t size, size_t root)
+{
+	size_t source = heap[root], child;
+	int value = dars[source]->buffer[positions[source]];
+
+	while ((child = 2 * root + 1) < size)
+	{
+		if (child + 1 < size &&
+			dars[heap[child + 1]]->buffer[positions[heap[child + 1]]] < dars[heap[child]]->buffer[positions[heap[child]]])
+			child++;
 
-		(dar->size)++;
+		if (dars[heap[child]]->buffer[positions[heap[child]]] >= value)
+			break;
+
+		heap[root] = heap[child];
+		root = child;
 	}
 
+	heap[root] = source;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                          Initializers                                           |
+// +-------------------------------------------------------------------------------------------------+
+
+Status dar_init(DynamicArray **dar)
+{
+	(*dar) = malloc(sizeof(DynamicArray));
+
+	if (!(*dar))
+		return DS_ERR_ALLOC;
+
+	(*dar)->buffer = calloc(DYNAMIC_ARRAY_INIT_SIZE, sizeof(int));
+
+	if (!((*dar)->buffer))
+		return DS_ERR_ALLOC;
+
+	(*dar)->capacity = DYNAMIC_ARRAY_INIT_SIZE;
+	(*dar)->growth_rate = DYNAMIC_ARRAY_GROW_RATE;
+	(*dar)->reserved = 0;
+	(*dar)->gap_buffer = false;
+	(*dar)->gap = 0;
+
+	(*dar)->size = 0;
+
 	return DS_OK;
 }
 
-Status dar_insert_back(DynamicArray *dar, int value)
+// Reserves address space for max_capacity elements, rounded up to whole
+// commit chunks, and commits the first chunk
+Status dar_init_reserved(DynamicArray **dar, size_t max_capacity)
 {
-	if (dar == NULL)
-		return DS_ERR_NULL_POINTER;
+	if (max_capacity == 0)
+		return DS_ERR_INVALID_SIZE;
 
-	if (dar_is_full(dar))
+	size_t chunk = DYNAMIC_ARRAY_COMMIT_SIZE / sizeof(int);
+	size_t reserved = (max_capacity + chunk - 1) / chunk * chunk;
+
+	(*dar) = malloc(sizeof(DynamicArray));
+
+	if (!(*dar))
+		return DS_ERR_ALLOC;
+
+	(*dar)->buffer = VirtualAlloc(NULL, reserved * sizeof(int), MEM_RESERVE, PAGE_NOACCESS);
+
+	if (!((*dar)->buffer))
 	{
-		Status st = dar_realloc(dar);
+		free(*dar);
 
-		if (st != DS_OK)
-			return st;
+		*dar = NULL;
+
+		return DS_ERR_ALLOC;
 	}
 
-	dar->buffer[dar->size] = value;
+	(*dar)->capacity = 0;
+	(*dar)->growth_rate = DYNAMIC_ARRAY_GROW_RATE;
+	(*dar)->reserved = reserved;
+	(*dar)->gap_buffer = false;
+	(*dar)->gap = 0;
 
-	(dar->size)++;
+	(*dar)->size = 0;
+
+	Status st = dar_resize(*dar, chunk);
+
+	if (st != DS_OK)
+	{
+		dar_delete(dar);
+
+		return st;
+	}
 
 	return DS_OK;
 }
 
-Status dar_update(DynamicArray *dar, int value, size_t index)
+Status dar_make(DynamicArray **dar, int *array, size_t arr_size)
 {
-	if (dar == NULL)
-		return DS_ERR_NULL_POINTER;
+	Status st = dar_init(dar);
 
-	if (dar_is_empty(dar))
-		return DS_ERR_INVALID_OPERATION;
+	if (st != DS_OK)
+		return st;
 
-	if (index >= dar->size)
-		return DS_ERR_INVALID_POSITION;
+	st = dar_reserve(*dar, arr_size);
 
-	dar->buffer[index] = value;
+	if (st != DS_OK)
+		return st;
 
-	return DS_OK;
+	return dar_insert(*dar, array, arr_size, 0);
 }
 
 // +-------------------------------------------------------------------------------------------------+
-// |                                             Removal                                             |
+// |                                            Insertion                                            |
 // +-------------------------------------------------------------------------------------------------+
 
-Status dar_remove(DynamicArray *dar, size_t from, size_t to)
+Status dar_insert(DynamicArray *dar, int *array, size_t arr_size, size_t index)
 {
 	if (dar == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	if (from > to)
-		return DS_ERR_INVALID_ARGUMENT;
+	if (index > dar->size)
+		return DS_ERR_INVALID_POSITION;
 
-	if (to >= dar->size)
+	int *slot;
+
+	Status st = dar_open(dar, index, arr_size, &slot);
+
+	if (st != DS_OK)
+		return st;
+
+	memcpy(slot, array, sizeof(int) * arr_size);
+
+	return DS_OK;
+}
+
+Status dar_insert_front(DynamicArray *dar, int value)
+{
+	return dar_insert_at(dar, value, 0);
+}
+
+Status dar_insert_at(DynamicArray *dar, int value, size_t index)
+{
+	if (dar == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (index > dar->size)
 		return DS_ERR_INVALID_POSITION;
 
-	if (dar_is_empty(dar))
-		return DS_ERR_INVALID_OPERATION;
+	int *slot;
 
-	Status st;
+	Status st = dar_open(dar, index, 1, &slot);
 
-	// 'from' and 'to' are inclusive
-	size_t distance = to - from + 1;
+	if (st != DS_OK)
+		return st;
+
+	*slot = value;
+
+	return DS_OK;
+}
+
+Status dar_insert_back(DynamicArray *dar, int value)
+{
+	if (dar == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	// The gap is already at the end unless a gap buffer moved it
+	if (dar->gap != dar->size)
+		return dar_insert_at(dar, value, dar->size);
 
-	if (from == to)
+	if (dar_is_full(dar))
 	{
-		st = dar_remove_at(dar, from);
+		Status st = dar_realloc(dar);
 
 		if (st != DS_OK)
 			return st;
-
-		return DS_OK;
 	}
-	else if (to == dar->size - 1)
-	{
-		dar->size -= distance;
 
-		return DS_OK;
-	}
+	dar->buffer[dar->size] = value;
 
-	for (size_t i = from, j = to + 1; j <= dar->size - 1; i++, j++)
-	{
-		dar->buffer[i] = dar->buffer[j];
-	}
+	(dar->size)++;
+	(dar->gap)++;
+
+	return DS_OK;
+}
+
+Status dar_update(DynamicArray *dar, int value, size_t index)
+{
+	if (dar == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (dar_is_empty(dar))
+		return DS_ERR_INVALID_OPERATION;
+
+	if (index >= dar->size)
+		return DS_ERR_INVALID_POSITION;
 
-	dar->size -= distance;
+	dar->buffer[dar_slot(dar, index)] = value;
 
 	return DS_OK;
 }
 
-Status dar_remove_front(DynamicArray *dar)
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Removal                                             |
+// +-------------------------------------------------------------------------------------------------+
+
+Status dar_remove(DynamicArray *dar, size_t from, size_t to)
 {
 	if (dar == NULL)
 		return DS_ERR_NULL_POINTER;
 
+	if (from > to)
+		return DS_ERR_INVALID_ARGUMENT;
+
+	if (to >= dar->size)
+		return DS_ERR_INVALID_POSITION;
+
 	if (dar_is_empty(dar))
 		return DS_ERR_INVALID_OPERATION;
 
-	size_t i;
-	for (i = 0; i < dar->size; i++)
-	{
-		dar->buffer[i] = dar->buffer[i + 1];
-	}
-
-	(dar->size)--;
+	// 'from' and 'to' are inclusive
+	dar_close(dar, from, to - from + 1);
 
 	return DS_OK;
 }
 
+Status dar_remove_front(DynamicArray *dar)
+{
+	return dar_remove_at(dar, 0);
+}
+
 Status dar_remove_at(DynamicArray *dar, size_t index)
 {
 	if (dar == NULL)
@@ -279,32 +690,7 @@ Status dar_remove_at(DynamicArray *dar, size_t index)
 	if (index >= dar->size)
 		return DS_ERR_INVALID_POSITION;
 
-	Status st;
-
-	if (index == 0)
-	{
-		st = dar_remove_front(dar);
-
-		if (st != DS_OK)
-			return st;
-	}
-	else if (index == dar->size - 1)
-	{
-		st = dar_remove_back(dar);
-
-		if (st != DS_OK)
-			return st;
-	}
-	else
-	{
-		size_t i;
-		for (i = index; i < dar->size; i++)
-		{
-			dar->buffer[i] = dar->buffer[i + 1];
-		}
-
-		(dar->size)--;
-	}
+	dar_close(dar, index, 1);
 
 	return DS_OK;
 }
@@ -317,7 +703,7 @@ Status dar_remove_back(DynamicArray *dar)
 	if (dar_is_empty(dar))
 		return DS_ERR_INVALID_OPERATION;
 
-	(dar->size)--;
+	dar_close(dar, dar->size - 1, 1);
 
 	return DS_OK;
 }
@@ -330,21 +716,30 @@ Status dar_remove_keys(DynamicArray *dar, int value)
 	if (dar_is_empty(dar))
 		return DS_ERR_INVALID_OPERATION;
 
-	Status st;
+	int *tail = dar_tail(dar);
 
-	size_t i;
-	for (i = 0; i < dar->size; i++)
-	{
-		if (dar->buffer[i] == value)
-		{
-			st = dar_remove_at(dar, i);
+	size_t head = scan_remove(dar->buffer, dar->gap, value);
+	size_t kept = scan_remove(tail, dar->size - dar->gap, value);
 
-			if (st != DS_OK)
-				return st;
+	dar_join(dar, tail, head, kept);
 
-			i--;
-		}
-	}
+	return DS_OK;
+}
+
+Status dar_remove_if(DynamicArray *dar, int_predicate_t predicate, void *data)
+{
+	if (dar == NULL || predicate == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (dar_is_empty(dar))
+		return DS_ERR_INVALID_OPERATION;
+
+	int *tail = dar_tail(dar);
+
+	size_t head = dar_filter(dar->buffer, dar->gap, predicate, data);
+	size_t kept = dar_filter(tail, dar->size - dar->gap, predicate, data);
+
+	dar_join(dar, tail, head, kept);
 
 	return DS_OK;
 }
@@ -372,10 +767,10 @@ Status dar_display(DynamicArray *dar)
 	for (i = 0; i < dar->size - 1; i++)
 	{
 
-		printf("%d, ", dar->buffer[i]);
+		printf("%d, ", dar->buffer[dar_slot(dar, i)]);
 	}
 
-	printf("%d", dar->buffer[dar->size - 1]);
+	printf("%d", dar->buffer[dar_slot(dar, dar->size - 1)]);
 
 	printf(" ]\n");
 
@@ -396,7 +791,7 @@ Status dar_display_raw(DynamicArray *dar)
 	for (i = 0; i < dar->size; i++)
 	{
 
-		printf("%d ", dar->buffer[i]);
+		printf("%d ", dar->buffer[dar_slot(dar, i)]);
 	}
 
 	printf("\n");
@@ -413,7 +808,11 @@ Status dar_delete(DynamicArray **dar)
 	if (*dar == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	free((*dar)->buffer);
+	if ((*dar)->reserved != 0)
+		VirtualFree((*dar)->buffer, 0, MEM_RELEASE);
+	else
+		free((*dar)->buffer);
+
 	free((*dar));
 
 	(*dar) = NULL;
@@ -423,19 +822,31 @@ Status dar_delete(DynamicArray **dar)
 
 Status dar_erase(DynamicArray **dar)
 {
-	if (dar == NULL)
+	if (dar == NULL || *dar == NULL)
 		return DS_ERR_NULL_POINTER;
 
+	// The new array keeps the growth policy, the reserved address space and
+	// the gap buffer mode
+	double growth_rate = (*dar)->growth_rate;
+	size_t reserved = (*dar)->reserved;
+	bool gap_buffer = (*dar)->gap_buffer;
+
 	Status st = dar_delete(dar);
 
 	if (st != DS_OK)
 		return st;
 
-	st = dar_init(dar);
+	if (reserved != 0)
+		st = dar_init_reserved(dar, reserved);
+	else
+		st = dar_init(dar);
 
 	if (st != DS_OK)
 		return st;
 
+	(*dar)->growth_rate = growth_rate;
+	(*dar)->gap_buffer = gap_buffer;
+
 	return DS_OK;
 }
 
@@ -456,7 +867,7 @@ Status dar_get(DynamicArray *dar, size_t index, int *result)
 	if (index >= dar->size)
 		return DS_ERR_INVALID_POSITION;
 
-	*result = dar->buffer[index];
+	*result = dar->buffer[dar_slot(dar, index)];
 
 	return DS_OK;
 }
@@ -496,357 +907,631 @@ Status dar_find_max(DynamicArray *dar, int *result)
 	if (dar_is_empty(dar))
 		return DS_ERR_INVALID_OPERATION;
 
-	*result = dar->buffer[0];
+	*result = dar_scan_max(dar);
 
-	size_t i;
-	for (i = 0; i < dar->size; i++)
+	return DS_OK;
+}
+
+Status dar_find_min(DynamicArray *dar, int *result)
+{
+	*result = 0;
+
+	if (dar == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (dar_is_empty(dar))
+		return DS_ERR_INVALID_OPERATION;
+
+	*result = dar_scan_min(dar);
+
+	return DS_OK;
+}
+
+Status dar_find_max_pos(DynamicArray *dar, size_t *result)
+{
+	*result = 0;
+
+	if (dar == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (dar_is_empty(dar))
+		return DS_ERR_INVALID_OPERATION;
+
+	*result = dar_scan_first(dar, dar_scan_max(dar));
+
+	return DS_OK;
+}
+
+Status dar_find_min_pos(DynamicArray *dar, size_t *result)
+{
+	*result = 0;
+
+	if (dar == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (dar_is_empty(dar))
+		return DS_ERR_INVALID_OPERATION;
+
+	*result = dar_scan_first(dar, dar_scan_min(dar));
+
+	return DS_OK;
+}
+
+Status dar_frequency(DynamicArray *dar, int value, size_t *frequency)
+{
+	*frequency = 0;
+
+	if (dar == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (dar_is_empty(dar))
+		return DS_ERR_INVALID_OPERATION;
+
+	*frequency = dar_scan_count(dar, value);
+
+	return DS_OK;
+}
+
+Status dar_contains(DynamicArray *dar, int value, bool *result)
+{
+	*result = false;
+
+	if (dar == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (dar_is_empty(dar))
+		return DS_ERR_INVALID_OPERATION;
+
+	*result = dar_scan_first(dar, value) < dar->size;
+
+	return DS_OK;
+}
+
+bool dar_exists(DynamicArray *dar, int value)
+{
+	if (dar == NULL)
+		return false;
+
+	if (dar_is_empty(dar))
+		return false;
+
+	return dar_scan_first(dar, value) < dar->size;
+}
+
+Status dar_find_occurrance_first(DynamicArray *dar, int value, size_t *position)
+{
+	*position = 0;
+
+	if (dar == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (dar_is_empty(dar))
+		return DS_ERR_INVALID_OPERATION;
+
+	size_t i = dar_scan_first(dar, value);
+
+	if (i == dar->size)
+		return DS_ERR_NOT_FOUND;
+
+	*position = i;
+
+	return DS_OK;
+}
+
+Status dar_find_occurrance_last(DynamicArray *dar, int value, size_t *position)
+{
+	*position = 0;
+
+	if (dar == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (dar_is_empty(dar))
+		return DS_ERR_INVALID_OPERATION;
+
+	size_t i = dar_scan_last(dar, value);
+
+	if (i == dar->size)
+		return DS_ERR_NOT_FOUND;
+
+	*position = i;
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Copy                                                |
+// +-------------------------------------------------------------------------------------------------+
+
+Status dar_copy(DynamicArray *dar, DynamicArray **result)
+{
+	if (dar == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	Status st = dar_init(result);
+
+	if (st != DS_OK)
+		return st;
+
+	if (dar_is_empty(dar))
+		return DS_OK;
+
+	st = dar_reserve(*result, dar->size);
+
+	if (st != DS_OK)
+		return st;
+
+	memcpy((*result)->buffer, dar->buffer, sizeof(int) * dar->gap);
+	memcpy((*result)->buffer + dar->gap, dar_tail(dar), sizeof(int) * (dar->size - dar->gap));
+
+	(*result)->size = dar->size;
+	(*result)->gap = dar->size;
+
+	return DS_OK;
+}
+
+// Merges two sorted arrays into a new sorted array
+Status dar_merge_sorted(DynamicArray *dar1, DynamicArray *dar2, DynamicArray **result)
+{
+	if (dar1 == NULL || dar2 == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	dar_move_gap(dar1, dar1->size);
+	dar_move_gap(dar2, dar2->size);
+
+	Status st = dar_init_result(result, dar1->size + dar2->size);
+
+	if (st != DS_OK)
+		return st;
+
+	const int *a = dar1->buffer, *b = dar2->buffer;
+	int *out = (*result)->buffer;
+
+	size_t i = 0, j = 0, k = 0;
+
+	while (i < dar1->size && j < dar2->size)
 	{
-		if (dar->buffer[i] > *result)
-			*result = dar->buffer[i];
+		if (b[j] < a[i])
+			out[k++] = b[j++];
+		else
+			out[k++] = a[i++];
 	}
 
+	memcpy(out + k, a + i, sizeof(int) * (dar1->size - i));
+	k += dar1->size - i;
+	memcpy(out + k, b + j, sizeof(int) * (dar2->size - j));
+	k += dar2->size - j;
+
+	(*result)->size = k;
+	(*result)->gap = k;
+
 	return DS_OK;
 }
 
-Status dar_find_min(DynamicArray *dar, int *result)
+// Merges count sorted arrays into a new sorted array. A heap holds the
+// arrays ordered by their next element and the array at its top copies
+// every element up to the next element of the runner-up in one go, so
+// inputs made of long runs cost little more than a copy.
+Status dar_merge_sorted_many(DynamicArray **dars, size_t count, DynamicArray **result)
 {
-	*result = 0;
+	if (dars == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	size_t total = 0, i;
+
+	for (i = 0; i < count; i++)
+	{
+		if (dars[i] == NULL)
+			return DS_ERR_NULL_POINTER;
+
+		dar_move_gap(dars[i], dars[i]->size);
+
+		total += dars[i]->size;
+	}
+
+	size_t *positions = calloc(count + 1, sizeof(size_t));
+	size_t *heap = malloc(sizeof(size_t) * (count + 1));
+
+	if (!positions || !heap)
+	{
+		free(positions);
+		free(heap);
+
+		return DS_ERR_ALLOC;
+	}
+
+	Status st = dar_init_result(result, total);
+
+	if (st != DS_OK)
+	{
+		free(positions);
+		free(heap);
+
+		return st;
+	}
+
+	size_t size = 0, source, next, run, k = 0;
+	int *out = (*result)->buffer;
+
+	for (i = 0; i < count; i++)
+	{
+		if (dars[i]->size > 0)
+			heap[size++] = i;
+	}
+
+	for (i = size / 2; i > 0; i--)
+		dar_merge_sift(dars, positions, heap, size, i - 1);
+
+	while (size > 0)
+	{
+		source = heap[0];
+
+		run = dars[source]->size - positions[source];
+
+		if (size > 1)
+		{
+			next = heap[1];
+
+			if (size > 2 && dars[heap[2]]->buffer[positions[heap[2]]] < dars[next]->buffer[positions[next]])
+				next = heap[2];
+
+			// At least one element since the top is never greater than next
+			run = dar_search_upper(dars[source]->buffer + positions[source], run, dars[next]->buffer[positions[next]]);
+		}
 
-	if (dar == NULL)
-		return DS_ERR_NULL_POINTER;
+		memcpy(out + k, dars[source]->buffer + positions[source], sizeof(int) * run);
 
-	if (dar_is_empty(dar))
-		return DS_ERR_INVALID_OPERATION;
+		k += run;
+		positions[source] += run;
 
-	*result = dar->buffer[0];
+		if (positions[source] == dars[source]->size)
+			heap[0] = heap[--size];
 
-	size_t i;
-	for (i = 0; i < dar->size; i++)
-	{
-		if (dar->buffer[i] < *result)
-			*result = dar->buffer[i];
+		if (size > 0)
+			dar_merge_sift(dars, positions, heap, size, 0);
 	}
 
+	(*result)->size = k;
+	(*result)->gap = k;
+
+	free(positions);
+	free(heap);
+
 	return DS_OK;
 }
 
-Status dar_find_max_pos(DynamicArray *dar, size_t *result)
+Status dar_prepend(DynamicArray *dar1, DynamicArray *dar2)
 {
-	*result = 0;
+	return dar_add(dar1, dar2, 0);
+}
 
-	if (dar == NULL)
+// Inserts the elements of dar2 at index of dar1. Both parts of dar2 are
+// copied straight into the room opened in dar1.
+Status dar_add(DynamicArray *dar1, DynamicArray *dar2, size_t index)
+{
+	if (dar1 == NULL || dar2 == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	if (dar_is_empty(dar))
-		return DS_ERR_INVALID_OPERATION;
+	if (index > dar1->size)
+		return DS_ERR_INVALID_POSITION;
 
-	size_t i;
-	for (i = 0; i < dar->size; i++)
+	if (dar_is_empty(dar2))
+		return DS_OK;
+
+	size_t size = dar2->size;
+	int *copy = NULL;
+
+	// Adding an array to itself would read from the buffer dar_open moves
+	if (dar1 == dar2)
 	{
-		if (dar->buffer[i] > dar->buffer[(*result)])
-			*result = i;
-	}
+		copy = malloc(sizeof(int) * size);
 
-	return DS_OK;
-}
+		if (!copy)
+			return DS_ERR_ALLOC;
 
-Status dar_find_min_pos(DynamicArray *dar, size_t *result)
-{
-	*result = 0;
+		memcpy(copy, dar2->buffer, sizeof(int) * dar2->gap);
+		memcpy(copy + dar2->gap, dar_tail(dar2), sizeof(int) * (size - dar2->gap));
+	}
 
-	if (dar == NULL)
-		return DS_ERR_NULL_POINTER;
+	int *slot;
 
-	if (dar_is_empty(dar))
-		return DS_ERR_INVALID_OPERATION;
+	Status st = dar_open(dar1, index, size, &slot);
 
-	size_t i;
-	for (i = 0; i < dar->size; i++)
+	if (st == DS_OK)
 	{
-		if (dar->buffer[i] < dar->buffer[(*result)])
-			*result = i;
+		if (copy != NULL)
+		{
+			memcpy(slot, copy, sizeof(int) * size);
+		}
+		else
+		{
+			memcpy(slot, dar2->buffer, sizeof(int) * dar2->gap);
+			memcpy(slot + dar2->gap, dar_tail(dar2), sizeof(int) * (dar2->size - dar2->gap));
+		}
 	}
 
-	return DS_OK;
+	free(copy);
+
+	return st;
 }
 
-Status dar_frequency(DynamicArray *dar, int value, size_t *frequency)
+Status dar_append(DynamicArray *dar1, DynamicArray *dar2)
 {
-	*frequency = 0;
+	if (dar1 == NULL || dar2 == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return dar_add(dar1, dar2, dar1->size);
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                           Sorting                                               |
+// +-------------------------------------------------------------------------------------------------+
 
+Status dar_is_sorted(DynamicArray *dar, bool *result)
+{
 	if (dar == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	if (dar_is_empty(dar))
-		return DS_ERR_INVALID_OPERATION;
+	size_t tail = dar->size - dar->gap;
 
-	size_t i;
-	for (i = 0; i < dar->size; i++)
-	{
-		if (dar->buffer[i] == value)
-			(*frequency)++;
-	}
+	*result = dar_sorted_run(dar->buffer, dar->gap) && dar_sorted_run(dar_tail(dar), tail);
+
+	if (*result && dar->gap > 0 && tail > 0)
+		*result = dar->buffer[dar->gap - 1] <= dar_tail(dar)[0];
 
 	return DS_OK;
 }
 
-Status dar_contains(DynamicArray *dar, int value, bool *result)
-{
-	*result = false;
+//Status dar_reverse(DynamicArray *dar)
+//Status dar_sort_bubble(DynamicArray *dar)
+//Status dar_sort_selection(DynamicArray *dar)
+//Status dar_sort_insertion(DynamicArray *dar)
 
+// Introsort, in place and not stable
+Status dar_sort(DynamicArray *dar)
+{
 	if (dar == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	if (dar_is_empty(dar))
-		return DS_ERR_INVALID_OPERATION;
+	dar_move_gap(dar, dar->size);
 
-	size_t i;
-	for (i = 0; i < dar->size; i++)
-	{
-		if (dar->buffer[i] == value)
-		{
-			*result = true;
+	size_t depth = 0, size;
 
-			return DS_OK;
-		}
-	}
+	for (size = dar->size; size > 1; size >>= 1)
+		depth += 2;
+
+	dar_sort_intro(dar->buffer, dar->size, depth);
 
 	return DS_OK;
 }
 
-bool dar_exists(DynamicArray *dar, int value)
+// Removes repeated elements of a sorted array, which turns it into a set
+Status dar_unique(DynamicArray *dar)
 {
 	if (dar == NULL)
-		return false;
+		return DS_ERR_NULL_POINTER;
 
 	if (dar_is_empty(dar))
-		return false;
+		return DS_OK;
 
-	size_t i;
-	for (i = 0; i < dar->size; i++)
+	dar_move_gap(dar, dar->size);
+
+	size_t kept = 1, i;
+
+	for (i = 1; i < dar->size; i++)
 	{
-		if (dar->buffer[i] == value)
-			return true;
+		if (dar->buffer[i] != dar->buffer[kept - 1])
+			dar->buffer[kept++] = dar->buffer[i];
 	}
 
-	return false;
+	dar->size = kept;
+	dar->gap = kept;
+
+	return DS_OK;
 }
 
-Status dar_find_occurrance_first(DynamicArray *dar, int value, size_t *position)
-{
-	*position = 0;
+// +-------------------------------------------------------------------------------------------------+
+// |                                            Sorted                                               |
+// +-------------------------------------------------------------------------------------------------+
+
+// Binary searches look at the side of the gap that holds the answer, so
+// they never move the gap
 
+Status dar_lower_bound(DynamicArray *dar, int value, size_t *position)
+{
 	if (dar == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	if (dar_is_empty(dar))
-		return DS_ERR_INVALID_OPERATION;
-
-	size_t i;
-	for (i = 0; i < dar->size; i++)
-	{
-		if (dar->buffer[i] == value)
-		{
-			*position = i;
-
-			return DS_OK;
-		}
-	}
+	if (dar->gap > 0 && dar->buffer[dar->gap - 1] >= value)
+		*position = dar_search_lower(dar->buffer, dar->gap, value);
+	else
+		*position = dar->gap + dar_search_lower(dar_tail(dar), dar->size - dar->gap, value);
 
-	return DS_ERR_NOT_FOUND;
+	return DS_OK;
 }
 
-Status dar_find_occurrance_last(DynamicArray *dar, int value, size_t *position)
+Status dar_upper_bound(DynamicArray *dar, int value, size_t *position)
 {
-	*position = 0;
-
 	if (dar == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	if (dar_is_empty(dar))
-		return DS_ERR_INVALID_OPERATION;
-
-	size_t i;
-	for (i = dar->size; i > 0; i--)
-	{
-		if (dar->buffer[i] == value)
-		{
-			*position = i;
-
-			return DS_OK;
-		}
-	}
+	if (dar->gap > 0 && dar->buffer[dar->gap - 1] > value)
+		*position = dar_search_upper(dar->buffer, dar->gap, value);
+	else
+		*position = dar->gap + dar_search_upper(dar_tail(dar), dar->size - dar->gap, value);
 
-	return DS_ERR_NOT_FOUND;
+	return DS_OK;
 }
 
-// +-------------------------------------------------------------------------------------------------+
-// |                                             Copy                                                |
-// +-------------------------------------------------------------------------------------------------+
-
-Status dar_copy(DynamicArray *dar, DynamicArray **result)
+// Position of the first occurrence of value in a sorted array
+Status dar_find_sorted(DynamicArray *dar, int value, size_t *position)
 {
-	if (dar == NULL)
-		return DS_ERR_NULL_POINTER;
-
-	Status st = dar_init(result);
+	Status st = dar_lower_bound(dar, value, position);
 
 	if (st != DS_OK)
 		return st;
 
-	if (dar_is_empty(dar))
-		return DS_OK;
-
-	while (!dar_fits(*result, dar->size))
-	{
-		st = dar_realloc(*result);
-
-		if (st != DS_OK)
-			return st;
-	}
+	if (*position == dar->size || dar->buffer[dar_slot(dar, *position)] != value)
+		return DS_ERR_NOT_FOUND;
 
-	size_t i;
-	for (i = 0; i < dar->size; i++)
-	{
-		(*result)->buffer[i] = dar->buffer[i];
-	}
+	return DS_OK;
+}
 
-	(*result)->size = dar->size;
+bool dar_contains_sorted(DynamicArray *dar, int value)
+{
+	size_t position;
 
-	return DS_OK;
+	return dar_find_sorted(dar, value, &position) == DS_OK;
 }
 
-//Status dar_merge_sorted(DynamicArray *dar1, DynamicArray *dar2, DynamicArray **result);
+// Set operations take two sorted arrays without repeated elements, as left
+// by dar_sort and dar_unique, and create a new one. A run of one array that
+// has no match in the other is skipped or copied whole after a galloping
+// search, so an operation between a small and a large set costs about
+// O(m log(n / m)) instead of O(m + n).
 
-Status dar_prepend(DynamicArray *dar1, DynamicArray *dar2)
+Status dar_sorted_union(DynamicArray *dar1, DynamicArray *dar2, DynamicArray **result)
 {
 	if (dar1 == NULL || dar2 == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	if (dar_is_empty(dar2))
-		return DS_OK;
+	dar_move_gap(dar1, dar1->size);
+	dar_move_gap(dar2, dar2->size);
 
-	Status st;
+	Status st = dar_init_result(result, dar1->size + dar2->size);
 
-	while (!dar_fits(dar1, dar2->size))
-	{
-		st = dar_realloc(dar1);
+	if (st != DS_OK)
+		return st;
 
-		if (st != DS_OK)
-			return st;
-	}
+	const int *a = dar1->buffer, *b = dar2->buffer;
+	size_t n1 = dar1->size, n2 = dar2->size;
+	int *out = (*result)->buffer;
 
-	size_t i;
-	for (i = dar1->size; i > 0; i--)
-	{
-		dar1->buffer[i + dar2->size - 1] = dar1->buffer[i - 1];
-	}
+	size_t i = 0, j = 0, k = 0, run;
 
-	for (i = 0; i < dar2->size; i++)
+	while (i < n1 && j < n2)
 	{
-		dar1->buffer[i] = dar2->buffer[i];
+		if (a[i] < b[j])
+		{
+			run = dar_gallop(a + i, n1 - i, b[j]);
+			memcpy(out + k, a + i, sizeof(int) * run);
+			i += run;
+			k += run;
+		}
+		else if (b[j] < a[i])
+		{
+			run = dar_gallop(b + j, n2 - j, a[i]);
+			memcpy(out + k, b + j, sizeof(int) * run);
+			j += run;
+			k += run;
+		}
+		else
+		{
+			out[k++] = a[i++];
+			j++;
+		}
 	}
 
-	dar1->size += dar2->size;
+	memcpy(out + k, a + i, sizeof(int) * (n1 - i));
+	k += n1 - i;
+	memcpy(out + k, b + j, sizeof(int) * (n2 - j));
+	k += n2 - j;
+
+	(*result)->size = k;
+	(*result)->gap = k;
 
 	return DS_OK;
 }
 
-Status dar_add(DynamicArray *dar1, DynamicArray *dar2, size_t index)
+Status dar_sorted_intersection(DynamicArray *dar1, DynamicArray *dar2, DynamicArray **result)
 {
 	if (dar1 == NULL || dar2 == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	if (dar_is_empty(dar2))
-		return DS_OK;
-
-	Status st;
-
-	if (index == dar1->size)
-	{
-		st = dar_append(dar1, dar2);
+	dar_move_gap(dar1, dar1->size);
+	dar_move_gap(dar2, dar2->size);
 
-		if (st != DS_OK)
-			return st;
-	}
-	else if (index == 0)
-	{
-		st = dar_prepend(dar1, dar2);
+	Status st = dar_init_result(result, dar1->size < dar2->size ? dar1->size : dar2->size);
 
-		if (st != DS_OK)
-			return st;
-	}
-	else
-	{
-		while (!dar_fits(dar1, dar2->size))
-		{
-			st = dar_realloc(dar1);
+	if (st != DS_OK)
+		return st;
 
-			if (st != DS_OK)
-				return st;
-		}
+	const int *a = dar1->buffer, *b = dar2->buffer;
+	size_t n1 = dar1->size, n2 = dar2->size;
+	int *out = (*result)->buffer;
 
-		size_t i, j;
-		for (i = dar1->size; i >= index; i--)
-		{
-			dar1->buffer[i + dar2->size] = dar1->buffer[i];
-		}
+	size_t i = 0, j = 0, k = 0;
 
-		for (i = index, j = 0; i < index + dar2->size; i++, j++)
+	while (i < n1 && j < n2)
+	{
+		if (a[i] < b[j])
+			i += dar_gallop(a + i, n1 - i, b[j]);
+		else if (b[j] < a[i])
+			j += dar_gallop(b + j, n2 - j, a[i]);
+		else
 		{
-			dar1->buffer[i] = dar2->buffer[j];
+			out[k++] = a[i++];
+			j++;
 		}
-
-		dar1->size += dar2->size;
-
 	}
 
+	(*result)->size = k;
+	(*result)->gap = k;
+
 	return DS_OK;
 }
 
-Status dar_append(DynamicArray *dar1, DynamicArray *dar2)
+// Elements of dar1 that are not in dar2
+Status dar_sorted_difference(DynamicArray *dar1, DynamicArray *dar2, DynamicArray **result)
 {
 	if (dar1 == NULL || dar2 == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	if (dar_is_empty(dar2))
-		return DS_OK;
+	dar_move_gap(dar1, dar1->size);
+	dar_move_gap(dar2, dar2->size);
 
-	Status st;
+	Status st = dar_init_result(result, dar1->size);
 
-	while (!dar_fits(dar1, dar2->size))
-	{
-		st = dar_realloc(dar1);
+	if (st != DS_OK)
+		return st;
 
-		if (st != DS_OK)
-			return st;
-	}
+	const int *a = dar1->buffer, *b = dar2->buffer;
+	size_t n1 = dar1->size, n2 = dar2->size;
+	int *out = (*result)->buffer;
 
-	size_t i, j;
-	for (i = dar1->size, j = 0; i < dar1->size + dar2->size - 1; i++, j++)
+	size_t i = 0, j = 0, k = 0, run;
+
+	while (i < n1 && j < n2)
 	{
-		dar1->buffer[i] = dar2->buffer[j];
+		if (a[i] < b[j])
+		{
+			run = dar_gallop(a + i, n1 - i, b[j]);
+			memcpy(out + k, a + i, sizeof(int) * run);
+			i += run;
+			k += run;
+		}
+		else if (b[j] < a[i])
+			j += dar_gallop(b + j, n2 - j, a[i]);
+		else
+		{
+			i++;
+			j++;
+		}
 	}
 
-	dar1->size += dar2->size;
+	memcpy(out + k, a + i, sizeof(int) * (n1 - i));
+	k += n1 - i;
+
+	(*result)->size = k;
+	(*result)->gap = k;
 
 	return DS_OK;
 }
 
-// +-------------------------------------------------------------------------------------------------+
-// |                                           Sorting                                               |
-// +-------------------------------------------------------------------------------------------------+
-
-//Status dar_is_sorted(DynamicArray *dar, bool *result)
-//Status dar_reverse(DynamicArray *dar)
-//Status dar_sort_bubble(DynamicArray *dar)
-//Status dar_sort_selection(DynamicArray *dar)
-//Status dar_sort_insertion(DynamicArray *dar)
-
 // +-------------------------------------------------------------------------------------------------+
 // |                                            Buffer                                               |
 // +-------------------------------------------------------------------------------------------------+
 
+// Grows the buffer geometrically until it holds at least size elements
 Status dar_grow(DynamicArray *dar, size_t size)
 {
 	if (dar == NULL)
@@ -855,44 +1540,75 @@ Status dar_grow(DynamicArray *dar, size_t size)
 	if (dar->capacity >= size)
 		return DS_OK;
 
-	size_t temp_cap = dar->capacity;
+	return dar_resize(dar, dar_next_capacity(dar, size));
+}
 
-	while (dar->capacity < size)
-	{
-		dar->capacity *= dar->growth_rate;
-	}
+Status dar_realloc(DynamicArray *dar)
+{
+	if (dar == NULL)
+		return DS_ERR_NULL_POINTER;
 
-	int *new_buffer = realloc(dar->buffer, sizeof(int) * dar->capacity);
+	return dar_resize(dar, dar_next_capacity(dar, dar->capacity + 1));
+}
 
-	if (!new_buffer)
-	{
-		dar->capacity = temp_cap;
+// Makes room for exactly capacity elements so that filling the array up to
+// it never reallocates
+Status dar_reserve(DynamicArray *dar, size_t capacity)
+{
+	if (dar == NULL)
+		return DS_ERR_NULL_POINTER;
 
+	if (dar->capacity >= capacity)
 		return DS_OK;
-	}
 
-	dar->buffer = new_buffer;
+	return dar_resize(dar, capacity);
+}
+
+Status dar_shrink_to_fit(DynamicArray *dar)
+{
+	if (dar == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return dar_resize(dar, dar->size);
+}
+
+Status dar_set_growth_rate(DynamicArray *dar, double growth_rate)
+{
+	if (dar == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	// Also rejects NaN
+	if (!(growth_rate > 1.0))
+		return DS_ERR_INVALID_ARGUMENT;
+
+	dar->growth_rate = growth_rate;
 
 	return DS_OK;
 }
 
-Status dar_realloc(DynamicArray *dar)
+// With a gap buffer insertions and removals move a gap to where they
+// happen instead of shifting every element after it, so edits close to
+// each other only move the elements between them
+Status dar_set_gap_buffer(DynamicArray *dar, bool enabled)
 {
 	if (dar == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	dar->capacity *= dar->growth_rate;
+	if (!enabled)
+		dar_move_gap(dar, dar->size);
 
-	int *new_buffer = realloc(dar->buffer, sizeof(int) * dar->capacity);
+	dar->gap_buffer = enabled;
 
-	if (!new_buffer)
-	{
-		dar->capacity /= dar->growth_rate;
+	return DS_OK;
+}
 
-		return DS_ERR_ALLOC;
-	}
+// Moves the gap to the end so that buffer holds every element in order
+Status dar_close_gap(DynamicArray *dar)
+{
+	if (dar == NULL)
+		return DS_ERR_NULL_POINTER;
 
-	dar->buffer = new_buffer;
+	dar_move_gap(dar, dar->size);
 
 	return DS_OK;
 }
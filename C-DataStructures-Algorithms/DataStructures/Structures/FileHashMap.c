@@ -0,0 +1,440 @@
+/**
+ * @file FileHashMap.c
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Source file for @c FileHashMap implementations in C
+ *
+ */
+
+#include "FileHashMap.h"
+#include "HashFunctions.h"
+
+#define FILE_HASH_MAP_KEY_BUFFER 256
+
+// Index + 1 is the id recorded in the file header
+static const hash_function_t fmap_hash_functions[] = {
+	map_hash_java, map_hash_djb2, map_hash_sdbm, hash_wyhash, hash_xxh3};
+
+static const size_t fmap_hash_total = sizeof(fmap_hash_functions) / sizeof(fmap_hash_functions[0]);
+
+static uint32_t fmap_hash_id(hash_function_t hash_function)
+{
+	size_t i;
+	for (i = 0; i < fmap_hash_total; i++)
+	{
+		if (fmap_hash_functions[i] == hash_function)
+			return (uint32_t)(i + 1);
+	}
+
+	return 0;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Writer                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+// Robin Hood placement of a slot known not to be in slots yet, the same
+// order fmap_search expects
+static void fmap_place(FileHashMapSlot *slots, uint64_t capacity, FileHashMapSlot slot)
+{
+	uint64_t mask = capacity - 1;
+	uint64_t pos = slot.hash & mask;
+	uint64_t dist = 0, slot_dist;
+
+	FileHashMapSlot temp;
+
+	while (slots[pos].key_offset != 0)
+	{
+		slot_dist = (pos - (slots[pos].hash & mask)) & mask;
+
+		if (slot_dist < dist)
+		{
+			temp = slots[pos];
+			slots[pos] = slot;
+			slot = temp;
+
+			dist = slot_dist;
+		}
+
+		pos = (pos + 1) & mask;
+
+		dist++;
+	}
+
+	slots[pos] = slot;
+}
+
+// Writes the key of every entry of both tables of map, in the same order
+// fmap_write assigned their offsets
+static Status fmap_write_keys(HashMap *map, FILE *file)
+{
+	HashMapEntry *tables[2] = {map->hash_table, map->old_table};
+	size_t capacities[2] = {map->capacity, map->old_capacity};
+
+	size_t t, i;
+	for (t = 0; t < 2; t++)
+	{
+		for (i = 0; i < capacities[t]; i++)
+		{
+			HashMapEntry *entry = &(tables[t][i]);
+
+			if (entry->key == NULL)
+				continue;
+
+			if (fwrite(entry->key, 1, entry->length + 1, file) != entry->length + 1)
+				return DS_ERR_UNEXPECTED_RESULT;
+		}
+	}
+
+	return DS_OK;
+}
+
+// Writes every entry of map to the file at path, replacing it
+Status fmap_write(HashMap *map, const char *path)
+{
+	if (map == NULL || path == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	uint64_t capacity = 16;
+
+	while ((double)map->size > (double)capacity * FILE_HASH_MAP_LOAD_FACTOR)
+		capacity *= 2;
+
+	FileHashMapSlot *slots = calloc((size_t)capacity, sizeof(FileHashMapSlot));
+
+	if (!slots)
+		return DS_ERR_ALLOC;
+
+	FileHashMapHeader header;
+
+	memset(&header, 0, sizeof(FileHashMapHeader));
+	memcpy(header.magic, FILE_HASH_MAP_MAGIC, sizeof(header.magic));
+
+	header.version = FILE_HASH_MAP_VERSION;
+	// Slots hold hashes of hash_function_n, which only matches the built-in
+	// function when it is that function's own length aware variant
+	if (map->hash_function_n == map_hash_length_variant(map->hash_function))
+		header.hash_id = fmap_hash_id(map->hash_function);
+	else
+		header.hash_id = 0;
+	header.size = map->size;
+	header.capacity = capacity;
+	header.slots_offset = sizeof(FileHashMapHeader);
+	header.keys_offset = header.slots_offset + capacity * sizeof(FileHashMapSlot);
+
+	// Keys are laid out in the order fmap_write_keys visits them
+	uint64_t offset = header.keys_offset;
+
+	HashMapEntry *tables[2] = {map->hash_table, map->old_table};
+	size_t capacities[2] = {map->capacity, map->old_capacity};
+
+	size_t t, i;
+	for (t = 0; t < 2; t++)
+	{
+		for (i = 0; i < capacities[t]; i++)
+		{
+			HashMapEntry *entry = &(tables[t][i]);
+
+			if (entry->key == NULL)
+				continue;
+
+			FileHashMapSlot slot;
+
+			slot.hash = (uint64_t)entry->hash;
+			slot.key_offset = offset;
+			slot.length = (uint32_t)entry->length;
+			slot.value = entry->value;
+
+			fmap_place(slots, capacity, slot);
+
+			offset += entry->length + 1;
+		}
+	}
+
+	header.file_size = offset;
+
+	FILE *file;
+
+	if (fopen_s(&file, path, "wb") != 0)
+	{
+		free(slots);
+
+		return DS_ERR_INVALID_ARGUMENT;
+	}
+
+	Status st = DS_OK;
+
+	if (fwrite(&header, sizeof(FileHashMapHeader), 1, file) != 1 ||
+		fwrite(slots, sizeof(FileHashMapSlot), (size_t)capacity, file) != (size_t)capacity)
+		st = DS_ERR_UNEXPECTED_RESULT;
+
+	if (st == DS_OK)
+		st = fmap_write_keys(map, file);
+
+	if (fclose(file) != 0 && st == DS_OK)
+		st = DS_ERR_UNEXPECTED_RESULT;
+
+	free(slots);
+
+	return st;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                          Initializers                                           |
+// +-------------------------------------------------------------------------------------------------+
+
+// Checks the header only, slots are validated as searches reach them
+static Status fmap_validate(const unsigned char *base, uint64_t file_size)
+{
+	if (file_size < sizeof(FileHashMapHeader))
+		return DS_ERR_INVALID_ARGUMENT;
+
+	const FileHashMapHeader *header = (const FileHashMapHeader *)base;
+
+	if (memcmp(header->magic, FILE_HASH_MAP_MAGIC, sizeof(header->magic)) != 0)
+		return DS_ERR_INVALID_ARGUMENT;
+
+	if (header->version != FILE_HASH_MAP_VERSION || header->file_size != file_size)
+		return DS_ERR_INVALID_ARGUMENT;
+
+	if (header->capacity == 0 || (header->capacity & (header->capacity - 1)) != 0 || header->size >= header->capacity)
+		return DS_ERR_INVALID_ARGUMENT;
+
+	if (header->slots_offset != sizeof(FileHashMapHeader) ||
+		header->capacity > (file_size - header->slots_offset) / sizeof(FileHashMapSlot) ||
+		header->keys_offset != header->slots_offset + header->capacity * sizeof(FileHashMapSlot))
+		return DS_ERR_INVALID_ARGUMENT;
+
+	return DS_OK;
+}
+
+// Maps the file at path. hash_function can be NULL when the file was written
+// from a map using one of the built-in hash functions.
+Status fmap_open(FileHashMap **fmap, const char *path, hash_function_t hash_function)
+{
+	if (path == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+	if (file == INVALID_HANDLE_VALUE)
+		return DS_ERR_INVALID_ARGUMENT;
+
+	LARGE_INTEGER file_size;
+
+	if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart < (long long)sizeof(FileHashMapHeader))
+	{
+		CloseHandle(file);
+
+		return DS_ERR_INVALID_ARGUMENT;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+	if (mapping == NULL)
+	{
+		CloseHandle(file);
+
+		return DS_ERR_ALLOC;
+	}
+
+	const unsigned char *base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+	Status st = base == NULL ? DS_ERR_ALLOC : fmap_validate(base, (uint64_t)file_size.QuadPart);
+
+	const FileHashMapHeader *header = (const FileHashMapHeader *)base;
+
+	if (st == DS_OK)
+	{
+		if (header->hash_id > fmap_hash_total)
+			st = DS_ERR_INVALID_ARGUMENT;
+		else if (hash_function == NULL && header->hash_id == 0)
+			st = DS_ERR_INVALID_ARGUMENT;
+		else if (hash_function != NULL && header->hash_id != 0 && fmap_hash_id(hash_function) != header->hash_id)
+			st = DS_ERR_INVALID_ARGUMENT;
+	}
+
+	if (st == DS_OK)
+	{
+		*fmap = malloc(sizeof(FileHashMap));
+
+		if (!(*fmap))
+			st = DS_ERR_ALLOC;
+	}
+
+	if (st != DS_OK)
+	{
+		if (base != NULL)
+			UnmapViewOfFile(base);
+
+		CloseHandle(mapping);
+		CloseHandle(file);
+
+		return st;
+	}
+
+	if (hash_function == NULL)
+		hash_function = fmap_hash_functions[header->hash_id - 1];
+
+	(*fmap)->base = base;
+	(*fmap)->header = header;
+	(*fmap)->slots = (const FileHashMapSlot *)(base + header->slots_offset);
+	(*fmap)->file = file;
+	(*fmap)->mapping = mapping;
+	(*fmap)->hash_function = hash_function;
+	(*fmap)->hash_function_n = map_hash_length_variant(hash_function);
+
+	return DS_OK;
+}
+
+Status fmap_close(FileHashMap **fmap)
+{
+	if ((*fmap) == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	UnmapViewOfFile((*fmap)->base);
+
+	CloseHandle((*fmap)->mapping);
+	CloseHandle((*fmap)->file);
+
+	free(*fmap);
+
+	*fmap = NULL;
+
+	return DS_OK;
+}
+
+// Replaces the length aware function used to hash keys, for files written
+// by a map with a custom one set by map_set_hash_function_n
+Status fmap_set_hash_function_n(FileHashMap *fmap, hash_function_n_t hash_function_n)
+{
+	if (fmap == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	fmap->hash_function_n = hash_function_n;
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Search                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+static Status fmap_hash_key(FileHashMap *fmap, char *key, size_t length, bool terminated, size_t *hash)
+{
+	if (fmap->hash_function_n != NULL)
+		return fmap->hash_function_n(key, length, hash);
+
+	if (terminated)
+		return fmap->hash_function(key, hash);
+
+	char small[FILE_HASH_MAP_KEY_BUFFER];
+	char *buffer = small;
+
+	if (length >= FILE_HASH_MAP_KEY_BUFFER)
+	{
+		buffer = malloc(length + 1);
+
+		if (!buffer)
+			return DS_ERR_ALLOC;
+	}
+
+	memcpy(buffer, key, length);
+	buffer[length] = '\0';
+
+	Status st = fmap->hash_function(buffer, hash);
+
+	if (buffer != small)
+		free(buffer);
+
+	return st;
+}
+
+static Status fmap_search_key(FileHashMap *fmap, char *key, size_t length, bool terminated, int *value)
+{
+	size_t hash;
+
+	Status st = fmap_hash_key(fmap, key, length, terminated, &hash);
+
+	if (st != DS_OK)
+		return st;
+
+	const FileHashMapHeader *header = fmap->header;
+
+	uint64_t mask = header->capacity - 1;
+	uint64_t pos = (uint64_t)hash & mask;
+	uint64_t dist = 0;
+
+	while (dist < header->capacity)
+	{
+		const FileHashMapSlot *slot = &(fmap->slots[pos]);
+
+		if (slot->key_offset == 0 || ((pos - (slot->hash & mask)) & mask) < dist)
+			return DS_ERR_NOT_FOUND;
+
+		if (slot->hash == (uint64_t)hash && slot->length == length)
+		{
+			// A damaged file must not make searches read past the mapping
+			if (length > header->file_size || slot->key_offset < header->keys_offset || slot->key_offset > header->file_size - length)
+				return DS_ERR_UNEXPECTED_RESULT;
+
+			if (memcmp(fmap->base + slot->key_offset, key, length) == 0)
+			{
+				*value = slot->value;
+
+				return DS_OK;
+			}
+		}
+
+		pos = (pos + 1) & mask;
+
+		dist++;
+	}
+
+	return DS_ERR_NOT_FOUND;
+}
+
+Status fmap_search(FileHashMap *fmap, char *key, int *value)
+{
+	*value = 0;
+
+	if (fmap == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return fmap_search_key(fmap, key, strlen(key), true, value);
+}
+
+Status fmap_search_n(FileHashMap *fmap, char *key, size_t length, int *value)
+{
+	*value = 0;
+
+	if (fmap == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return fmap_search_key(fmap, key, length, false, value);
+}
+
+bool fmap_contains(FileHashMap *fmap, char *key)
+{
+	int value;
+
+	return fmap_search(fmap, key, &value) == DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Counts                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+Status fmap_count_entries(FileHashMap *fmap, size_t *result)
+{
+	*result = 0;
+
+	if (fmap == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	*result = (size_t)fmap->header->size;
+
+	return DS_OK;
+}
@@ -0,0 +1,549 @@
+/**
+ * @file GenericHashMap.c
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Source file for @c GenericHashMap implementations in C
+ *
+ */
+
+#include "GenericHashMap.h"
+#include "HashFunctions.h"
+
+// Slots start with a tag, 0 when empty or the hash with its top bit set
+#define GMAP_OCCUPIED ((size_t)1 << (sizeof(size_t) * 8 - 1))
+
+#define GMAP_ALIGN(x) (((x) + GENERIC_HASH_MAP_ALIGNMENT - 1) & ~(size_t)(GENERIC_HASH_MAP_ALIGNMENT - 1))
+
+#define GMAP_SLOT(table, stride, pos) ((table) + (pos) * (stride))
+#define GMAP_TAG(slot) (*(size_t *)(slot))
+#define GMAP_KEY(slot) ((slot) + sizeof(size_t))
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                          Initializers                                           |
+// +-------------------------------------------------------------------------------------------------+
+
+Status gmap_init_map(GenericHashMap **map, size_t key_size, size_t value_size, size_t size, generic_hash_function_t hash_function, compare_function_t compare_function)
+{
+	if (key_size == 0 || size == 0)
+		return DS_ERR_INVALID_SIZE;
+
+	size_t capacity = GENERIC_HASH_MAP_INIT_SIZE;
+
+	while ((double)size > (double)capacity * GENERIC_HASH_MAP_LOAD_FACTOR)
+		capacity *= GENERIC_HASH_MAP_GROW_RATE;
+
+	*map = malloc(sizeof(GenericHashMap));
+
+	if (!(*map))
+		return DS_ERR_ALLOC;
+
+	(*map)->key_size = key_size;
+	(*map)->value_size = value_size;
+	(*map)->value_offset = GMAP_ALIGN(sizeof(size_t) + key_size);
+	(*map)->stride = GMAP_ALIGN((*map)->value_offset + value_size);
+
+	(*map)->table = calloc(capacity, (*map)->stride);
+	(*map)->scratch = malloc((*map)->stride * 2);
+
+	if (!((*map)->table) || !((*map)->scratch))
+	{
+		free((*map)->table);
+		free((*map)->scratch);
+		free(*map);
+
+		*map = NULL;
+
+		return DS_ERR_ALLOC;
+	}
+
+	(*map)->size = 0;
+	(*map)->capacity = capacity;
+	(*map)->load_factor = GENERIC_HASH_MAP_LOAD_FACTOR;
+
+	(*map)->hash_function = hash_function != NULL ? hash_function : gmap_hash_bytes;
+	(*map)->compare_function = compare_function != NULL ? compare_function : memcmp;
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                            Getters                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+static size_t gmap_probe_distance(size_t capacity, size_t tag, size_t pos)
+{
+	return (pos - (tag & (capacity - 1))) & (capacity - 1);
+}
+
+static Status gmap_tag(GenericHashMap *map, const void *key, size_t *tag)
+{
+	Status st = map->hash_function(key, map->key_size, tag);
+
+	*tag |= GMAP_OCCUPIED;
+
+	return st;
+}
+
+// Slot holding key or NULL
+static unsigned char *gmap_find(GenericHashMap *map, const void *key, size_t tag)
+{
+	size_t mask = map->capacity - 1;
+	size_t pos = tag & mask;
+	size_t dist = 0;
+
+	unsigned char *slot;
+
+	while (true)
+	{
+		slot = GMAP_SLOT(map->table, map->stride, pos);
+
+		if (GMAP_TAG(slot) == 0 || gmap_probe_distance(map->capacity, GMAP_TAG(slot), pos) < dist)
+			return NULL;
+
+		if (GMAP_TAG(slot) == tag && map->compare_function(GMAP_KEY(slot), key, map->key_size) == 0)
+			return slot;
+
+		pos = (pos + 1) & mask;
+
+		dist++;
+	}
+}
+
+// Places the entry held in the first scratch slot, which is known not to be
+// in the table yet, and returns where it ended up
+static unsigned char *gmap_place(GenericHashMap *map, unsigned char *table, size_t capacity)
+{
+	size_t mask = capacity - 1;
+	size_t stride = map->stride;
+
+	unsigned char *entry = map->scratch;
+	unsigned char *temp = map->scratch + stride;
+	unsigned char *slot, *placed = NULL;
+
+	size_t pos = GMAP_TAG(entry) & mask;
+	size_t dist = 0, slot_dist;
+
+	while (true)
+	{
+		slot = GMAP_SLOT(table, stride, pos);
+
+		if (GMAP_TAG(slot) == 0)
+		{
+			memcpy(slot, entry, stride);
+
+			return placed != NULL ? placed : slot;
+		}
+
+		slot_dist = gmap_probe_distance(capacity, GMAP_TAG(slot), pos);
+
+		// Robin Hood: steal the slot from an entry that is closer to home
+		if (slot_dist < dist)
+		{
+			memcpy(temp, slot, stride);
+			memcpy(slot, entry, stride);
+			memcpy(entry, temp, stride);
+
+			if (placed == NULL)
+				placed = slot;
+
+			dist = slot_dist;
+		}
+
+		pos = (pos + 1) & mask;
+
+		dist++;
+	}
+}
+
+// Backward shift deletion, see map_erase_at
+static void gmap_erase_at(GenericHashMap *map, size_t pos)
+{
+	size_t mask = map->capacity - 1;
+	size_t next = (pos + 1) & mask;
+	size_t stride = map->stride;
+
+	unsigned char *slot = GMAP_SLOT(map->table, stride, next);
+
+	while (GMAP_TAG(slot) != 0 && gmap_probe_distance(map->capacity, GMAP_TAG(slot), next) != 0)
+	{
+		memcpy(GMAP_SLOT(map->table, stride, pos), slot, stride);
+
+		pos = next;
+		next = (next + 1) & mask;
+
+		slot = GMAP_SLOT(map->table, stride, next);
+	}
+
+	memset(GMAP_SLOT(map->table, stride, pos), 0, stride);
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                            Insertion                                            |
+// +-------------------------------------------------------------------------------------------------+
+
+// Pointer to the value of key, inserting it with a zeroed value if needed
+static Status gmap_slot_for(GenericHashMap *map, const void *key, bool *inserted, unsigned char **slot)
+{
+	size_t tag;
+
+	Status st = gmap_tag(map, key, &tag);
+
+	if (st != DS_OK)
+		return st;
+
+	*slot = gmap_find(map, key, tag);
+	*inserted = false;
+
+	if (*slot != NULL)
+		return DS_OK;
+
+	if ((double)(map->size + 1) > (double)map->capacity * map->load_factor)
+	{
+		st = gmap_rehash(map, map->capacity * GENERIC_HASH_MAP_GROW_RATE);
+
+		if (st != DS_OK)
+			return st;
+	}
+
+	memset(map->scratch, 0, map->stride);
+	memcpy(GMAP_KEY(map->scratch), key, map->key_size);
+
+	GMAP_TAG(map->scratch) = tag;
+
+	*slot = gmap_place(map, map->table, map->capacity);
+	*inserted = true;
+
+	(map->size)++;
+
+	return DS_OK;
+}
+
+// Copies key and value into the map, updating the value if key exists
+Status gmap_insert(GenericHashMap *map, const void *key, const void *value)
+{
+	if (map == NULL || key == NULL || (value == NULL && map->value_size > 0))
+		return DS_ERR_NULL_POINTER;
+
+	bool inserted;
+	unsigned char *slot;
+
+	Status st = gmap_slot_for(map, key, &inserted, &slot);
+
+	if (st != DS_OK)
+		return st;
+
+	if (map->value_size > 0)
+		memcpy(slot + map->value_offset, value, map->value_size);
+
+	return DS_OK;
+}
+
+// Value of key to be written in place. New keys start with a zeroed value.
+Status gmap_emplace(GenericHashMap *map, const void *key, void **value)
+{
+	*value = NULL;
+
+	if (map == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	bool inserted;
+	unsigned char *slot;
+
+	Status st = gmap_slot_for(map, key, &inserted, &slot);
+
+	if (st != DS_OK)
+		return st;
+
+	*value = slot + map->value_offset;
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Removal                                             |
+// +-------------------------------------------------------------------------------------------------+
+
+Status gmap_remove(GenericHashMap *map, const void *key)
+{
+	if (map == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (map->size == 0)
+		return DS_ERR_INVALID_OPERATION;
+
+	size_t tag;
+
+	Status st = gmap_tag(map, key, &tag);
+
+	if (st != DS_OK)
+		return st;
+
+	unsigned char *slot = gmap_find(map, key, tag);
+
+	if (slot == NULL)
+		return DS_ERR_NOT_FOUND;
+
+	gmap_erase_at(map, (size_t)(slot - map->table) / map->stride);
+
+	(map->size)--;
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Display                                             |
+// +-------------------------------------------------------------------------------------------------+
+
+// Keys and values are opaque, only the layout of the map is shown
+Status gmap_display_map(GenericHashMap *map)
+{
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	printf("\nGeneric Hash Map");
+	printf("\n  Entries  : %zu", map->size);
+	printf("\n  Capacity : %zu", map->capacity);
+	printf("\n  Slot     : %zu bytes (key %zu, value %zu at offset %zu)", map->stride, map->key_size, map->value_size, map->value_offset);
+
+	printf("\n");
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Resets                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+Status gmap_delete_map(GenericHashMap **map)
+{
+	if ((*map) == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	free((*map)->table);
+	free((*map)->scratch);
+	free(*map);
+
+	*map = NULL;
+
+	return DS_OK;
+}
+
+// Removes every entry keeping the capacity and functions of the map
+Status gmap_erase_map(GenericHashMap **map)
+{
+	if ((*map) == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	memset((*map)->table, 0, (*map)->capacity * (*map)->stride);
+
+	(*map)->size = 0;
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Search                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+// Copies the value of key into value
+Status gmap_search(GenericHashMap *map, const void *key, void *value)
+{
+	void *found;
+
+	Status st = gmap_get(map, key, &found);
+
+	if (st != DS_OK)
+		return st;
+
+	if (map->value_size > 0)
+		memcpy(value, found, map->value_size);
+
+	return DS_OK;
+}
+
+// Pointer to the value of key inside the table
+Status gmap_get(GenericHashMap *map, const void *key, void **value)
+{
+	*value = NULL;
+
+	if (map == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	size_t tag;
+
+	Status st = gmap_tag(map, key, &tag);
+
+	if (st != DS_OK)
+		return st;
+
+	unsigned char *slot = gmap_find(map, key, tag);
+
+	if (slot == NULL)
+		return DS_ERR_NOT_FOUND;
+
+	*value = slot + map->value_offset;
+
+	return DS_OK;
+}
+
+bool gmap_contains(GenericHashMap *map, const void *key)
+{
+	void *value;
+
+	return gmap_get(map, key, &value) == DS_OK;
+}
+
+// Visits every entry in table order. cursor must start at 0 and the map
+// must not be modified until the iteration ends.
+bool gmap_iter_next(GenericHashMap *map, size_t *cursor, void **key, void **value)
+{
+	if (map == NULL)
+		return false;
+
+	while (*cursor < map->capacity)
+	{
+		unsigned char *slot = GMAP_SLOT(map->table, map->stride, *cursor);
+
+		(*cursor)++;
+
+		if (GMAP_TAG(slot) != 0)
+		{
+			*key = GMAP_KEY(slot);
+			*value = slot + map->value_offset;
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Counts                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+Status gmap_count_entries(GenericHashMap *map, size_t *result)
+{
+	*result = 0;
+
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	*result = map->size;
+
+	return DS_OK;
+}
+
+// Longest probe sequence needed to reach an entry
+Status gmap_count_collisions_max(GenericHashMap *map, size_t *result)
+{
+	*result = 0;
+
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	size_t i, total;
+	for (i = 0; i < map->capacity; i++)
+	{
+		unsigned char *slot = GMAP_SLOT(map->table, map->stride, i);
+
+		if (GMAP_TAG(slot) != 0)
+		{
+			total = gmap_probe_distance(map->capacity, GMAP_TAG(slot), i) + 1;
+
+			if (total > *result)
+				*result = total;
+		}
+	}
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                            Buffer                                               |
+// +-------------------------------------------------------------------------------------------------+
+
+Status gmap_set_load_factor(GenericHashMap *map, double load_factor)
+{
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (load_factor <= 0.0 || load_factor >= 1.0)
+		return DS_ERR_INVALID_ARGUMENT;
+
+	map->load_factor = load_factor;
+
+	if ((double)map->size > (double)map->capacity * map->load_factor)
+		return gmap_rehash(map, map->capacity * GENERIC_HASH_MAP_GROW_RATE);
+
+	return DS_OK;
+}
+
+// Moves every entry to a new table with at least size slots
+Status gmap_rehash(GenericHashMap *map, size_t size)
+{
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	size_t capacity = GENERIC_HASH_MAP_INIT_SIZE;
+
+	while (capacity < size || (double)map->size > (double)capacity * map->load_factor)
+		capacity *= GENERIC_HASH_MAP_GROW_RATE;
+
+	unsigned char *new_table = calloc(capacity, map->stride);
+
+	if (!new_table)
+		return DS_ERR_ALLOC;
+
+	unsigned char *old_table = map->table;
+	size_t old_capacity = map->capacity;
+
+	size_t i;
+	for (i = 0; i < old_capacity; i++)
+	{
+		unsigned char *slot = GMAP_SLOT(old_table, map->stride, i);
+
+		if (GMAP_TAG(slot) != 0)
+		{
+			memcpy(map->scratch, slot, map->stride);
+
+			gmap_place(map, new_table, capacity);
+		}
+	}
+
+	map->table = new_table;
+	map->capacity = capacity;
+
+	free(old_table);
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Hash                                                |
+// +-------------------------------------------------------------------------------------------------+
+
+// Default hash function, the raw bytes of the key
+Status gmap_hash_bytes(const void *key, size_t size, size_t *hash)
+{
+	return hash_wyhash_n((char *)key, size, hash);
+}
+
+// For keys that are a char * to a NUL terminated string owned by the caller
+Status gmap_hash_string(const void *key, size_t size, size_t *hash)
+{
+	(void)size;
+
+	char *string = *(char *const *)key;
+
+	return hash_wyhash_n(string, strlen(string), hash);
+}
+
+int gmap_compare_string(const void *key1, const void *key2, size_t size)
+{
+	(void)size;
+
+	return strcmp(*(char *const *)key1, *(char *const *)key2);
+}
@@ -0,0 +1,552 @@
+/**
+ * @file HashFunctions.c
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Source file for high throughput string hash functions
+ *
+ * @c hash_wyhash follows the design of wyhash, mixing 48 bytes per
+ * iteration with three independent 64x64->128 bit multiplications.
+ * @c hash_xxh3 follows the design of XXH3: short keys are mixed 16 bytes at
+ * a time and long keys are consumed in 64 byte stripes by eight 64-bit
+ * accumulators, which map directly onto SSE2 and AVX2 registers. Neither
+ * function is bit-compatible with the reference implementations.
+ *
+ */
+
+#include <Windows.h>
+#include <intrin.h>
+#include <immintrin.h>
+#include "HashFunctions.h"
+#include "Cpu.h"
+
+#define HASH_PRIME32_1 0x9E3779B1U
+#define HASH_PRIME32_2 0x85EBCA77U
+#define HASH_PRIME32_3 0xC2B2AE3DU
+#define HASH_PRIME64_1 0x9E3779B185EBCA87ULL
+#define HASH_PRIME64_2 0xC2B2AE3D27D4EB4FULL
+#define HASH_PRIME64_3 0x165667B19E3779F9ULL
+#define HASH_PRIME64_4 0x85EBCA77C2B2AE63ULL
+#define HASH_PRIME64_5 0x27D4EB2F165667C5ULL
+
+#define HASH_STRIPE_LEN 64
+#define HASH_SECRET_SIZE 192
+#define HASH_STRIPES_PER_BLOCK ((HASH_SECRET_SIZE - HASH_STRIPE_LEN) / 8)
+#define HASH_BLOCK_LEN (HASH_STRIPE_LEN * HASH_STRIPES_PER_BLOCK)
+
+static const uint64_t hash_wy_secret[4] = {
+	0x2D358DCCAA6C78A5ULL, 0x8BB84B93962EACC9ULL, 0x4B33A62ED433D4A3ULL, 0x4D5A2DA51DE1AA47ULL};
+
+static const uint64_t hash_secret_words[HASH_SECRET_SIZE / 8] = {
+	0x2CB0F69F4ABEA221ULL, 0x9417034723148989ULL, 0xDD555950609DFE03ULL, 0xDBAFB150DEB12800ULL,
+	0x7E789B2E6C442CB6ULL, 0xF41E5636C7E4F8C4ULL, 0x0959D150F8FBA7E4ULL, 0xA97316F13CDB9EEAULL,
+	0x74CD8258F9520068ULL, 0x55C74A62E116868BULL, 0xD2F4C799A2023CBDULL, 0xDF98CB79A37B51B9ULL,
+	0x396F5885524F3905ULL, 0xAF1D56386CA3B276ULL, 0xA9FFBE6B5104E85AULL, 0x6BD0C51B9FD533B3ULL,
+	0x980CE91C50AB4B56ULL, 0x28AC395780FE62C5ULL, 0x768912E3A6BCEDC7ULL, 0x50B3E8C9332C7C88ULL,
+	0xCE3BBFE520BD47DAULL, 0xCBA6C8E8E0BB7C4FULL, 0xBF194DB8434A346DULL, 0x7D8F2A7B60416D7FULL};
+
+#define HASH_SECRET ((const unsigned char *)hash_secret_words)
+
+typedef void (*hash_accumulate_t)(uint64_t *acc, const unsigned char *data, const unsigned char *secret, size_t stripes);
+typedef void (*hash_scramble_t)(uint64_t *acc, const unsigned char *secret);
+
+static HashKernel hash_kernel = HASH_KERNEL_AUTO;
+static hash_accumulate_t hash_accumulate = NULL;
+static hash_scramble_t hash_scramble = NULL;
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                            Utility                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+static uint64_t hash_read64(const unsigned char *p)
+{
+	uint64_t v;
+	memcpy(&v, p, sizeof(uint64_t));
+	return v;
+}
+
+static uint64_t hash_read32(const unsigned char *p)
+{
+	uint32_t v;
+	memcpy(&v, p, sizeof(uint32_t));
+	return v;
+}
+
+// Full 64x64 -> 128 bit multiplication, *a gets the low and *b the high half
+static void hash_mul128(uint64_t *a, uint64_t *b)
+{
+#if defined(_M_X64)
+	uint64_t hi;
+	*a = _umul128(*a, *b, &hi);
+	*b = hi;
+#else
+	uint64_t ha = *a >> 32, la = (uint32_t)*a;
+	uint64_t hb = *b >> 32, lb = (uint32_t)*b;
+
+	uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+
+	uint64_t t = rl + (rm0 << 32);
+	uint64_t c = t < rl;
+	uint64_t lo = t + (rm1 << 32);
+
+	c += lo < t;
+
+	*a = lo;
+	*b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+static uint64_t hash_mix(uint64_t a, uint64_t b)
+{
+	hash_mul128(&a, &b);
+
+	return a ^ b;
+}
+
+static uint64_t hash_avalanche(uint64_t h)
+{
+	h ^= h >> 37;
+	h *= HASH_PRIME64_3;
+	h ^= h >> 32;
+
+	return h;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             wyhash                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+static uint64_t hash_wyhash_bytes(const unsigned char *p, size_t len, uint64_t seed)
+{
+	const uint64_t *s = hash_wy_secret;
+
+	uint64_t a, b;
+
+	seed ^= hash_mix(seed ^ s[0], s[1]);
+
+	if (len <= 16)
+	{
+		if (len >= 4)
+		{
+			size_t q = (len >> 3) << 2;
+
+			a = (hash_read32(p) << 32) | hash_read32(p + q);
+			b = (hash_read32(p + len - 4) << 32) | hash_read32(p + len - 4 - q);
+		}
+		else if (len > 0)
+		{
+			a = ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) | p[len - 1];
+			b = 0;
+		}
+		else
+			a = b = 0;
+	}
+	else
+	{
+		size_t i = len;
+
+		if (i > 48)
+		{
+			uint64_t see1 = seed, see2 = seed;
+
+			// Three independent multiplication chains per 48 bytes
+			do
+			{
+				seed = hash_mix(hash_read64(p) ^ s[1], hash_read64(p + 8) ^ seed);
+				see1 = hash_mix(hash_read64(p + 16) ^ s[2], hash_read64(p + 24) ^ see1);
+				see2 = hash_mix(hash_read64(p + 32) ^ s[3], hash_read64(p + 40) ^ see2);
+
+				p += 48;
+				i -= 48;
+			} while (i > 48);
+
+			seed ^= see1 ^ see2;
+		}
+
+		while (i > 16)
+		{
+			seed = hash_mix(hash_read64(p) ^ s[1], hash_read64(p + 8) ^ seed);
+
+			i -= 16;
+			p += 16;
+		}
+
+		a = hash_read64(p + i - 16);
+		b = hash_read64(p + i - 8);
+	}
+
+	a ^= s[1];
+	b ^= seed;
+
+	hash_mul128(&a, &b);
+
+	return hash_mix(a ^ s[0] ^ len, b ^ s[1]);
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                          XXH3 kernels                                           |
+// +-------------------------------------------------------------------------------------------------+
+
+static void hash_accumulate_scalar(uint64_t *acc, const unsigned char *data, const unsigned char *secret, size_t stripes)
+{
+	size_t n, i;
+	for (n = 0; n < stripes; n++)
+	{
+		const unsigned char *p = data + n * HASH_STRIPE_LEN;
+		const unsigned char *k = secret + n * 8;
+
+		for (i = 0; i < 8; i++)
+		{
+			uint64_t d = hash_read64(p + i * 8);
+			uint64_t dk = d ^ hash_read64(k + i * 8);
+
+			acc[i ^ 1] += d;
+			acc[i] += (dk & 0xFFFFFFFF) * (dk >> 32);
+		}
+	}
+}
+
+static void hash_scramble_scalar(uint64_t *acc, const unsigned char *secret)
+{
+	size_t i;
+	for (i = 0; i < 8; i++)
+	{
+		uint64_t a = acc[i];
+
+		a ^= a >> 47;
+		a ^= hash_read64(secret + i * 8);
+		a *= HASH_PRIME32_1;
+
+		acc[i] = a;
+	}
+}
+
+static void hash_accumulate_sse2(uint64_t *acc, const unsigned char *data, const unsigned char *secret, size_t stripes)
+{
+	__m128i a[4];
+
+	size_t n, i;
+	for (i = 0; i < 4; i++)
+		a[i] = _mm_loadu_si128((const __m128i *)(acc + i * 2));
+
+	for (n = 0; n < stripes; n++)
+	{
+		const unsigned char *p = data + n * HASH_STRIPE_LEN;
+		const unsigned char *k = secret + n * 8;
+
+		for (i = 0; i < 4; i++)
+		{
+			__m128i d = _mm_loadu_si128((const __m128i *)(p + i * 16));
+			__m128i dk = _mm_xor_si128(d, _mm_loadu_si128((const __m128i *)(k + i * 16)));
+
+			// Low 32 bits of each lane times its high 32 bits
+			__m128i prod = _mm_mul_epu32(dk, _mm_shuffle_epi32(dk, _MM_SHUFFLE(0, 3, 0, 1)));
+			__m128i swap = _mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2));
+
+			a[i] = _mm_add_epi64(a[i], _mm_add_epi64(prod, swap));
+		}
+	}
+
+	for (i = 0; i < 4; i++)
+		_mm_storeu_si128((__m128i *)(acc + i * 2), a[i]);
+}
+
+static void hash_scramble_sse2(uint64_t *acc, const unsigned char *secret)
+{
+	const __m128i prime = _mm_set1_epi32((int)HASH_PRIME32_1);
+
+	size_t i;
+	for (i = 0; i < 4; i++)
+	{
+		__m128i a = _mm_loadu_si128((const __m128i *)(acc + i * 2));
+
+		a = _mm_xor_si128(a, _mm_srli_epi64(a, 47));
+		a = _mm_xor_si128(a, _mm_loadu_si128((const __m128i *)(secret + i * 16)));
+
+		// 64-bit by 32-bit multiplication out of two 32x32->64 products
+		__m128i lo = _mm_mul_epu32(a, prime);
+		__m128i hi = _mm_mul_epu32(_mm_shuffle_epi32(a, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+
+		_mm_storeu_si128((__m128i *)(acc + i * 2), _mm_add_epi64(lo, _mm_slli_epi64(hi, 32)));
+	}
+}
+
+static void hash_accumulate_avx2(uint64_t *acc, const unsigned char *data, const unsigned char *secret, size_t stripes)
+{
+	__m256i a0 = _mm256_loadu_si256((const __m256i *)acc);
+	__m256i a1 = _mm256_loadu_si256((const __m256i *)(acc + 4));
+
+	size_t n;
+	for (n = 0; n < stripes; n++)
+	{
+		const unsigned char *p = data + n * HASH_STRIPE_LEN;
+		const unsigned char *k = secret + n * 8;
+
+		__m256i d0 = _mm256_loadu_si256((const __m256i *)p);
+		__m256i d1 = _mm256_loadu_si256((const __m256i *)(p + 32));
+
+		__m256i dk0 = _mm256_xor_si256(d0, _mm256_loadu_si256((const __m256i *)k));
+		__m256i dk1 = _mm256_xor_si256(d1, _mm256_loadu_si256((const __m256i *)(k + 32)));
+
+		__m256i prod0 = _mm256_mul_epu32(dk0, _mm256_shuffle_epi32(dk0, _MM_SHUFFLE(0, 3, 0, 1)));
+		__m256i prod1 = _mm256_mul_epu32(dk1, _mm256_shuffle_epi32(dk1, _MM_SHUFFLE(0, 3, 0, 1)));
+
+		a0 = _mm256_add_epi64(a0, _mm256_add_epi64(prod0, _mm256_shuffle_epi32(d0, _MM_SHUFFLE(1, 0, 3, 2))));
+		a1 = _mm256_add_epi64(a1, _mm256_add_epi64(prod1, _mm256_shuffle_epi32(d1, _MM_SHUFFLE(1, 0, 3, 2))));
+	}
+
+	_mm256_storeu_si256((__m256i *)acc, a0);
+	_mm256_storeu_si256((__m256i *)(acc + 4), a1);
+}
+
+static void hash_scramble_avx2(uint64_t *acc, const unsigned char *secret)
+{
+	const __m256i prime = _mm256_set1_epi32((int)HASH_PRIME32_1);
+
+	size_t i;
+	for (i = 0; i < 2; i++)
+	{
+		__m256i a = _mm256_loadu_si256((const __m256i *)(acc + i * 4));
+
+		a = _mm256_xor_si256(a, _mm256_srli_epi64(a, 47));
+		a = _mm256_xor_si256(a, _mm256_loadu_si256((const __m256i *)(secret + i * 32)));
+
+		__m256i lo = _mm256_mul_epu32(a, prime);
+		__m256i hi = _mm256_mul_epu32(_mm256_shuffle_epi32(a, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+
+		_mm256_storeu_si256((__m256i *)(acc + i * 4), _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32)));
+	}
+}
+
+// Binds the kernel function pointers on first use. Threads may get here at
+// the same time and callers only check hash_accumulate, so it is published
+// last and both pointers are swapped atomically.
+static void hash_select_kernel(void)
+{
+	HashKernel kernel = hash_kernel;
+
+	hash_accumulate_t accumulate;
+	hash_scramble_t scramble;
+
+	if (kernel == HASH_KERNEL_AUTO)
+	{
+		if (cpu_has(CPU_AVX2))
+			kernel = HASH_KERNEL_AVX2;
+		else if (cpu_has(CPU_SSE2))
+			kernel = HASH_KERNEL_SSE2;
+		else
+			kernel = HASH_KERNEL_SCALAR;
+	}
+
+	switch (kernel)
+	{
+	case HASH_KERNEL_AVX2:
+		scramble = hash_scramble_avx2;
+		accumulate = hash_accumulate_avx2;
+		break;
+	case HASH_KERNEL_SSE2:
+		scramble = hash_scramble_sse2;
+		accumulate = hash_accumulate_sse2;
+		break;
+	default:
+		scramble = hash_scramble_scalar;
+		accumulate = hash_accumulate_scalar;
+		break;
+	}
+
+	InterlockedExchangePointer((PVOID volatile *)&hash_scramble, (PVOID)scramble);
+	InterlockedExchangePointer((PVOID volatile *)&hash_accumulate, (PVOID)accumulate);
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                              XXH3                                               |
+// +-------------------------------------------------------------------------------------------------+
+
+static uint64_t hash_mix16(const unsigned char *p, const unsigned char *secret, uint64_t seed)
+{
+	return hash_mix(hash_read64(p) ^ (hash_read64(secret) + seed),
+					hash_read64(p + 8) ^ (hash_read64(secret + 8) - seed));
+}
+
+static uint64_t hash_xxh3_long(const unsigned char *p, size_t len)
+{
+	uint64_t acc[8] = {
+		HASH_PRIME32_3, HASH_PRIME64_1, HASH_PRIME64_2, HASH_PRIME64_3,
+		HASH_PRIME64_4, HASH_PRIME32_2, HASH_PRIME64_5, HASH_PRIME32_1};
+
+	if (hash_accumulate == NULL)
+		hash_select_kernel();
+
+	size_t blocks = (len - 1) / HASH_BLOCK_LEN;
+
+	size_t n;
+	for (n = 0; n < blocks; n++)
+	{
+		hash_accumulate(acc, p + n * HASH_BLOCK_LEN, HASH_SECRET, HASH_STRIPES_PER_BLOCK);
+		hash_scramble(acc, HASH_SECRET + HASH_SECRET_SIZE - HASH_STRIPE_LEN);
+	}
+
+	size_t stripes = ((len - 1) - blocks * HASH_BLOCK_LEN) / HASH_STRIPE_LEN;
+
+	hash_accumulate(acc, p + blocks * HASH_BLOCK_LEN, HASH_SECRET, stripes);
+
+	// Last stripe always covers the final 64 bytes
+	hash_accumulate(acc, p + len - HASH_STRIPE_LEN, HASH_SECRET + HASH_SECRET_SIZE - HASH_STRIPE_LEN - 7, 1);
+
+	uint64_t result = len * HASH_PRIME64_1;
+
+	size_t i;
+	for (i = 0; i < 4; i++)
+	{
+		result += hash_mix(acc[2 * i] ^ hash_read64(HASH_SECRET + 11 + 16 * i),
+						   acc[2 * i + 1] ^ hash_read64(HASH_SECRET + 11 + 16 * i + 8));
+	}
+
+	return hash_avalanche(result);
+}
+
+static uint64_t hash_xxh3_bytes(const unsigned char *p, size_t len)
+{
+	const unsigned char *s = HASH_SECRET;
+
+	if (len <= 16)
+	{
+		uint64_t lo, hi;
+
+		if (len > 8)
+		{
+			lo = hash_read64(p) ^ hash_read64(s + 24);
+			hi = hash_read64(p + len - 8) ^ hash_read64(s + 32);
+		}
+		else if (len >= 4)
+		{
+			lo = hash_read32(p) | (hash_read32(p + len - 4) << 32);
+			hi = hash_read64(s + 8);
+		}
+		else if (len > 0)
+		{
+			lo = ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 24) | p[len - 1] | ((uint64_t)len << 8);
+			hi = hash_read64(s + 16);
+		}
+		else
+			return hash_avalanche(hash_read64(s + 56) ^ hash_read64(s + 64));
+
+		return hash_avalanche(len + lo + hi + hash_mix(lo ^ hash_read64(s), hi ^ len));
+	}
+
+	if (len > 128)
+		return hash_xxh3_long(p, len);
+
+	// Pairs of 16 byte chunks, taken from both ends of the key
+	uint64_t acc = len * HASH_PRIME64_1;
+
+	if (len > 32)
+	{
+		if (len > 64)
+		{
+			if (len > 96)
+			{
+				acc += hash_mix16(p + 48, s + 96, 0);
+				acc += hash_mix16(p + len - 64, s + 112, 0);
+			}
+
+			acc += hash_mix16(p + 32, s + 64, 0);
+			acc += hash_mix16(p + len - 48, s + 80, 0);
+		}
+
+		acc += hash_mix16(p + 16, s + 32, 0);
+		acc += hash_mix16(p + len - 32, s + 48, 0);
+	}
+
+	acc += hash_mix16(p, s, 0);
+	acc += hash_mix16(p + len - 16, s + 16, 0);
+
+	return hash_avalanche(acc);
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Hash                                                |
+// +-------------------------------------------------------------------------------------------------+
+
+Status hash_wyhash(char *key, size_t *hash)
+{
+	if (key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	*hash = (size_t)hash_wyhash_bytes((const unsigned char *)key, strlen(key), 0);
+
+	return DS_OK;
+}
+
+Status hash_xxh3(char *key, size_t *hash)
+{
+	if (key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	*hash = (size_t)hash_xxh3_bytes((const unsigned char *)key, strlen(key));
+
+	return DS_OK;
+}
+
+Status hash_wyhash_n(char *key, size_t length, size_t *hash)
+{
+	if (key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	*hash = (size_t)hash_wyhash_bytes((const unsigned char *)key, length, 0);
+
+	return DS_OK;
+}
+
+Status hash_xxh3_n(char *key, size_t length, size_t *hash)
+{
+	if (key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	*hash = (size_t)hash_xxh3_bytes((const unsigned char *)key, length);
+
+	return DS_OK;
+}
+
+// The MurmurHash3 finalizer. Every bit of key affects every bit of the
+// result and distinct keys never collide.
+size_t hash_fmix64(uint64_t key)
+{
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdULL;
+	key ^= key >> 33;
+	key *= 0xc4ceb9fe1a85ec53ULL;
+	key ^= key >> 33;
+
+	return (size_t)key;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                            Kernels                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+// Forces a kernel, mostly for benchmarking. Returns DS_ERR_INVALID_ARGUMENT
+// if the CPU does not support it.
+Status hash_set_kernel(HashKernel kernel)
+{
+	if (kernel == HASH_KERNEL_SSE2 && !cpu_has(CPU_SSE2))
+		return DS_ERR_INVALID_ARGUMENT;
+
+	if (kernel == HASH_KERNEL_AVX2 && !cpu_has(CPU_AVX2))
+		return DS_ERR_INVALID_ARGUMENT;
+
+	if (kernel < HASH_KERNEL_AUTO || kernel > HASH_KERNEL_AVX2)
+		return DS_ERR_INVALID_ARGUMENT;
+
+	hash_kernel = kernel;
+
+	hash_select_kernel();
+
+	return DS_OK;
+}
+
+HashKernel hash_get_kernel(void)
+{
+	return hash_kernel;
+}
@@ -8,7 +8,11 @@
  *
  */
 
+#include <xmmintrin.h>
 #include "HashMap.h"
+#include "HashFunctions.h"
+
+#define HASH_MAP_KEY_BUFFER 256
 
 // +-------------------------------------------------------------------------------------------------+
 // |                                          Initializers                                           |
@@ -19,241 +23,996 @@ Status map_init_map(HashMap **map, size_t size, hash_function_t hash_function)
 	if (size == 0)
 		return DS_ERR_INVALID_SIZE;
 
+	if (hash_function == NULL)
+		return DS_ERR_INVALID_ARGUMENT;
+
+	size_t capacity = HASH_MAP_INIT_SIZE;
+
+	while (capacity < size)
+		capacity *= HASH_MAP_GROW_RATE;
+
 	*map = malloc(sizeof(HashMap));
 
 	if (!(*map))
 		return DS_ERR_ALLOC;
 
-	(*map)->hash_table = malloc(sizeof(HashMapEntry *) * size);
+	(*map)->hash_table = calloc(capacity, sizeof(HashMapEntry));
 
 	if (!((*map)->hash_table))
+	{
+		free(*map);
+
+		*map = NULL;
+
 		return DS_ERR_ALLOC;
+	}
+
+	(*map)->size = 0;
+	(*map)->capacity = capacity;
+	(*map)->load_factor = HASH_MAP_LOAD_FACTOR;
+
+	(*map)->old_table = NULL;
+	(*map)->old_capacity = 0;
+	(*map)->rehash_index = 0;
+	(*map)->rehash_left = 0;
+	(*map)->rehash_step = 0;
+
+	(*map)->hash_function = hash_function;
+	(*map)->hash_function_n = map_hash_length_variant(hash_function);
+
+	(*map)->arena = NULL;
+
+	memset(&((*map)->stats), 0, sizeof(HashMapStats));
+
+	(*map)->track_stats = true;
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                            Getters                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+// Distance between the slot an entry occupies and its home slot
+static size_t map_probe_distance(size_t capacity, size_t hash, size_t pos)
+{
+	return (pos - (hash & (capacity - 1))) & (capacity - 1);
+}
+
+// Returns the slot of table holding key or SIZE_MAX if it is not there.
+// The number of slots compared is added to probes.
+static size_t map_find(HashMapEntry *table, size_t capacity, char *key, size_t length, size_t hash, size_t *probes)
+{
+	size_t mask = capacity - 1;
+	size_t pos = hash & mask;
+	size_t dist = 0;
+
+	HashMapEntry *slot;
+
+	while (true)
+	{
+		slot = &(table[pos]);
+
+		if (slot->key == NULL || map_probe_distance(capacity, slot->hash, pos) < dist)
+		{
+			*probes += dist + 1;
+
+			return SIZE_MAX;
+		}
+
+		if (slot->hash == hash && slot->length == length && memcmp(slot->key, key, length) == 0)
+		{
+			*probes += dist + 1;
+
+			return pos;
+		}
+
+		pos = (pos + 1) & mask;
+
+		dist++;
+	}
+}
+
+// Places an entry that is known not to be in table yet. Returns the longest
+// probe distance of the entry and of every entry it displaced.
+static size_t map_place(HashMapEntry *table, size_t capacity, HashMapEntry entry)
+{
+	size_t mask = capacity - 1;
+	size_t pos = entry.hash & mask;
+	size_t dist = 0, slot_dist, longest = 0;
+
+	HashMapEntry *slot, temp;
+
+	while (true)
+	{
+		slot = &(table[pos]);
+
+		if (slot->key == NULL)
+		{
+			*slot = entry;
+
+			return dist > longest ? dist : longest;
+		}
+
+		slot_dist = map_probe_distance(capacity, slot->hash, pos);
+
+		// Robin Hood: steal the slot from an entry that is closer to home
+		if (slot_dist < dist)
+		{
+			if (dist > longest)
+				longest = dist;
+
+			temp = *slot;
+			*slot = entry;
+			entry = temp;
+
+			dist = slot_dist;
+		}
+
+		pos = (pos + 1) & mask;
+
+		dist++;
+	}
+}
+
+// Backward shift deletion: pull the following entries of the cluster one
+// slot closer to their home until an empty or home slot is found
+static void map_erase_at(HashMapEntry *table, size_t capacity, size_t pos)
+{
+	size_t mask = capacity - 1;
+	size_t next = (pos + 1) & mask;
+
+	HashMapEntry *slot = &(table[next]);
+
+	while (slot->key != NULL && map_probe_distance(capacity, slot->hash, next) != 0)
+	{
+		table[pos] = *slot;
+
+		pos = next;
+		next = (next + 1) & mask;
+
+		slot = &(table[next]);
+	}
+
+	table[pos].key = NULL;
+	table[pos].value = 0;
+	table[pos].hash = 0;
+	table[pos].length = 0;
+}
+
+// Finds the table holding key, which might be the old one while rehashing
+static HashMapEntry *map_lookup(HashMap *map, char *key, size_t length, size_t hash, size_t *probes)
+{
+	size_t pos = map_find(map->hash_table, map->capacity, key, length, hash, probes);
+
+	if (pos != SIZE_MAX)
+		return &((map->hash_table)[pos]);
+
+	if (map->old_table == NULL)
+		return NULL;
+
+	pos = map_find(map->old_table, map->old_capacity, key, length, hash, probes);
+
+	if (pos != SIZE_MAX)
+		return &((map->old_table)[pos]);
+
+	return NULL;
+}
+
+static void map_stats_search(HashMap *map, size_t probes, bool found)
+{
+	HashMapStats *stats = &(map->stats);
+
+	(stats->searches)++;
+
+	if (!found)
+		(stats->misses)++;
+
+	stats->probes += probes;
+
+	(stats->probe_histogram[probes < HASH_MAP_STATS_PROBES ? probes - 1 : HASH_MAP_STATS_PROBES - 1])++;
+}
+
+// Probe sequences are counted as in map_count_collisions_max
+static void map_stats_place(HashMap *map, size_t dist)
+{
+	if (map->track_stats && dist + 1 > map->stats.probe_max)
+		map->stats.probe_max = dist + 1;
+}
+
+// A new table starts with no probe distances
+static void map_stats_resize(HashMap *map)
+{
+	if (map->track_stats)
+	{
+		(map->stats.resizes)++;
+
+		map->stats.probe_max = 0;
+	}
+}
+
+// Hashes length bytes of key. When the map only has a hash_function_t and
+// key is not known to be NUL terminated it is copied to a terminated buffer.
+static Status map_hash_key(HashMap *map, char *key, size_t length, bool terminated, size_t *hash)
+{
+	if (map->hash_function_n != NULL)
+		return map->hash_function_n(key, length, hash);
+
+	if (terminated)
+		return map->hash_function(key, hash);
+
+	char small[HASH_MAP_KEY_BUFFER];
+	char *buffer = small;
+
+	if (length >= HASH_MAP_KEY_BUFFER)
+	{
+		buffer = malloc(length + 1);
+
+		if (!buffer)
+			return DS_ERR_ALLOC;
+	}
+
+	memcpy(buffer, key, length);
+	buffer[length] = '\0';
+
+	Status st = map->hash_function(buffer, hash);
+
+	if (buffer != small)
+		free(buffer);
+
+	return st;
+}
+
+// Hashes length bytes of key exactly as the map does, for the _hashed
+// functions. key does not need to be NUL terminated.
+Status map_hash(HashMap *map, char *key, size_t length, size_t *hash)
+{
+	if (map == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return map_hash_key(map, key, length, false, hash);
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                            Insertion                                            |
+// +-------------------------------------------------------------------------------------------------+
+
+// Inserts key with a hash already computed by the map hash function
+Status map_insert_hashed(HashMap *map, char *key, size_t length, size_t hash, int value)
+{
+	if (map == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	Status st;
+	size_t probes = 0;
+
+	if (map_is_rehashing(map))
+		map_rehash_step(map);
+
+	HashMapEntry *found = map_lookup(map, key, length, hash, &probes);
+
+	if (found != NULL)
+	{
+		found->value = value;
+
+		if (map->track_stats)
+			(map->stats.updates)++;
+
+		return DS_OK;
+	}
+
+	if ((double)(map->size + 1) > (double)map->capacity * map->load_factor)
+	{
+		if (map->rehash_step > 0)
+			st = map_rehash_start(map, map->capacity * HASH_MAP_GROW_RATE);
+		else
+			st = map_rehash(map, map->capacity * HASH_MAP_GROW_RATE);
+
+		if (st != DS_OK)
+			return st;
+	}
+
+	HashMapEntry entry;
+
+	if (map->arena != NULL)
+	{
+		st = arn_strndup(map->arena, key, length, &(entry.key));
+
+		if (st != DS_OK)
+			return st;
+	}
+	else
+	{
+		entry.key = malloc(length + 1);
+
+		if (!(entry.key))
+			return DS_ERR_ALLOC;
+
+		memcpy(entry.key, key, length);
+		entry.key[length] = '\0';
+	}
+
+	entry.value = value;
+	entry.hash = hash;
+	entry.length = length;
+
+	map_stats_place(map, map_place(map->hash_table, map->capacity, entry));
+
+	(map->size)++;
+
+	if (map->track_stats)
+		(map->stats.inserts)++;
+
+	return DS_OK;
+}
+
+static Status map_insert_key(HashMap *map, char *key, size_t length, bool terminated, int value)
+{
+	size_t hash;
+
+	Status st = map_hash_key(map, key, length, terminated, &hash);
+
+	if (st != DS_OK)
+		return st;
+
+	return map_insert_hashed(map, key, length, hash, value);
+}
+
+Status map_insert(HashMap *map, char *key, int value)
+{
+	if (map == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return map_insert_key(map, key, strlen(key), true, value);
+}
+
+Status map_insert_n(HashMap *map, char *key, size_t length, int value)
+{
+	if (map == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return map_insert_key(map, key, length, false, value);
+}
+
+// Inserts count keys at once. The table is sized for all of them up front
+// and every key is hashed and its home slot prefetched HASH_MAP_BATCH keys
+// before it is placed, so the cache misses of consecutive keys overlap.
+// An ongoing incremental rehash advances one step per key as with
+// map_insert. Duplicated keys keep the last value.
+Status map_insert_bulk(HashMap *map, char **keys, int *values, size_t count)
+{
+	if (map == NULL || keys == NULL || values == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	Status st;
+
+	if ((double)(map->size + count) > (double)map->capacity * map->load_factor)
+	{
+		size_t size = (size_t)((double)(map->size + count) / map->load_factor) + 1;
+
+		if (map->rehash_step > 0)
+			st = map_rehash_start(map, size);
+		else
+			st = map_rehash(map, size);
+
+		if (st != DS_OK)
+			return st;
+	}
+
+	size_t hashes[HASH_MAP_BATCH];
+	size_t lengths[HASH_MAP_BATCH];
+
+	size_t i, j;
+	for (i = 0; i < count + HASH_MAP_BATCH; i++)
+	{
+		if (i >= HASH_MAP_BATCH)
+		{
+			j = (i - HASH_MAP_BATCH) % HASH_MAP_BATCH;
+
+			st = map_insert_hashed(map, keys[i - HASH_MAP_BATCH], lengths[j], hashes[j], values[i - HASH_MAP_BATCH]);
+
+			if (st != DS_OK)
+				return st;
+		}
+
+		if (i < count)
+		{
+			j = i % HASH_MAP_BATCH;
+
+			if (keys[i] == NULL)
+				return DS_ERR_NULL_POINTER;
+
+			lengths[j] = strlen(keys[i]);
+
+			st = map_hash_key(map, keys[i], lengths[j], true, &(hashes[j]));
+
+			if (st != DS_OK)
+				return st;
+
+			_mm_prefetch((const char *)&((map->hash_table)[hashes[j] & (map->capacity - 1)]), _MM_HINT_T0);
+
+			if (map->old_table != NULL)
+				_mm_prefetch((const char *)&((map->old_table)[hashes[j] & (map->old_capacity - 1)]), _MM_HINT_T0);
+		}
+	}
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Removal                                             |
+// +-------------------------------------------------------------------------------------------------+
+
+Status map_remove_hashed(HashMap *map, char *key, size_t length, size_t hash)
+{
+	if (map == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (map->size == 0)
+		return DS_ERR_INVALID_OPERATION;
+
+	if (map_is_rehashing(map))
+		map_rehash_step(map);
+
+	HashMapEntry *table = map->hash_table;
+	size_t capacity = map->capacity;
+	size_t probes = 0;
+
+	size_t pos = map_find(table, capacity, key, length, hash, &probes);
+
+	if (pos == SIZE_MAX && map->old_table != NULL)
+	{
+		table = map->old_table;
+		capacity = map->old_capacity;
+
+		pos = map_find(table, capacity, key, length, hash, &probes);
+	}
+
+	if (pos == SIZE_MAX)
+		return DS_ERR_NOT_FOUND;
+
+	// Arena keys are released with the whole map
+	if (map->arena == NULL)
+		free(table[pos].key);
+
+	map_erase_at(table, capacity, pos);
+
+	(map->size)--;
+
+	if (map->track_stats)
+		(map->stats.removes)++;
+
+	return DS_OK;
+}
+
+static Status map_remove_key(HashMap *map, char *key, size_t length, bool terminated)
+{
+	if (map->size == 0)
+		return DS_ERR_INVALID_OPERATION;
+
+	size_t hash;
+
+	Status st = map_hash_key(map, key, length, terminated, &hash);
+
+	if (st != DS_OK)
+		return st;
+
+	return map_remove_hashed(map, key, length, hash);
+}
+
+Status map_remove(HashMap *map, char *key)
+{
+	if (map == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return map_remove_key(map, key, strlen(key), true);
+}
+
+Status map_remove_n(HashMap *map, char *key, size_t length)
+{
+	if (map == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return map_remove_key(map, key, length, false);
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Display                                             |
+// +-------------------------------------------------------------------------------------------------+
+
+Status map_display_entry(HashMapEntry *entry)
+{
+	if (entry == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	printf("\n| %21zu | %10d | %40s |", entry->hash, entry->value, entry->key);
+
+	return DS_OK;
+}
+
+Status map_display_entry_raw(HashMapEntry *entry)
+{
+	if (entry == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	printf("\n%21zu\t%10d\t%40s", entry->hash, entry->value, entry->key);
+
+	return DS_OK;
+}
+
+static Status map_display_table(HashMapEntry *table, size_t capacity)
+{
+	Status st;
 
 	size_t i;
-	for (i = 0; i < size; i++)
+	for (i = 0; i < capacity; i++)
 	{
 
-		((*map)->hash_table)[i] = NULL;
+		printf("\n+-----------------------+------------+------------------------------------------+");
+
+		if (table[i].key == NULL)
+			printf("\n|         NULL          |    NULL    |                    NULL                  |");
+		else
+		{
+
+			st = map_display_entry(&(table[i]));
+
+			if (st != DS_OK)
+				return st;
+		}
 	}
 
-	(*map)->size = size;
+	return DS_OK;
+}
 
-	(*map)->hash_function = hash_function;
+Status map_display_map(HashMap *map)
+{
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	printf("\n+-------------------------------------------------------------------------------+");
+	printf("\n|                                 Hash map                                      |");
+	printf("\n+-----------------------+------------+------------------------------------------+");
+	printf("\n|         HASH          |   VALUE    |                    KEY                   |");
+
+	Status st = map_display_table(map->hash_table, map->capacity);
+
+	if (st != DS_OK)
+		return st;
+
+	if (map_is_rehashing(map))
+	{
+		printf("\n+-------------------------------------------------------------------------------+");
+		printf("\n|                            Old table (rehashing)                              |");
+
+		st = map_display_table(map->old_table, map->old_capacity);
+
+		if (st != DS_OK)
+			return st;
+	}
+
+	printf("\n+-----------------------+------------+------------------------------------------+");
+
+	printf("\n");
 
 	return DS_OK;
 }
 
-Status map_init_entry(HashMapEntry **entry, int value)
+static Status map_display_table_raw(HashMapEntry *table, size_t capacity)
 {
-	*entry = malloc(sizeof(HashMapEntry));
+	Status st;
 
-	if (!(*entry))
-		return DS_ERR_ALLOC;
+	size_t i;
+	for (i = 0; i < capacity; i++)
+	{
 
-	(*entry)->value = value;
-	(*entry)->hash = 0;
+		if (table[i].key == NULL)
+			printf("\n");
+		else
+		{
+
+			st = map_display_entry_raw(&(table[i]));
 
-	(*entry)->next = NULL;
-	(*entry)->key = NULL;
+			if (st != DS_OK)
+				return st;
+		}
+	}
+
+	return DS_OK;
+}
+
+Status map_display_map_raw(HashMap *map)
+{
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	Status st = map_display_table_raw(map->hash_table, map->capacity);
+
+	if (st != DS_OK)
+		return st;
+
+	if (map_is_rehashing(map))
+	{
+		st = map_display_table_raw(map->old_table, map->old_capacity);
+
+		if (st != DS_OK)
+			return st;
+	}
+
+	printf("\n");
 
 	return DS_OK;
 }
 
 // +-------------------------------------------------------------------------------------------------+
-// |                                            Getters                                              |
+// |                                             Resets                                              |
 // +-------------------------------------------------------------------------------------------------+
 
-Status map_make_entry(HashMapEntry **entry, char *key, int value, size_t hash)
+Status map_delete_map(HashMap **map)
 {
-	*entry = malloc(sizeof(HashMapEntry));
+	if ((*map) == NULL)
+		return DS_ERR_NULL_POINTER;
 
-	if (!(*entry))
-		return DS_ERR_ALLOC;
+	size_t i;
+
+	if ((*map)->arena != NULL)
+		arn_delete_arena(&((*map)->arena));
+	else
+	{
+		for (i = 0; i < (*map)->capacity; i++)
+			free((((*map)->hash_table)[i]).key);
+
+		for (i = 0; i < (*map)->old_capacity; i++)
+			free((((*map)->old_table)[i]).key);
+	}
+
+	free((*map)->hash_table);
+	free((*map)->old_table);
+	free(*map);
+
+	*map = NULL;
+
+	return DS_OK;
+}
+
+Status map_erase_map(HashMap **map)
+{
+	if ((*map) == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	size_t size = (*map)->capacity;
+	size_t rehash_step = (*map)->rehash_step;
+	bool track_stats = (*map)->track_stats;
+	double load_factor = (*map)->load_factor;
+	Status (*hash_function)(char *, size_t *) = (*map)->hash_function;
+	Status (*hash_function_n)(char *, size_t, size_t *) = (*map)->hash_function_n;
+
+	// The arena is kept and recycled instead of being freed
+	StringArena *arena = (*map)->arena;
+
+	(*map)->arena = NULL;
+
+	if (arena != NULL)
+	{
+		size_t i;
+		for (i = 0; i < (*map)->capacity; i++)
+			(((*map)->hash_table)[i]).key = NULL;
+
+		for (i = 0; i < (*map)->old_capacity; i++)
+			(((*map)->old_table)[i]).key = NULL;
+
+		arn_reset(arena);
+	}
+
+	Status st = map_delete_map(map);
 
-	(*entry)->key = _strdup(key);
-	(*entry)->value = value;
-	(*entry)->hash = hash;
+	if (st != DS_OK)
+		return st;
+
+	st = map_init_map(map, size, hash_function);
+
+	if (st != DS_OK)
+		return st;
 
-	(*entry)->next = NULL;
+	(*map)->load_factor = load_factor;
+	(*map)->rehash_step = rehash_step;
+	(*map)->hash_function_n = hash_function_n;
+	(*map)->arena = arena;
+	(*map)->track_stats = track_stats;
 
 	return DS_OK;
 }
 
 // +-------------------------------------------------------------------------------------------------+
-// |                                            Insertion                                            |
+// |                                             Search                                              |
 // +-------------------------------------------------------------------------------------------------+
 
-Status map_insert(HashMap *map, char *key, int value)
+// Never modifies a map that is not being rehashed incrementally and does
+// not track stats, so such maps can be searched by many readers at once
+Status map_search_hashed(HashMap *map, char *key, size_t length, size_t hash, int *value)
+{
+	*value = 0;
+
+	if (map == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (map_is_rehashing(map))
+		map_rehash_step(map);
+
+	size_t probes = 0;
+
+	HashMapEntry *found = map_lookup(map, key, length, hash, &probes);
+
+	if (map->track_stats)
+		map_stats_search(map, probes, found != NULL);
+
+	if (found == NULL)
+		return DS_ERR_NOT_FOUND;
+
+	*value = found->value;
+
+	return DS_OK;
+}
+
+static Status map_search_key(HashMap *map, char *key, size_t length, bool terminated, int *value)
+{
+	size_t hash;
+
+	Status st = map_hash_key(map, key, length, terminated, &hash);
+
+	if (st != DS_OK)
+		return st;
+
+	return map_search_hashed(map, key, length, hash, value);
+}
+
+Status map_search(HashMap *map, char *key, int *value)
+{
+	*value = 0;
+
+	if (map == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return map_search_key(map, key, strlen(key), true, value);
+}
+
+Status map_search_n(HashMap *map, char *key, size_t length, int *value)
+{
+	*value = 0;
+
+	if (map == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return map_search_key(map, key, length, false, value);
+}
+
+bool map_contains(HashMap *map, char *key)
+{
+	int value;
+
+	return map_search(map, key, &value) == DS_OK;
+}
+
+bool map_contains_n(HashMap *map, char *key, size_t length)
+{
+	int value;
+
+	return map_search_n(map, key, length, &value) == DS_OK;
+}
+
+// Searches count keys, storing their values in values and whether they were
+// found in found, which can be NULL. Keys are processed in groups of
+// HASH_MAP_BATCH: first every key is hashed and its home slot prefetched,
+// then the key of every home slot with a matching hash is prefetched and
+// only then the keys are compared, so the cache misses of a whole group
+// overlap instead of being paid one after the other. An ongoing incremental
+// rehash advances one step per key, as with map_search, taken before each
+// group so that no table changes while it is searched.
+Status map_search_batch(HashMap *map, char **keys, size_t count, int *values, bool *found)
 {
-	if (map == NULL)
+	if (map == NULL || keys == NULL || values == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	size_t hash;
-
-	Status st = map->hash_function(key, &hash);
+	Status st;
 
-	if (st != DS_OK)
-		return st;
+	size_t hashes[HASH_MAP_BATCH];
+	size_t lengths[HASH_MAP_BATCH];
 
-	size_t pos = hash % map->size;
+	HashMapEntry *slot, *entry;
 
-	if ((map->hash_table)[pos] == NULL)
+	size_t i, j, batch, probes;
+	for (i = 0; i < count; i += batch)
 	{
+		batch = count - i < HASH_MAP_BATCH ? count - i : HASH_MAP_BATCH;
 
-		st = map_make_entry(&((map->hash_table)[pos]), key, value, hash);
+		for (j = 0; j < batch && map_is_rehashing(map); j++)
+			map_rehash_step(map);
 
-		if (st != DS_OK)
-			return st;
-	}
-	else
-	{
+		for (j = 0; j < batch; j++)
+		{
+			if (keys[i + j] == NULL)
+				return DS_ERR_NULL_POINTER;
+
+			lengths[j] = strlen(keys[i + j]);
 
-		HashMapEntry *scan = (map->hash_table)[pos];
+			st = map_hash_key(map, keys[i + j], lengths[j], true, &(hashes[j]));
 
-		while (scan->next != NULL)
+			if (st != DS_OK)
+				return st;
+
+			_mm_prefetch((const char *)&((map->hash_table)[hashes[j] & (map->capacity - 1)]), _MM_HINT_T0);
+
+			if (map->old_table != NULL)
+				_mm_prefetch((const char *)&((map->old_table)[hashes[j] & (map->old_capacity - 1)]), _MM_HINT_T0);
+		}
+
+		for (j = 0; j < batch; j++)
 		{
-			scan = scan->next;
+			slot = &((map->hash_table)[hashes[j] & (map->capacity - 1)]);
+
+			if (slot->key != NULL && slot->hash == hashes[j])
+				_mm_prefetch(slot->key, _MM_HINT_T0);
 		}
 
-		HashMapEntry *entry;
+		for (j = 0; j < batch; j++)
+		{
+			probes = 0;
 
-		st = map_make_entry(&entry, key, value, hash);
+			entry = map_lookup(map, keys[i + j], lengths[j], hashes[j], &probes);
 
-		if (st != DS_OK)
-			return st;
+			if (map->track_stats)
+				map_stats_search(map, probes, entry != NULL);
 
-		scan->next = entry;
+			values[i + j] = entry != NULL ? entry->value : 0;
+
+			if (found != NULL)
+				found[i + j] = entry != NULL;
+		}
 	}
 
 	return DS_OK;
 }
 
-// +-------------------------------------------------------------------------------------------------+
-// |                                             Removal                                             |
-// +-------------------------------------------------------------------------------------------------+
+Status map_count_entries(HashMap *map, size_t *result)
+{
+	*result = 0;
 
-//Status map_remove(HashMap *map, char *key)
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
 
-// +-------------------------------------------------------------------------------------------------+
-// |                                             Display                                             |
-// +-------------------------------------------------------------------------------------------------+
+	*result = map->size;
 
-Status map_display_entry(HashMapEntry *entry)
+	return DS_OK;
+}
+
+// Entries that could not be placed in their home slot
+Status map_count_collisions(HashMap *map, size_t *result)
 {
-	if (entry == NULL)
+	*result = 0;
+
+	if (map == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	printf("\n| %21zu | %10d | %40s |", entry->hash, entry->value, entry->key);
+	size_t i;
+	for (i = 0; i < map->capacity; i++)
+		if (((map->hash_table)[i]).key != NULL)
+			if (map_probe_distance(map->capacity, ((map->hash_table)[i]).hash, i) != 0)
+				(*result)++;
+
+	for (i = 0; i < map->old_capacity; i++)
+		if (((map->old_table)[i]).key != NULL)
+			if (map_probe_distance(map->old_capacity, ((map->old_table)[i]).hash, i) != 0)
+				(*result)++;
 
 	return DS_OK;
 }
 
-Status map_display_entry_raw(HashMapEntry *entry)
+Status map_count_empty(HashMap *map, size_t *result)
 {
-	if (entry == NULL)
+	*result = 0;
+
+	if (map == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	printf("\n%21zu\t%10d\t%40s", entry->hash, entry->value, entry->key);
+	*result = map->capacity + map->old_capacity - map->size;
 
 	return DS_OK;
 }
 
-Status map_display_map(HashMap *map)
+// Longest probe sequence needed to reach an entry
+Status map_count_collisions_max(HashMap *map, size_t *result)
 {
+	*result = 0;
+
 	if (map == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	printf("\n+-------------------------------------------------------------------------------+");
-	printf("\n|                                 Hash map                                      |");
-	printf("\n+-----------------------+------------+------------------------------------------+");
-	printf("\n|         HASH          |   VALUE    |                    KEY                   |");
-
-	Status st;
-
-	size_t i;
-	for (i = 0; i < map->size; i++)
+	size_t i, total;
+	for (i = 0; i < map->capacity; i++)
 	{
 
-		printf("\n+-----------------------+------------+------------------------------------------+");
-
-		if ((map->hash_table)[i] == NULL)
-			printf("\n|         NULL          |    NULL    |                    NULL                  |");
-		else
+		if (((map->hash_table)[i]).key != NULL)
 		{
 
-			if ((map->hash_table)[i]->next != NULL)
-			{
-
-				HashMapEntry *scan = (map->hash_table)[i];
+			total = map_probe_distance(map->capacity, ((map->hash_table)[i]).hash, i) + 1;
 
-				while (scan != NULL)
-				{
-					st = map_display_entry(scan);
+			if (total > *result)
+				*result = total;
+		}
+	}
 
-					if (st != DS_OK)
-						return st;
+	for (i = 0; i < map->old_capacity; i++)
+	{
 
-					scan = scan->next;
-				}
-			}
-			else
-			{
+		if (((map->old_table)[i]).key != NULL)
+		{
 
-				st = map_display_entry((map->hash_table)[i]);
+			total = map_probe_distance(map->old_capacity, ((map->old_table)[i]).hash, i) + 1;
 
-				if (st != DS_OK)
-					return st;
-			}
+			if (total > *result)
+				*result = total;
 		}
 	}
 
-	printf("\n+-----------------------+------------+------------------------------------------+");
+	return DS_OK;
+}
 
-	printf("\n");
+// +-------------------------------------------------------------------------------------------------+
+// |                                              Stats                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+// Copies the counters of map to stats along with its current size, capacity
+// and load. Slots of a table being migrated are counted in capacity.
+Status map_stats(HashMap *map, HashMapStats *stats)
+{
+	if (map == NULL || stats == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	*stats = map->stats;
+
+	stats->size = map->size;
+	stats->capacity = map->capacity + map->old_capacity;
+	stats->load = (double)stats->size / (double)stats->capacity;
 
 	return DS_OK;
 }
 
-Status map_display_map_raw(HashMap *map)
+Status map_stats_reset(HashMap *map)
 {
 	if (map == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	Status st;
-
-	size_t i;
-	for (i = 0; i < map->size; i++)
-	{
-
-		if ((map->hash_table)[i] == NULL)
-			printf("\n");
-		else
-		{
+	// The longest probe still describes the current table
+	size_t probe_max = map->stats.probe_max;
 
-			if ((map->hash_table)[i]->next != NULL)
-			{
+	memset(&(map->stats), 0, sizeof(HashMapStats));
 
-				HashMapEntry *scan = (map->hash_table)[i];
+	map->stats.probe_max = probe_max;
 
-				while (scan != NULL)
-				{
-					st = map_display_entry_raw(scan);
+	return DS_OK;
+}
 
-					if (st != DS_OK)
-						return st;
+Status map_display_stats(HashMapStats *stats)
+{
+	if (stats == NULL)
+		return DS_ERR_NULL_POINTER;
 
-					scan = scan->next;
-				}
-			}
-			else
-			{
+	printf("\n+-------------------------------------------------------------------------------+");
+	printf("\n|                              Hash map stats                                   |");
+	printf("\n+-------------------------------------------------------------------------------+");
+	printf("\n Entries: %zu  Capacity: %zu  Load: %.3lf  Resizes: %zu", stats->size, stats->capacity, stats->load, stats->resizes);
+	printf("\n Inserts: %zu  Updates: %zu  Removes: %zu", stats->inserts, stats->updates, stats->removes);
+	printf("\n Searches: %zu  Misses: %zu  Mean probes: %.3lf  Longest probe: %zu",
+		   stats->searches, stats->misses, stats->searches ? (double)stats->probes / (double)stats->searches : 0.0, stats->probe_max);
+	printf("\n\n Probes  Searches");
 
-				st = map_display_entry_raw((map->hash_table)[i]);
+	size_t i;
+	for (i = 0; i < HASH_MAP_STATS_PROBES; i++)
+	{
+		if (stats->probe_histogram[i] == 0)
+			continue;
 
-				if (st != DS_OK)
-					return st;
-			}
-		}
+		printf("\n %5zu%s %9zu", i + 1, i == HASH_MAP_STATS_PROBES - 1 ? "+" : " ", stats->probe_histogram[i]);
 	}
 
 	printf("\n");
@@ -262,240 +1021,254 @@ Status map_display_map_raw(HashMap *map)
 }
 
 // +-------------------------------------------------------------------------------------------------+
-// |                                             Resets                                              |
+// |                                            Buffer                                               |
 // +-------------------------------------------------------------------------------------------------+
 
-Status map_delete_map(HashMap **map)
+Status map_set_load_factor(HashMap *map, double load_factor)
 {
-	if ((*map) == NULL)
+	if (map == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	size_t i;
-	for (i = 0; i < (*map)->size; i++)
-	{
-
-		if (((*map)->hash_table)[i] != NULL)
-		{
-			if ((((*map)->hash_table)[i])->next != NULL)
-			{
-
-				HashMapEntry *prev = ((*map)->hash_table)[i];
-				HashMapEntry *scan = ((*map)->hash_table)[i];
+	if (load_factor <= 0.0 || load_factor >= 1.0)
+		return DS_ERR_INVALID_ARGUMENT;
 
-				while (scan != NULL)
-				{
-					scan = scan->next;
+	map->load_factor = load_factor;
 
-					free(prev->key);
-					free(prev);
+	if ((double)map->size > (double)map->capacity * map->load_factor)
+		return map_rehash(map, map->capacity * HASH_MAP_GROW_RATE);
 
-					prev = scan;
-				}
-			}
-			else
-			{
+	return DS_OK;
+}
 
-				free((((*map)->hash_table)[i])->key);
-				free(((*map)->hash_table)[i]);
-			}
-		}
-		else
-			free(((*map)->hash_table)[i]);
-	}
+// Pairs the map hash_function with a function that hashes the same bytes
+// given their length, letting the _n functions skip copying keys. Only
+// allowed while the map is empty.
+Status map_set_hash_function_n(HashMap *map, hash_function_n_t hash_function_n)
+{
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
 
-	free((*map)->hash_table);
-	free(*map);
+	if (map->size > 0)
+		return DS_ERR_INVALID_OPERATION;
 
-	*map = NULL;
+	map->hash_function_n = hash_function_n;
 
 	return DS_OK;
 }
 
-Status map_erase_map(HashMap **map)
+Status map_set_rehash_step(HashMap *map, size_t rehash_step)
 {
-	if ((*map) == NULL)
+	if (map == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	size_t size = (*map)->size;
-	Status (*hash_function)(char *, size_t *) = (*map)->hash_function;
-
-	Status st = map_delete_map(map);
+	map->rehash_step = rehash_step;
 
-	if (st != DS_OK)
-		return st;
+	return DS_OK;
+}
 
-	st = map_init_map(map, size, hash_function);
+// Stores every key inserted from now on in a StringArena of slab_size bytes
+// per slab, 0 for STRING_ARENA_SLAB_SIZE. Only allowed while the map is empty.
+Status map_use_arena(HashMap *map, size_t slab_size)
+{
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
 
-	if (st != DS_OK)
-		return st;
+	if (map->size > 0 || map->arena != NULL)
+		return DS_ERR_INVALID_OPERATION;
 
-	return DS_OK;
+	return arn_init_arena(&(map->arena), slab_size);
 }
 
-// +-------------------------------------------------------------------------------------------------+
-// |                                             Search                                              |
-// +-------------------------------------------------------------------------------------------------+
-
-Status map_search(HashMap *map, char *key, int *value)
+// Counters are on by default. Searches update them, so a map searched by
+// several threads under a shared lock must turn them off.
+Status map_set_stats(HashMap *map, bool enabled)
 {
-	*value = 0;
-
 	if (map == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	size_t hash;
+	map->track_stats = enabled;
 
-	map->hash_function(key, &hash);
+	return DS_OK;
+}
 
-	size_t pos = hash % map->size;
+// Moves every entry to a new table with at least size slots
+Status map_rehash(HashMap *map, size_t size)
+{
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
 
-	if ((map->hash_table)[pos] == NULL)
-		return DS_ERR_NOT_FOUND;
+	Status st = map_rehash_finish(map);
 
-	if (((map->hash_table)[pos])->next == NULL && ((map->hash_table)[pos])->hash == hash)
-		*value = ((map->hash_table)[pos])->value;
-	else
-	{
+	if (st != DS_OK)
+		return st;
 
-		HashMapEntry *scan = (map->hash_table)[pos];
+	size_t capacity = HASH_MAP_INIT_SIZE;
 
-		bool found = false;
+	while (capacity < size || (double)map->size > (double)capacity * map->load_factor)
+		capacity *= HASH_MAP_GROW_RATE;
 
-		while (scan != NULL)
-		{
-			if (scan->hash == hash)
-			{
+	HashMapEntry *new_table = calloc(capacity, sizeof(HashMapEntry));
 
-				*value = scan->value;
+	if (!new_table)
+		return DS_ERR_ALLOC;
 
-				found = true;
+	HashMapEntry *old_table = map->hash_table;
+	size_t old_capacity = map->capacity;
 
-				break;
-			}
+	map->hash_table = new_table;
+	map->capacity = capacity;
 
-			scan = scan->next;
-		}
+	map_stats_resize(map);
 
-		if (!found)
-			return DS_ERR_NOT_FOUND;
+	size_t i;
+	for (i = 0; i < old_capacity; i++)
+	{
+		if (old_table[i].key != NULL)
+			map_stats_place(map, map_place(map->hash_table, map->capacity, old_table[i]));
 	}
 
+	free(old_table);
+
 	return DS_OK;
 }
 
-//Status map_search_all(HashMap *map, char *key, int **value)
-
-Status map_count_entries(HashMap *map, size_t *result)
+// Allocates a new table with at least size slots and leaves the current one
+// to be migrated by map_rehash_step
+Status map_rehash_start(HashMap *map, size_t size)
 {
-	*result = 0;
-
 	if (map == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	size_t i;
-	for (i = 0; i < map->size; i++)
-	{
+	// Only two tables are kept at a time
+	Status st = map_rehash_finish(map);
 
-		if ((map->hash_table)[i] != NULL)
-		{
+	if (st != DS_OK)
+		return st;
 
-			if (((map->hash_table)[i])->next != NULL)
-			{
+	size_t capacity = HASH_MAP_INIT_SIZE;
 
-				HashMapEntry *scan = (map->hash_table)[i];
+	while (capacity < size || (double)map->size > (double)capacity * map->load_factor)
+		capacity *= HASH_MAP_GROW_RATE;
 
-				while (scan != NULL)
-				{
-					(*result)++;
+	HashMapEntry *new_table = calloc(capacity, sizeof(HashMapEntry));
 
-					scan = scan->next;
-				}
-			}
-			else
-			{
+	if (!new_table)
+		return DS_ERR_ALLOC;
 
-				(*result)++;
-			}
-		}
-	}
+	map->old_table = map->hash_table;
+	map->old_capacity = map->capacity;
 
-	return DS_OK;
-}
+	map->hash_table = new_table;
+	map->capacity = capacity;
 
-Status map_count_collisions(HashMap *map, size_t *result)
-{
-	*result = 0;
+	map_stats_resize(map);
 
-	if (map == NULL)
-		return DS_ERR_NULL_POINTER;
+	// Migration must start at the beginning of a cluster, right after an
+	// empty slot. There is always one since the load factor is below 1.
+	size_t i = 0;
+	while ((map->old_table)[i].key != NULL)
+		i++;
 
-	size_t i;
-	for (i = 0; i < map->size; i++)
-		if ((map->hash_table)[i] != NULL)
-			if (((map->hash_table)[i])->next != NULL)
-				(*result)++;
+	map->rehash_index = i;
+	map->rehash_left = map->old_capacity;
 
 	return DS_OK;
 }
 
-Status map_count_empty(HashMap *map, size_t *result)
+// Migrates at least rehash_step slots of the old table, always stopping at
+// the end of a cluster so the entries left behind can still be found by
+// linear probing. A map that rehashes at once still moves a fixed amount of
+// slots when a migration is started by hand.
+Status map_rehash_step(HashMap *map)
 {
-	*result = 0;
-
 	if (map == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	size_t i;
-	for (i = 0; i < map->size; i++)
-		if ((map->hash_table)[i] == NULL)
-			(*result)++;
-
-	return DS_OK;
-}
+	if (!map_is_rehashing(map))
+		return DS_OK;
 
-Status map_count_collisions_max(HashMap *map, size_t *result)
-{
-	*result = 0;
+	size_t mask = map->old_capacity - 1;
+	size_t step = map->rehash_step > 0 ? map->rehash_step : HASH_MAP_REHASH_STEP;
+	size_t visited = 0;
 
-	if (map == NULL)
-		return DS_ERR_NULL_POINTER;
+	HashMapEntry *slot;
 
-	size_t i, total;
-	for (i = 0; i < map->size; i++)
+	while (map->rehash_left > 0)
 	{
+		slot = &((map->old_table)[map->rehash_index]);
 
-		if ((map->hash_table)[i] != NULL)
+		if (slot->key == NULL && visited >= step)
+			break;
+
+		if (slot->key != NULL)
 		{
+			map_stats_place(map, map_place(map->hash_table, map->capacity, *slot));
 
-			if (((map->hash_table)[i])->next != NULL)
-			{
+			slot->key = NULL;
+		}
 
-				total = 0;
+		map->rehash_index = (map->rehash_index + 1) & mask;
 
-				HashMapEntry *scan = (map->hash_table)[i];
+		(map->rehash_left)--;
 
-				while (scan != NULL)
-				{
-					total++;
+		visited++;
+	}
 
-					scan = scan->next;
-				}
-			}
-			else
-				total = 1;
+	if (map->rehash_left == 0)
+	{
+		free(map->old_table);
 
-			if (total > *result)
-				*result = total;
-		}
+		map->old_table = NULL;
+		map->old_capacity = 0;
+		map->rehash_index = 0;
 	}
 
 	return DS_OK;
 }
 
+// Completes an ongoing incremental rehash
+Status map_rehash_finish(HashMap *map)
+{
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	size_t rehash_step = map->rehash_step;
+
+	map->rehash_step = SIZE_MAX;
+
+	Status st = map_rehash_step(map);
+
+	map->rehash_step = rehash_step;
+
+	return st;
+}
+
+bool map_is_rehashing(HashMap *map)
+{
+	return map->old_table != NULL;
+}
+
 // +-------------------------------------------------------------------------------------------------+
 // |                                             Hash                                                |
 // +-------------------------------------------------------------------------------------------------+
 
+// Length aware version of the built-in functions or NULL if not known
+hash_function_n_t map_hash_length_variant(hash_function_t hash_function)
+{
+	if (hash_function == map_hash_java)
+		return map_hash_java_n;
+	if (hash_function == map_hash_djb2)
+		return map_hash_djb2_n;
+	if (hash_function == map_hash_sdbm)
+		return map_hash_sdbm_n;
+	if (hash_function == hash_wyhash)
+		return hash_wyhash_n;
+	if (hash_function == hash_xxh3)
+		return hash_xxh3_n;
+
+	return NULL;
+}
+
 Status map_hash_java(char *key, size_t *hash)
 {
 	size_t len = strlen(key);
@@ -535,3 +1308,36 @@ Status map_hash_sdbm(char *key, size_t *hash)
 
 	return DS_OK;
 }
+
+Status map_hash_java_n(char *key, size_t length, size_t *hash)
+{
+	*hash = 0;
+
+	size_t i;
+	for (i = 0; i < length; i++)
+		(*hash) += (size_t)pow((double)(key[i] * 31), (double)(length - i));
+
+	return DS_OK;
+}
+
+Status map_hash_djb2_n(char *key, size_t length, size_t *hash)
+{
+	*hash = 5381;
+
+	size_t i;
+	for (i = 0; i < length; i++)
+		(*hash) = (((*hash) << 5) + (*hash)) + key[i];
+
+	return DS_OK;
+}
+
+Status map_hash_sdbm_n(char *key, size_t length, size_t *hash)
+{
+	*hash = 0;
+
+	size_t i;
+	for (i = 0; i < length; i++)
+		(*hash) = key[i] + (((*hash) << 6) + ((*hash) << 16)) - (*hash);
+
+	return DS_OK;
+}
\ No newline at end of file
@@ -8,43 +8,62 @@
  *
  */
 
+#include <Windows.h>
 #include "HashSet.h"
+#include "HashFunctions.h"
+
+#define HASH_SET_KEY_BUFFER 256
+
 
 // +-------------------------------------------------------------------------------------------------+
 // |                                          Initializers                                           |
 // +-------------------------------------------------------------------------------------------------+
 
-Status set_init_set(HashSet **set, size_t max_size, hash_function_t hash_function, rehash_function_t rehash_function)
+// Creates a set with room for at least size elements before it first grows
+Status set_init_set(HashSet **set, size_t size, hash_function_t hash_function, rehash_function_t rehash_function)
 {
-	if (max_size == 0)
+	if (size == 0)
 		return DS_ERR_INVALID_SIZE;
 
 	if (hash_function == NULL)
 		return DS_ERR_INVALID_ARGUMENT;
 
+	size_t capacity = HASH_SET_INIT_SIZE;
+
+	while ((double)size > (double)capacity * HASH_SET_LOAD_FACTOR)
+		capacity *= HASH_SET_GROW_RATE;
+
 	*set = malloc(sizeof(HashSet));
 
 	if (!(*set))
 		return DS_ERR_ALLOC;
 
-	(*set)->hash_table = malloc(sizeof(HashSetEntry *) * max_size);
+	(*set)->hash_table = calloc(capacity, sizeof(HashSetEntry));
+	(*set)->metadata = malloc(capacity);
 
-	if (!((*set)->hash_table))
-		return DS_ERR_ALLOC;
-
-	size_t i;
-	for (i = 0; i < max_size; i++)
+	if (!((*set)->hash_table) || !((*set)->metadata))
 	{
+		free((*set)->hash_table);
+		free((*set)->metadata);
+		free(*set);
+
+		*set = NULL;
 
-		((*set)->hash_table)[i] = NULL;
+		return DS_ERR_ALLOC;
 	}
 
+	memset((*set)->metadata, HASH_SET_EMPTY, capacity);
+
 	(*set)->size = 0;
-	(*set)->max_size = max_size;
+	(*set)->capacity = capacity;
+	(*set)->load_factor = HASH_SET_LOAD_FACTOR;
 
 	(*set)->hash_function = hash_function;
+	(*set)->hash_function_n = set_hash_length_variant(hash_function);
 	(*set)->rehash_function = rehash_function;
 
+	(*set)->arena = NULL;
+
 	return DS_OK;
 }
 
@@ -57,6 +76,7 @@ Status set_init_entry(HashSetEntry **entry, char *value)
 
 	(*entry)->value = _strdup(value);
 	(*entry)->hash = 0;
+	(*entry)->length = strlen(value);
 
 	return DS_OK;
 }
@@ -65,206 +85,352 @@ Status set_init_entry(HashSetEntry **entry, char *value)
 // |                                            Getters                                              |
 // +-------------------------------------------------------------------------------------------------+
 
-Status set_make_entry(HashSetEntry **entry, char *value, size_t hash)
+Status set_make_entry(HashSetEntry **entry, char *value, size_t length, size_t hash)
 {
 	*entry = malloc(sizeof(HashSetEntry));
 
 	if (!(*entry))
 		return DS_ERR_ALLOC;
 
-	(*entry)->value = _strdup(value);
+	(*entry)->value = malloc(length + 1);
+
+	if (!((*entry)->value))
+	{
+		free(*entry);
+
+		*entry = NULL;
+
+		return DS_ERR_ALLOC;
+	}
+
+	memcpy((*entry)->value, value, length);
+	(*entry)->value[length] = '\0';
+
 	(*entry)->hash = hash;
+	(*entry)->length = length;
 
 	return DS_OK;
 }
 
-// +-------------------------------------------------------------------------------------------------+
-// |                                            Insertion                                            |
-// +-------------------------------------------------------------------------------------------------+
+// Copies length bytes of value to a new NUL terminated key, bump allocated
+// from the set arena in arena mode
+static Status set_new_key(HashSet *set, char *value, size_t length, char **key)
+{
+	if (set->arena != NULL)
+		return arn_strndup(set->arena, value, length, key);
 
-Status set_insert(HashSet *set, char *value)
+	*key = malloc(length + 1);
+
+	if (!(*key))
+		return DS_ERR_ALLOC;
+
+	memcpy(*key, value, length);
+	(*key)[length] = '\0';
+
+	return DS_OK;
+}
+
+// Arena keys are only released with the whole set
+static void set_free_key(HashSet *set, char *key)
 {
-	if (set == NULL)
-		return DS_ERR_NULL_POINTER;
+	if (set->arena == NULL)
+		free(key);
+}
 
-	if (set_is_full(set))
-		return DS_ERR_FULL;
+// Whether a slot holds an element
+static bool set_slot_used(HashSet *set, size_t pos)
+{
+	return set->metadata[pos] != HASH_SET_EMPTY;
+}
 
-	size_t hash;
+// Rejects on hash and length before comparing any bytes
+static bool set_entry_matches(HashSetEntry *entry, char *value, size_t length, size_t hash)
+{
+	return entry->hash == hash && entry->length == length && memcmp(entry->value, value, length) == 0;
+}
 
-	Status st = set->hash_function(value, &hash);
+// Slot where the probe sequence of hash starts. The rehashed value is mixed
+// into the hash rather than replacing it, as rehash functions written as a
+// probe step, like set_rehash_prime, only return a handful of values.
+static size_t set_home(HashSet *set, size_t hash)
+{
+	size_t mixed = hash;
 
-	if (st != DS_OK)
-		return st;
+	if (set->rehash_function != NULL)
+	{
+		set->rehash_function(&mixed);
+
+		hash ^= mixed;
+	}
+
+	return hash & (set->capacity - 1);
+}
 
-	size_t pos = hash % set->max_size;
+// Metadata of an element with the given hash at dist slots from its home:
+// the top bits of its hash and its distance plus one, saturated
+static uint8_t set_metadata(size_t hash, size_t dist)
+{
+	uint8_t tag = (uint8_t)((hash >> (sizeof(size_t) * 8 - 4)) << 4);
+
+	return tag | (dist + 1 < HASH_SET_DISTANCE_MAX ? (uint8_t)(dist + 1) : HASH_SET_DISTANCE_MAX);
+}
+
+// Distance of the element at pos from its home. Only elements too far to
+// be recorded in the metadata need their home slot computed again.
+static size_t set_distance(HashSet *set, size_t pos)
+{
+	uint8_t dist = set->metadata[pos] & HASH_SET_DISTANCE_MAX;
+
+	if (dist < HASH_SET_DISTANCE_MAX)
+		return (size_t)dist - 1;
+
+	return (pos - set_home(set, (set->hash_table)[pos].hash)) & (set->capacity - 1);
+}
 
-	if ((set->hash_table)[pos] == NULL)
+// Returns the slot holding value or SIZE_MAX if it is not in the set. Robin
+// Hood placement keeps elements with the same home together and ordered by
+// distance, so the search stops at the first element that is closer to its
+// home than value would be. Only slots whose metadata is exactly what value
+// would have there are read, which skips most elements with the same home.
+static size_t set_find(HashSet *set, char *value, size_t length, size_t hash)
+{
+	size_t mask = set->capacity - 1;
+	size_t pos = set_home(set, hash);
+	size_t dist = 0, slot_dist;
+
+	uint8_t meta, expected;
+
+	while (true)
 	{
+		meta = set->metadata[pos];
+		expected = set_metadata(hash, dist);
 
-		st = set_make_entry(&((set->hash_table)[pos]), value, hash);
+		if ((meta & HASH_SET_DISTANCE_MAX) < (expected & HASH_SET_DISTANCE_MAX))
+			return SIZE_MAX;
 
-		if (st != DS_OK)
-			return st;
+		if ((meta & HASH_SET_DISTANCE_MAX) == HASH_SET_DISTANCE_MAX)
+		{
+			slot_dist = set_distance(set, pos);
+
+			if (slot_dist < dist)
+				return SIZE_MAX;
+
+			if (slot_dist == dist && meta == expected && set_entry_matches(&((set->hash_table)[pos]), value, length, hash))
+				return pos;
+		}
+		else if (meta == expected && set_entry_matches(&((set->hash_table)[pos]), value, length, hash))
+			return pos;
+
+		pos = (pos + 1) & mask;
 
-		(set->size)++;
+		dist++;
 	}
-	else
-	{
+}
+
+// Places an element known not to be in the set. An element that is farther
+// from its home takes the slot of one that is closer to its own, which then
+// continues probing in its place.
+static void set_place(HashSet *set, HashSetEntry entry)
+{
+	size_t mask = set->capacity - 1;
+	size_t pos = set_home(set, entry.hash);
+	size_t dist = 0, slot_dist;
 
-		if (((set->hash_table)[pos])->hash == hash)
-			return DS_OK;
+	HashSetEntry temp;
 
-		bool found = false;
+	while (set_slot_used(set, pos))
+	{
+		slot_dist = set_distance(set, pos);
 
-		size_t i, rehash = hash;
-		for (i = 1; i <= 10; i++)
+		if (slot_dist < dist)
 		{
+			temp = (set->hash_table)[pos];
+			(set->hash_table)[pos] = entry;
 
-			st = set->rehash_function(&rehash);
+			set->metadata[pos] = set_metadata(entry.hash, dist);
 
-			if (st != DS_OK)
-				return st;
+			entry = temp;
 
-			pos = (hash + i * rehash) % set->max_size;
+			dist = slot_dist;
+		}
 
-			if ((set->hash_table)[pos] == NULL)
-			{
+		pos = (pos + 1) & mask;
 
-				st = set_make_entry(&((set->hash_table)[pos]), value, hash);
+		dist++;
+	}
 
-				if (st != DS_OK)
-					return st;
+	(set->hash_table)[pos] = entry;
+	set->metadata[pos] = set_metadata(entry.hash, dist);
+}
 
-				(set->size)++;
+// Backward shift deletion: the following elements of the cluster move one
+// slot closer to their home until an empty slot or an element already at
+// its home is found, so no tombstone is left behind
+static void set_erase_at(HashSet *set, size_t pos)
+{
+	size_t mask = set->capacity - 1;
+	size_t next = (pos + 1) & mask;
+	size_t dist;
 
-				found = true;
+	while (set_slot_used(set, next) && (dist = set_distance(set, next)) != 0)
+	{
+		(set->hash_table)[pos] = (set->hash_table)[next];
+		set->metadata[pos] = set_metadata((set->hash_table)[pos].hash, dist - 1);
 
-				break;
-			}
-			else if (((set->hash_table)[pos])->hash == hash)
-				return DS_OK;
-		}
+		pos = next;
+		next = (next + 1) & mask;
+	}
 
-		if (!found)
-		{
+	(set->hash_table)[pos].value = NULL;
+	(set->hash_table)[pos].hash = 0;
+	(set->hash_table)[pos].length = 0;
 
-			while (!found)
-			{
-				pos++;
+	set->metadata[pos] = HASH_SET_EMPTY;
+}
 
-				if ((set->hash_table)[pos % set->max_size] == NULL)
-				{
+// Hashes length bytes of value. When the set only has a hash_function_t and
+// value is not known to be NUL terminated it is copied to a terminated buffer.
+static Status set_hash_key(HashSet *set, char *value, size_t length, bool terminated, size_t *hash)
+{
+	if (set->hash_function_n != NULL)
+		return set->hash_function_n(value, length, hash);
 
-					st = set_make_entry(&((set->hash_table)[pos % set->max_size]), value, hash);
+	if (terminated)
+		return set->hash_function(value, hash);
 
-					if (st != DS_OK)
-						return st;
+	char small[HASH_SET_KEY_BUFFER];
+	char *buffer = small;
 
-					(set->size)++;
+	if (length >= HASH_SET_KEY_BUFFER)
+	{
+		buffer = malloc(length + 1);
 
-					found = true;
-				}
-				else if (((set->hash_table)[pos % set->max_size])->hash == hash)
-					return DS_OK;
-			}
-		}
+		if (!buffer)
+			return DS_ERR_ALLOC;
 	}
 
-	return DS_OK;
+	memcpy(buffer, value, length);
+	buffer[length] = '\0';
+
+	Status st = set->hash_function(buffer, hash);
+
+	if (buffer != small)
+		free(buffer);
+
+	return st;
 }
 
 // +-------------------------------------------------------------------------------------------------+
-// |                                             Removal                                             |
+// |                                            Insertion                                            |
 // +-------------------------------------------------------------------------------------------------+
 
-Status set_remove(HashSet *set, char *value)
+// Adds an element already known not to be in the set
+static Status set_add(HashSet *set, char *value, size_t length, size_t hash)
 {
-	if (set_is_empty(set))
-		return DS_ERR_INVALID_OPERATION;
+	Status st;
 
-	if (!set_exists(set, value))
-		return DS_ERR_NOT_FOUND;
+	if ((double)(set->size + 1) > (double)set->capacity * set->load_factor)
+	{
+		st = set_rehash(set, set->capacity * HASH_SET_GROW_RATE);
 
-	size_t hash;
+		if (st != DS_OK)
+			return st;
+	}
+
+	HashSetEntry entry;
 
-	Status st = set->hash_function(value, &hash);
+	st = set_new_key(set, value, length, &(entry.value));
 
 	if (st != DS_OK)
 		return st;
 
-	size_t pos = hash % set->max_size;
-
-	if ((set->hash_table)[pos] != NULL)
-	{
+	entry.hash = hash;
+	entry.length = length;
 
-		if (((set->hash_table)[pos])->hash == hash)
-		{
+	set_place(set, entry);
 
-			free((set->hash_table)[pos]);
-			(set->hash_table)[pos] = NULL;
+	(set->size)++;
 
-			(set->size)--;
-		}
-		else
-		{
+	return DS_OK;
+}
 
-			bool found = false;
+static Status set_insert_key(HashSet *set, char *value, size_t length, bool terminated)
+{
+	size_t hash;
 
-			size_t i, rehash = hash;
+	Status st = set_hash_key(set, value, length, terminated, &hash);
 
-			for (i = 0; i < 10; i++)
-			{
+	if (st != DS_OK)
+		return st;
 
-				st = set->rehash_function(&rehash);
+	if (set_find(set, value, length, hash) != SIZE_MAX)
+		return DS_OK;
 
-				if (st != DS_OK)
-					return st;
+	return set_add(set, value, length, hash);
+}
 
-				pos = (hash + i * rehash) % set->max_size;
+Status set_insert(HashSet *set, char *value)
+{
+	if (set == NULL || value == NULL)
+		return DS_ERR_NULL_POINTER;
 
-				if ((set->hash_table)[pos] != NULL)
-				{
+	return set_insert_key(set, value, strlen(value), true);
+}
 
-					if (((set->hash_table)[pos])->hash == hash)
-					{
+Status set_insert_n(HashSet *set, char *value, size_t length)
+{
+	if (set == NULL || value == NULL)
+		return DS_ERR_NULL_POINTER;
 
-						free((set->hash_table)[pos]);
-						(set->hash_table)[pos] = NULL;
+	return set_insert_key(set, value, length, false);
+}
 
-						(set->size)--;
-					}
-				}
-			}
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Removal                                             |
+// +-------------------------------------------------------------------------------------------------+
 
-			if (!found)
-			{
+static Status set_remove_key(HashSet *set, char *value, size_t length, bool terminated)
+{
+	if (set_is_empty(set))
+		return DS_ERR_INVALID_OPERATION;
 
-				for (i = 0; i < set->max_size; i++, pos++)
-				{
+	size_t hash;
 
-					if ((set->hash_table)[pos % set->max_size] != NULL)
-					{
+	Status st = set_hash_key(set, value, length, terminated, &hash);
 
-						if (((set->hash_table)[pos % set->max_size])->hash == hash)
-						{
+	if (st != DS_OK)
+		return st;
 
-							free((set->hash_table)[pos % set->max_size]);
-							(set->hash_table)[pos % set->max_size] = NULL;
+	size_t pos = set_find(set, value, length, hash);
 
-							(set->size)--;
-						}
-					}
-				}
-			}
-		}
-	}
-	else
+	if (pos == SIZE_MAX)
 		return DS_ERR_NOT_FOUND;
 
+	set_free_key(set, (set->hash_table)[pos].value);
+
+	set_erase_at(set, pos);
+
+	(set->size)--;
+
 	return DS_OK;
 }
 
+Status set_remove(HashSet *set, char *value)
+{
+	if (set == NULL || value == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return set_remove_key(set, value, strlen(value), true);
+}
+
+Status set_remove_n(HashSet *set, char *value, size_t length)
+{
+	if (set == NULL || value == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return set_remove_key(set, value, length, false);
+}
+
 // +-------------------------------------------------------------------------------------------------+
 // |                                             Display                                             |
 // +-------------------------------------------------------------------------------------------------+
@@ -302,17 +468,17 @@ Status set_display_set(HashSet *set)
 	Status st;
 
 	size_t i;
-	for (i = 0; i < set->max_size; i++)
+	for (i = 0; i < set->capacity; i++)
 	{
 
 		printf("\n+-----------------------+------------------------------------------------------+");
 
-		if ((set->hash_table)[i] == NULL)
+		if (set->metadata[i] == HASH_SET_EMPTY)
 			printf("\n|         NULL          |                           NULL                       |");
 		else
 		{
 
-			st = set_display_entry((set->hash_table)[i]);
+			st = set_display_entry(&((set->hash_table)[i]));
 
 			if (st != DS_OK)
 				return st;
@@ -336,15 +502,15 @@ Status set_display_set_raw(HashSet *set)
 	Status st;
 
 	size_t i;
-	for (i = 0; i < set->max_size; i++)
+	for (i = 0; i < set->capacity; i++)
 	{
 
-		if ((set->hash_table)[i] == NULL)
+		if (!set_slot_used(set, i))
 			printf("\n");
 		else
 		{
 
-			st = set_display_entry_raw((set->hash_table)[i]);
+			st = set_display_entry_raw(&((set->hash_table)[i]));
 
 			if (st != DS_OK)
 				return st;
@@ -371,11 +537,11 @@ Status set_display_elements(HashSet *set)
 		printf("( ");
 
 		size_t i;
-		for (i = 0; i < set->max_size; i++)
+		for (i = 0; i < set->capacity; i++)
 		{
 
-			if ((set->hash_table)[i] != NULL)
-				printf("< %s > ", ((set->hash_table)[i])->value);
+			if (set_slot_used(set, i))
+				printf("< %s > ", (set->hash_table)[i].value);
 		}
 
 		printf(")");
@@ -394,16 +560,17 @@ Status set_delete_set(HashSet **set)
 		return DS_ERR_NULL_POINTER;
 
 	size_t i;
-	for (i = 0; i < (*set)->max_size; i++)
-	{
 
-		if (((*set)->hash_table)[i] != NULL)
-			free((((*set)->hash_table)[i])->value);
-
-		free(((*set)->hash_table)[i]);
+	if ((*set)->arena != NULL)
+		arn_delete_arena(&((*set)->arena));
+	else
+	{
+		for (i = 0; i < (*set)->capacity; i++)
+			free(((*set)->hash_table)[i].value);
 	}
 
 	free((*set)->hash_table);
+	free((*set)->metadata);
 	free(*set);
 
 	*set = NULL;
@@ -416,123 +583,164 @@ Status set_erase_set(HashSet **set)
 	if ((*set) == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	size_t size = (*set)->max_size;
+	size_t capacity = (*set)->capacity;
+	double load_factor = (*set)->load_factor;
 	Status (*hash_function)(char *, size_t *) = (*set)->hash_function;
+	Status (*hash_function_n)(char *, size_t, size_t *) = (*set)->hash_function_n;
 	Status (*rehash_function)(size_t *) = (*set)->rehash_function;
 
+	// The arena is kept and recycled instead of being freed
+	StringArena *arena = (*set)->arena;
+
+	if (arena != NULL)
+	{
+		size_t i;
+		for (i = 0; i < capacity; i++)
+			((*set)->hash_table)[i].value = NULL;
+
+		(*set)->arena = NULL;
+
+		arn_reset(arena);
+	}
+
 	Status st = set_delete_set(set);
 
 	if (st != DS_OK)
 		return st;
 
-	st = set_init_set(set, size, hash_function, rehash_function);
+	st = set_init_set(set, 1, hash_function, rehash_function);
 
 	if (st != DS_OK)
 		return st;
 
-	return DS_OK;
-}
-
-// +-------------------------------------------------------------------------------------------------+
-// |                                             Search                                              |
-// +-------------------------------------------------------------------------------------------------+
+	(*set)->load_factor = load_factor;
+	(*set)->hash_function_n = hash_function_n;
+	(*set)->arena = arena;
 
-bool set_is_full(HashSet *set)
-{
-	return (set->max_size == set->size);
+	// Keeps the capacity it had
+	return set_rehash(*set, capacity);
 }
 
-bool set_is_empty(HashSet *set)
+Status set_set_load_factor(HashSet *set, double load_factor)
 {
-	return (set->size == 0);
+	if (set == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (load_factor <= 0.0 || load_factor >= 1.0)
+		return DS_ERR_INVALID_ARGUMENT;
+
+	set->load_factor = load_factor;
+
+	if ((double)set->size > (double)set->capacity * set->load_factor)
+		return set_rehash(set, set->capacity);
+
+	return DS_OK;
 }
 
-Status set_contains(HashSet *set, char *value, bool *result)
+// Pairs the set hash_function with a function that hashes the same bytes
+// given their length. Only allowed while the set is empty.
+Status set_set_hash_function_n(HashSet *set, hash_function_n_t hash_function_n)
 {
-	*result = false;
-
 	if (set == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	if (set_is_empty(set))
-		return DS_OK;
-
-	size_t hash;
-
-	Status st = set->hash_function(value, &hash);
+	if (!set_is_empty(set))
+		return DS_ERR_INVALID_OPERATION;
 
-	if (st != DS_OK)
-		return st;
+	set->hash_function_n = hash_function_n;
 
-	size_t pos = hash % set->max_size;
+	return DS_OK;
+}
 
-	if ((set->hash_table)[pos] != NULL)
-	{
+// Stores the key of every element inserted from now on in a StringArena of
+// slab_size bytes per slab, 0 for STRING_ARENA_SLAB_SIZE. Entries are slots
+// of the table either way. Only allowed while the set is empty.
+Status set_use_arena(HashSet *set, size_t slab_size)
+{
+	if (set == NULL)
+		return DS_ERR_NULL_POINTER;
 
-		if (((set->hash_table)[pos])->hash == hash)
-			*result = true;
-		else
-		{
+	if (!set_is_empty(set) || set->arena != NULL)
+		return DS_ERR_INVALID_OPERATION;
 
-			bool found = false;
+	return arn_init_arena(&(set->arena), slab_size);
+}
 
-			size_t i, rehash = hash;
+// Moves every element to a new table with at least size slots. The table
+// is made larger if size slots can not hold every element under the load
+// factor.
+Status set_rehash(HashSet *set, size_t size)
+{
+	if (set == NULL)
+		return DS_ERR_NULL_POINTER;
 
-			for (i = 0; i < 10; i++)
-			{
+	size_t capacity = HASH_SET_INIT_SIZE;
 
-				st = set->rehash_function(&rehash);
+	while (capacity < size || (double)set->size > (double)capacity * set->load_factor)
+		capacity *= HASH_SET_GROW_RATE;
 
-				if (st != DS_OK)
-					return st;
+	HashSetEntry *new_table = calloc(capacity, sizeof(HashSetEntry));
+	uint8_t *new_metadata = malloc(capacity);
 
-				pos = (hash + i * rehash) % set->max_size;
+	if (!new_table || !new_metadata)
+	{
+		free(new_table);
+		free(new_metadata);
 
-				if ((set->hash_table)[pos] != NULL)
-				{
+		return DS_ERR_ALLOC;
+	}
 
-					if (((set->hash_table)[pos])->hash == hash)
-					{
+	memset(new_metadata, HASH_SET_EMPTY, capacity);
 
-						*result = true;
+	HashSetEntry *old_table = set->hash_table;
+	uint8_t *old_metadata = set->metadata;
+	size_t old_capacity = set->capacity;
 
-						found = true;
+	set->hash_table = new_table;
+	set->metadata = new_metadata;
+	set->capacity = capacity;
 
-						break;
-					}
-				}
-			}
+	size_t i;
+	for (i = 0; i < old_capacity; i++)
+	{
+		if (old_metadata[i] != HASH_SET_EMPTY)
+			set_place(set, old_table[i]);
+	}
 
-			if (!found)
-			{
+	free(old_table);
+	free(old_metadata);
 
-				for (i = 0; i < set->max_size; i++, pos++)
-				{
+	return DS_OK;
+}
 
-					if ((set->hash_table)[pos % set->max_size] != NULL)
-					{
+// Makes room for at least size elements before the set grows again
+Status set_reserve(HashSet *set, size_t size)
+{
+	if (set == NULL)
+		return DS_ERR_NULL_POINTER;
 
-						if (((set->hash_table)[pos % set->max_size])->hash == hash)
-						{
+	if ((double)size <= (double)set->capacity * set->load_factor)
+		return DS_OK;
 
-							*result = true;
+	return set_rehash(set, (size_t)((double)size / set->load_factor) + 1);
+}
 
-							found = true;
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Search                                              |
+// +-------------------------------------------------------------------------------------------------+
 
-							break;
-						}
-					}
-				}
-			}
-		}
-	}
-	else
-		*result = false;
+// A set grows as needed, so this only holds if every slot is an element
+bool set_is_full(HashSet *set)
+{
+	return (set->capacity == set->size);
+}
 
-	return DS_OK;
+bool set_is_empty(HashSet *set)
+{
+	return (set->size == 0);
 }
 
-bool set_exists(HashSet *set, char *value)
+static bool set_exists_key(HashSet *set, char *value, size_t length, bool terminated)
 {
 	if (set == NULL)
 		return false;
@@ -542,63 +750,68 @@ bool set_exists(HashSet *set, char *value)
 
 	size_t hash;
 
-	Status st = set->hash_function(value, &hash);
+	if (set_hash_key(set, value, length, terminated, &hash) != DS_OK)
+		return false;
 
-	if (st != DS_OK)
-		return st;
+	return set_find(set, value, length, hash) != SIZE_MAX;
+}
 
-	size_t pos = hash % set->max_size;
+static Status set_contains_key(HashSet *set, char *value, size_t length, bool terminated, bool *result)
+{
+	*result = false;
 
-	if ((set->hash_table)[pos] != NULL)
-	{
+	if (set == NULL)
+		return DS_ERR_NULL_POINTER;
 
-		if (((set->hash_table)[pos])->hash == hash)
-			return true;
-		else
-		{
+	if (set_is_empty(set))
+		return DS_OK;
 
-			size_t i, rehash = hash;
+	size_t hash;
 
-			for (i = 0; i < 10; i++)
-			{
+	Status st = set_hash_key(set, value, length, terminated, &hash);
 
-				st = set->rehash_function(&rehash);
+	if (st != DS_OK)
+		return st;
 
-				if (st != DS_OK)
-					return st;
+	*result = set_find(set, value, length, hash) != SIZE_MAX;
 
-				pos = (hash + i * rehash) % set->max_size;
+	return DS_OK;
+}
 
-				if ((set->hash_table)[pos] != NULL)
-				{
+Status set_contains(HashSet *set, char *value, bool *result)
+{
+	*result = false;
 
-					if (((set->hash_table)[pos])->hash == hash)
-					{
+	if (value == NULL)
+		return DS_ERR_NULL_POINTER;
 
-						return true;
-					}
-				}
-			}
+	return set_contains_key(set, value, strlen(value), true, result);
+}
 
-			for (i = 0; i < set->max_size; i++, pos++)
-			{
+Status set_contains_n(HashSet *set, char *value, size_t length, bool *result)
+{
+	*result = false;
 
-				if ((set->hash_table)[pos % set->max_size] != NULL)
-				{
+	if (value == NULL)
+		return DS_ERR_NULL_POINTER;
 
-					if (((set->hash_table)[pos % set->max_size])->hash == hash)
-					{
+	return set_contains_key(set, value, length, false, result);
+}
 
-						return true;
-					}
-				}
-			}
-		}
-	}
-	else
+bool set_exists(HashSet *set, char *value)
+{
+	if (value == NULL)
 		return false;
 
-	return false;
+	return set_exists_key(set, value, strlen(value), true);
+}
+
+bool set_exists_n(HashSet *set, char *value, size_t length)
+{
+	if (value == NULL)
+		return false;
+
+	return set_exists_key(set, value, length, false);
 }
 
 Status set_count_elements(HashSet *set, size_t *result)
@@ -609,10 +822,10 @@ Status set_count_elements(HashSet *set, size_t *result)
 		return DS_ERR_NULL_POINTER;
 
 	size_t i;
-	for (i = 0; i < set->max_size; i++)
+	for (i = 0; i < set->capacity; i++)
 	{
 
-		if ((set->hash_table)[i] != NULL)
+		if (set_slot_used(set, i))
 			(*result)++;
 	}
 
@@ -627,10 +840,10 @@ Status set_count_empty(HashSet *set, size_t *result)
 		return DS_ERR_NULL_POINTER;
 
 	size_t i;
-	for (i = 0; i < set->max_size; i++)
+	for (i = 0; i < set->capacity; i++)
 	{
 
-		if ((set->hash_table)[i] == NULL)
+		if (set->metadata[i] == HASH_SET_EMPTY)
 			(*result)++;
 	}
 
@@ -641,50 +854,149 @@ Status set_count_empty(HashSet *set, size_t *result)
 // |                                             Set                                                 |
 // +-------------------------------------------------------------------------------------------------+
 
-Status set_union(HashSet *set1, HashSet *set2, HashSet *result)
+// The set operations are built from passes over one set, each visiting
+// every element of scan, or only those that are or are not in other. The
+// passes of an operation never produce the same element twice, so results
+// are added without looking them up first.
+typedef struct SetPass
 {
-	if (set1 == NULL || set2 == NULL || result == NULL)
-		return DS_ERR_NULL_POINTER;
+	HashSet *scan;
+	HashSet *other; // NULL to visit every element of scan
+	bool member;	// Whether elements must be in other to be visited
+} SetPass;
 
-	if (!set_is_empty(result))
-		return DS_ERR_INVALID_ARGUMENT;
+typedef enum SetOperation
+{
+	SET_UNION,
+	SET_INTERSECTION,
+	SET_DIFFERENCE,
+	SET_SYM_DIFF
+} SetOperation;
+
+// Receives every element visited by a pass
+typedef Status (*set_emit_t)(HashSet *from, HashSetEntry *entry, void *data);
+
+// Passes of an operation and the number of elements its result is presized
+// for. Union copies the larger set and then the elements of the smaller one
+// missing from it, while intersection only scans the smaller set.
+static size_t set_plan(SetOperation operation, HashSet *set1, HashSet *set2, SetPass passes[2], size_t *size)
+{
+	HashSet *small = set1->size <= set2->size ? set1 : set2;
+	HashSet *large = small == set1 ? set2 : set1;
 
-	if (set1->size + set2->size > result->max_size)
-		return DS_ERR_INVALID_ARGUMENT;
+	switch (operation)
+	{
+	case SET_UNION:
+		passes[0] = (SetPass){large, NULL, false};
+		passes[1] = (SetPass){small, large, false};
+		*size = large->size;
+		return 2;
+	case SET_INTERSECTION:
+		passes[0] = (SetPass){small, large, true};
+		*size = small->size;
+		return 1;
+	case SET_DIFFERENCE:
+		passes[0] = (SetPass){set1, set2, false};
+		*size = set1->size;
+		return 1;
+	default:
+		passes[0] = (SetPass){set1, set2, false};
+		passes[1] = (SetPass){set2, set1, false};
+		*size = large->size;
+		return 2;
+	}
+}
+
+// Hash of an element of from as computed by to. The stored hash is reused
+// when both sets hash elements the same way.
+static Status set_hash_entry(HashSet *from, HashSet *to, HashSetEntry *entry, size_t *hash)
+{
+	if (from->hash_function == to->hash_function && from->hash_function_n == to->hash_function_n)
+	{
+		*hash = entry->hash;
+
+		return DS_OK;
+	}
+
+	return set_hash_key(to, entry->value, entry->length, true, hash);
+}
+
+// Visits the elements of pass in slots [begin, end) of its scanned set
+static Status set_run_pass(SetPass *pass, size_t begin, size_t end, set_emit_t emit, void *data)
+{
+	HashSet *scan = pass->scan, *other = pass->other;
+
+	HashSetEntry *entry;
+	size_t hash;
+	bool found;
 
 	Status st;
 
 	size_t i;
-	for (i = 0; i < set1->max_size; i++)
+	for (i = begin; i < end; i++)
 	{
+		if (!set_slot_used(scan, i))
+			continue;
 
-		if ((set1->hash_table)[i] != NULL)
+		entry = &((scan->hash_table)[i]);
+
+		if (other != NULL)
 		{
+			found = false;
 
-			st = set_insert(result, ((set1->hash_table)[i])->value);
+			if (!set_is_empty(other))
+			{
+				st = set_hash_entry(scan, other, entry, &hash);
 
-			if (st != DS_OK)
-				return st;
-		}
-	}
+				if (st != DS_OK)
+					return st;
 
-	for (i = 0; i < set2->max_size; i++)
-	{
+				found = set_find(other, entry->value, entry->length, hash) != SIZE_MAX;
+			}
 
-		if ((set2->hash_table)[i] != NULL)
-		{
+			if (found != pass->member)
+				continue;
+		}
 
-			st = set_insert(result, ((set2->hash_table)[i])->value);
+		st = emit(scan, entry, data);
 
-			if (st != DS_OK)
-				return st;
-		}
+		if (st != DS_OK)
+			return st;
 	}
 
 	return DS_OK;
 }
 
-Status set_intersection(HashSet *set1, HashSet *set2, HashSet *result)
+static Status set_emit_insert(HashSet *from, HashSetEntry *entry, void *data)
+{
+	HashSet *result = data;
+
+	size_t hash;
+
+	Status st = set_hash_entry(from, result, entry, &hash);
+
+	if (st != DS_OK)
+		return st;
+
+	return set_add(result, entry->value, entry->length, hash);
+}
+
+typedef struct SetVisit
+{
+	set_visitor_t visitor;
+	void *data;
+} SetVisit;
+
+static Status set_emit_visit(HashSet *from, HashSetEntry *entry, void *data)
+{
+	SetVisit *visit = data;
+
+	(void)from;
+
+	return visit->visitor(entry->value, entry->length, visit->data);
+}
+
+static Status set_operation(SetOperation operation, HashSet *set1, HashSet *set2, HashSet *result)
 {
 	if (set1 == NULL || set2 == NULL || result == NULL)
 		return DS_ERR_NULL_POINTER;
@@ -692,91 +1004,102 @@ Status set_intersection(HashSet *set1, HashSet *set2, HashSet *result)
 	if (!set_is_empty(result))
 		return DS_ERR_INVALID_ARGUMENT;
 
-	if (set1->size > result->max_size || set2->size > result->max_size)
-		return DS_ERR_INVALID_ARGUMENT;
+	SetPass passes[2];
+	size_t size;
 
-	Status st;
+	size_t count = set_plan(operation, set1, set2, passes, &size);
+
+	Status st = set_reserve(result, size);
 
-	bool exists;
+	if (st != DS_OK)
+		return st;
 
 	size_t i;
-	for (i = 0; i < set1->max_size; i++)
+	for (i = 0; i < count; i++)
 	{
+		st = set_run_pass(passes + i, 0, passes[i].scan->capacity, set_emit_insert, result);
 
-		if ((set1->hash_table)[i] != NULL)
-		{
-
-			st = set_contains(set2, ((set1->hash_table)[i])->value, &exists);
-
-			if (st != DS_OK)
-				return st;
-
-			if (exists)
-			{
-
-				st = set_insert(result, ((set1->hash_table)[i])->value);
-
-				if (st != DS_OK)
-					return st;
-			}
-		}
+		if (st != DS_OK)
+			return st;
 	}
 
 	return DS_OK;
 }
 
-Status set_difference(HashSet *set1, HashSet *set2, HashSet *result)
+static Status set_operation_each(SetOperation operation, HashSet *set1, HashSet *set2, set_visitor_t visitor, void *data)
 {
-	if (set1 == NULL || set2 == NULL || result == NULL)
+	if (set1 == NULL || set2 == NULL || visitor == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	if (!set_is_empty(result))
-		return DS_ERR_INVALID_ARGUMENT;
+	SetPass passes[2];
+	size_t size;
 
-	if (set_is_empty(set1))
-		return DS_OK;
+	size_t count = set_plan(operation, set1, set2, passes, &size);
 
-	Status st;
+	SetVisit visit = {visitor, data};
 
-	bool exists;
+	Status st;
 
 	size_t i;
-	for (i = 0; i < set1->max_size; i++)
+	for (i = 0; i < count; i++)
 	{
+		st = set_run_pass(passes + i, 0, passes[i].scan->capacity, set_emit_visit, &visit);
 
-		if ((set1->hash_table)[i] != NULL)
-		{
+		if (st != DS_OK)
+			return st;
+	}
 
-			st = set_contains(set2, ((set1->hash_table)[i])->value, &exists);
+	return DS_OK;
+}
 
-			if (st != DS_OK)
-				return st;
+// A worker runs a pass over its own range of slots and only collects the
+// entries it visits. They are added to the result once every worker is
+// done, as the result itself is not safe to share.
+typedef struct SetWorker
+{
+	SetPass *pass;
+	size_t begin;
+	size_t end;
+	HashSetEntry **found;
+	size_t count;
+	size_t capacity;
+	Status status;
+} SetWorker;
+
+static Status set_emit_collect(HashSet *from, HashSetEntry *entry, void *data)
+{
+	SetWorker *worker = data;
 
-			if (!exists)
-			{
+	(void)from;
 
-				st = set_insert(result, ((set1->hash_table)[i])->value);
+	if (worker->count == worker->capacity)
+	{
+		size_t capacity = worker->capacity == 0 ? 1024 : worker->capacity * 2;
 
-				if (st != DS_OK)
-					return st;
-			}
-		}
+		HashSetEntry **found = realloc(worker->found, sizeof(HashSetEntry *) * capacity);
+
+		if (!found)
+			return DS_ERR_ALLOC;
+
+		worker->found = found;
+		worker->capacity = capacity;
 	}
 
+	worker->found[(worker->count)++] = entry;
+
 	return DS_OK;
 }
 
-Status set_complement(HashSet *set1, HashSet *set2, HashSet *result)
+static DWORD WINAPI set_worker(LPVOID argument)
 {
-	Status st = set_difference(set2, set1, result);
+	SetWorker *worker = argument;
 
-	if (st != DS_OK)
-		return st;
+	worker->status = set_run_pass(worker->pass, worker->begin, worker->end, set_emit_collect, worker);
 
-	return DS_OK;
+	return 0;
 }
 
-Status set_sym_diff(HashSet *set1, HashSet *set2, HashSet *result)
+static Status set_operation_parallel(SetOperation operation, HashSet *set1, HashSet *set2, HashSet *result, size_t threads)
 {
 	if (set1 == NULL || set2 == NULL || result == NULL)
 		return DS_ERR_NULL_POINTER;
@@ -784,65 +1107,194 @@ Status set_sym_diff(HashSet *set1, HashSet *set2, HashSet *result)
 	if (!set_is_empty(result))
 		return DS_ERR_INVALID_ARGUMENT;
 
-	if (set1->size + set2->size > result->max_size)
+	if (threads == 0)
 		return DS_ERR_INVALID_ARGUMENT;
 
-	Status st;
+	SetPass passes[2];
+	size_t size;
 
-	bool exists;
+	size_t count = set_plan(operation, set1, set2, passes, &size);
 
-	size_t i;
-	for (i = 0; i < set1->max_size; i++)
-	{
+	SetWorker workers[2 * HASH_SET_MAX_THREADS];
+	HANDLE handles[2 * HASH_SET_MAX_THREADS];
 
-		if ((set1->hash_table)[i] != NULL)
-		{
+	size_t total = 0, spawned = 0;
+	size_t i, j, k, chunk, capacity, batch;
 
-			st = set_contains(set2, ((set1->hash_table)[i])->value, &exists);
+	if (threads > HASH_SET_MAX_THREADS)
+		threads = HASH_SET_MAX_THREADS;
 
-			if (st != DS_OK)
-				return st;
+	// Every pass gets up to threads workers, each with at least
+	// HASH_SET_PARALLEL_MIN slots. The last one of a pass runs inline once
+	// the others have started.
+	for (i = 0; i < count; i++)
+	{
+		capacity = passes[i].scan->capacity;
+		chunk = (capacity + threads - 1) / threads;
 
-			if (!exists)
-			{
+		if (chunk < HASH_SET_PARALLEL_MIN)
+			chunk = HASH_SET_PARALLEL_MIN;
 
-				st = set_insert(result, ((set1->hash_table)[i])->value);
+		for (j = 0; j < capacity; j += chunk)
+		{
+			workers[total] = (SetWorker){passes + i, j, j + chunk < capacity ? j + chunk : capacity, NULL, 0, 0, DS_OK};
 
-				if (st != DS_OK)
-					return st;
-			}
+			total++;
 		}
 	}
 
-	for (i = 0; i < set2->max_size; i++)
+	for (k = 0; k + 1 < total; k++)
 	{
+		handles[k] = CreateThread(NULL, 0, set_worker, workers + k, 0, NULL);
+
+		if (handles[k] == NULL)
+			break;
+
+		spawned++;
+	}
 
-		if ((set2->hash_table)[i] != NULL)
+	for (; k < total; k++)
+		set_worker(workers + k);
+
+	// Union and symmetric difference start up to twice as many workers as a
+	// single wait accepts, so they are waited for in batches. The workers
+	// write into this frame, so a failed wait falls back to waiting for each
+	// one on its own.
+	for (k = 0; k < spawned; k += batch)
+	{
+		batch = spawned - k < MAXIMUM_WAIT_OBJECTS ? spawned - k : MAXIMUM_WAIT_OBJECTS;
+
+		if (WaitForMultipleObjects((DWORD)batch, handles + k, TRUE, INFINITE) == WAIT_FAILED)
 		{
+			for (j = k; j < k + batch; j++)
+				WaitForSingleObject(handles[j], INFINITE);
+		}
+	}
 
-			st = set_contains(set1, ((set2->hash_table)[i])->value, &exists);
+	for (k = 0; k < spawned; k++)
+		CloseHandle(handles[k]);
 
-			if (st != DS_OK)
-				return st;
+	Status st = DS_OK;
 
-			if (!exists)
-			{
+	size = 0;
 
-				st = set_insert(result, ((set2->hash_table)[i])->value);
+	for (k = 0; k < total; k++)
+	{
+		if (workers[k].status != DS_OK && st == DS_OK)
+			st = workers[k].status;
 
-				if (st != DS_OK)
-					return st;
-			}
-		}
+		size += workers[k].count;
+	}
+
+	if (st == DS_OK)
+		st = set_reserve(result, size);
+
+	for (k = 0; k < total; k++)
+	{
+		for (j = 0; j < workers[k].count && st == DS_OK; j++)
+			st = set_emit_insert(workers[k].pass->scan, workers[k].found[j], result);
+
+		free(workers[k].found);
 	}
 
+	return st;
+}
+
+Status set_union(HashSet *set1, HashSet *set2, HashSet *result)
+{
+	return set_operation(SET_UNION, set1, set2, result);
+}
+
+Status set_intersection(HashSet *set1, HashSet *set2, HashSet *result)
+{
+	return set_operation(SET_INTERSECTION, set1, set2, result);
+}
+
+Status set_difference(HashSet *set1, HashSet *set2, HashSet *result)
+{
+	return set_operation(SET_DIFFERENCE, set1, set2, result);
+}
+
+Status set_complement(HashSet *set1, HashSet *set2, HashSet *result)
+{
+	Status st = set_difference(set2, set1, result);
+
+	if (st != DS_OK)
+		return st;
+
 	return DS_OK;
 }
 
+Status set_sym_diff(HashSet *set1, HashSet *set2, HashSet *result)
+{
+	return set_operation(SET_SYM_DIFF, set1, set2, result);
+}
+
+// Same results as the serial operations with the scanning split among up to
+// threads threads
+Status set_union_parallel(HashSet *set1, HashSet *set2, HashSet *result, size_t threads)
+{
+	return set_operation_parallel(SET_UNION, set1, set2, result, threads);
+}
+
+Status set_intersection_parallel(HashSet *set1, HashSet *set2, HashSet *result, size_t threads)
+{
+	return set_operation_parallel(SET_INTERSECTION, set1, set2, result, threads);
+}
+
+Status set_difference_parallel(HashSet *set1, HashSet *set2, HashSet *result, size_t threads)
+{
+	return set_operation_parallel(SET_DIFFERENCE, set1, set2, result, threads);
+}
+
+Status set_sym_diff_parallel(HashSet *set1, HashSet *set2, HashSet *result, size_t threads)
+{
+	return set_operation_parallel(SET_SYM_DIFF, set1, set2, result, threads);
+}
+
+// Calls visitor with every element of the result instead of storing them.
+// Nothing is allocated and the order is that of the scanned tables.
+Status set_union_each(HashSet *set1, HashSet *set2, set_visitor_t visitor, void *data)
+{
+	return set_operation_each(SET_UNION, set1, set2, visitor, data);
+}
+
+Status set_intersection_each(HashSet *set1, HashSet *set2, set_visitor_t visitor, void *data)
+{
+	return set_operation_each(SET_INTERSECTION, set1, set2, visitor, data);
+}
+
+Status set_difference_each(HashSet *set1, HashSet *set2, set_visitor_t visitor, void *data)
+{
+	return set_operation_each(SET_DIFFERENCE, set1, set2, visitor, data);
+}
+
+Status set_sym_diff_each(HashSet *set1, HashSet *set2, set_visitor_t visitor, void *data)
+{
+	return set_operation_each(SET_SYM_DIFF, set1, set2, visitor, data);
+}
+
 // +-------------------------------------------------------------------------------------------------+
 // |                                             Hash                                                |
 // +-------------------------------------------------------------------------------------------------+
 
+// Length aware version of the built-in functions or NULL if not known
+hash_function_n_t set_hash_length_variant(hash_function_t hash_function)
+{
+	if (hash_function == set_hash_djb2)
+		return set_hash_djb2_n;
+	if (hash_function == set_hash_sdbm)
+		return set_hash_sdbm_n;
+	if (hash_function == set_hash_prime)
+		return set_hash_prime_n;
+	if (hash_function == hash_wyhash)
+		return hash_wyhash_n;
+	if (hash_function == hash_xxh3)
+		return hash_xxh3_n;
+
+	return NULL;
+}
+
 Status set_hash_djb2(char *key, size_t *hash)
 {
 	*hash = 5381;
@@ -881,6 +1333,41 @@ Status set_hash_prime(char *key, size_t *hash)
 	return DS_OK;
 }
 
+Status set_hash_djb2_n(char *key, size_t length, size_t *hash)
+{
+	*hash = 5381;
+
+	size_t i;
+	for (i = 0; i < length; i++)
+		(*hash) = (((*hash) << 5) + (*hash)) + key[i];
+
+	return DS_OK;
+}
+
+Status set_hash_sdbm_n(char *key, size_t length, size_t *hash)
+{
+	*hash = 0;
+
+	size_t i;
+	for (i = 0; i < length; i++)
+		(*hash) = key[i] + (((*hash) << 6) + ((*hash) << 16)) - (*hash);
+
+	return DS_OK;
+}
+
+Status set_hash_prime_n(char *key, size_t length, size_t *hash)
+{
+	*hash = 1279307;
+
+	size_t prime = 37;
+
+	size_t i;
+	for (i = 0; i < length; i++)
+		*hash = ((*hash) * prime) + key[i] * (*hash);
+
+	return DS_OK;
+}
+
 Status set_rehash_rj(size_t *hash)
 {
 	*hash = ((*hash) + 0x7ed55d16) + ((*hash) << 12);
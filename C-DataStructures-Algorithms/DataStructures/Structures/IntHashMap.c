@@ -0,0 +1,417 @@
+/**
+ * @file IntHashMap.c
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Source file for @c IntHashMap implementations in C
+ *
+ */
+
+#include "IntHashMap.h"
+#include "HashFunctions.h"
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                          Initializers                                           |
+// +-------------------------------------------------------------------------------------------------+
+
+// Creates a map with room for at least size entries before it first grows
+Status imap_init_map(IntHashMap **map, size_t size)
+{
+	if (size == 0)
+		return DS_ERR_INVALID_SIZE;
+
+	size_t capacity = INT_HASH_MAP_INIT_SIZE;
+
+	while ((double)size > (double)capacity * INT_HASH_MAP_LOAD_FACTOR)
+		capacity *= INT_HASH_MAP_GROW_RATE;
+
+	*map = malloc(sizeof(IntHashMap));
+
+	if (!(*map))
+		return DS_ERR_ALLOC;
+
+	(*map)->hash_table = malloc(sizeof(IntHashMapEntry) * capacity);
+	(*map)->metadata = malloc(capacity);
+
+	if (!((*map)->hash_table) || !((*map)->metadata))
+	{
+		free((*map)->hash_table);
+		free((*map)->metadata);
+		free(*map);
+
+		*map = NULL;
+
+		return DS_ERR_ALLOC;
+	}
+
+	memset((*map)->metadata, INT_HASH_MAP_EMPTY, capacity);
+
+	(*map)->size = 0;
+	(*map)->capacity = capacity;
+	(*map)->load_factor = INT_HASH_MAP_LOAD_FACTOR;
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                            Probing                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+static size_t imap_home(IntHashMap *map, int64_t key)
+{
+	return hash_fmix64((uint64_t)key) & (map->capacity - 1);
+}
+
+static uint8_t imap_metadata(size_t dist)
+{
+	return dist + 1 < INT_HASH_MAP_DISTANCE_MAX ? (uint8_t)(dist + 1) : INT_HASH_MAP_DISTANCE_MAX;
+}
+
+// Distance of the entry at pos from its home slot
+static size_t imap_distance(IntHashMap *map, size_t pos)
+{
+	uint8_t meta = map->metadata[pos];
+
+	if (meta < INT_HASH_MAP_DISTANCE_MAX)
+		return (size_t)meta - 1;
+
+	return (pos - imap_home(map, (map->hash_table)[pos].key)) & (map->capacity - 1);
+}
+
+// Returns the slot holding key or SIZE_MAX. The search stops at the first
+// entry that is closer to its home than key would be.
+static size_t imap_find(IntHashMap *map, int64_t key)
+{
+	size_t mask = map->capacity - 1;
+	size_t pos = imap_home(map, key);
+	size_t dist = 0;
+
+	while (map->metadata[pos] != INT_HASH_MAP_EMPTY)
+	{
+		if (imap_distance(map, pos) < dist)
+			return SIZE_MAX;
+
+		if ((map->hash_table)[pos].key == key)
+			return pos;
+
+		pos = (pos + 1) & mask;
+
+		dist++;
+	}
+
+	return SIZE_MAX;
+}
+
+// Places an entry whose key is known not to be in the map, displacing
+// entries that are closer to their home than the one being placed
+static void imap_place(IntHashMap *map, IntHashMapEntry entry)
+{
+	size_t mask = map->capacity - 1;
+	size_t pos = imap_home(map, entry.key);
+	size_t dist = 0, slot_dist;
+
+	IntHashMapEntry temp;
+
+	while (map->metadata[pos] != INT_HASH_MAP_EMPTY)
+	{
+		slot_dist = imap_distance(map, pos);
+
+		if (slot_dist < dist)
+		{
+			temp = (map->hash_table)[pos];
+			(map->hash_table)[pos] = entry;
+			entry = temp;
+
+			map->metadata[pos] = imap_metadata(dist);
+
+			dist = slot_dist;
+		}
+
+		pos = (pos + 1) & mask;
+
+		dist++;
+	}
+
+	(map->hash_table)[pos] = entry;
+	map->metadata[pos] = imap_metadata(dist);
+}
+
+// Backward shift deletion of the entry at pos
+static void imap_erase_at(IntHashMap *map, size_t pos)
+{
+	size_t mask = map->capacity - 1;
+	size_t next = (pos + 1) & mask;
+	size_t dist;
+
+	while (map->metadata[next] != INT_HASH_MAP_EMPTY && (dist = imap_distance(map, next)) != 0)
+	{
+		(map->hash_table)[pos] = (map->hash_table)[next];
+		map->metadata[pos] = imap_metadata(dist - 1);
+
+		pos = next;
+		next = (next + 1) & mask;
+	}
+
+	map->metadata[pos] = INT_HASH_MAP_EMPTY;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                            Insertion                                            |
+// +-------------------------------------------------------------------------------------------------+
+
+// Inserts a new entry or updates the value of an existing one
+Status imap_insert(IntHashMap *map, int64_t key, int value)
+{
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	size_t pos = imap_find(map, key);
+
+	if (pos != SIZE_MAX)
+	{
+		(map->hash_table)[pos].value = value;
+
+		return DS_OK;
+	}
+
+	if ((double)(map->size + 1) > (double)map->capacity * map->load_factor)
+	{
+		Status st = imap_rehash(map, map->capacity * INT_HASH_MAP_GROW_RATE);
+
+		if (st != DS_OK)
+			return st;
+	}
+
+	IntHashMapEntry entry = {key, value};
+
+	imap_place(map, entry);
+
+	(map->size)++;
+
+	return DS_OK;
+}
+
+// Reserves room for every entry up front so the map grows at most once
+Status imap_insert_bulk(IntHashMap *map, int64_t *keys, int *values, size_t count)
+{
+	if (map == NULL || keys == NULL || values == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	Status st = imap_reserve(map, map->size + count);
+
+	if (st != DS_OK)
+		return st;
+
+	size_t i;
+	for (i = 0; i < count; i++)
+	{
+		st = imap_insert(map, keys[i], values[i]);
+
+		if (st != DS_OK)
+			return st;
+	}
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Removal                                             |
+// +-------------------------------------------------------------------------------------------------+
+
+Status imap_remove(IntHashMap *map, int64_t key)
+{
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (map->size == 0)
+		return DS_ERR_INVALID_OPERATION;
+
+	size_t pos = imap_find(map, key);
+
+	if (pos == SIZE_MAX)
+		return DS_ERR_NOT_FOUND;
+
+	imap_erase_at(map, pos);
+
+	(map->size)--;
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Display                                             |
+// +-------------------------------------------------------------------------------------------------+
+
+Status imap_display_map(IntHashMap *map)
+{
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	printf("\n+-------------------------------------------------------------------------------+");
+	printf("\n|                               Int Hash map                                    |");
+	printf("\n+-----------------------+------------+------------------------------------------+");
+	printf("\n|       DISTANCE        |   VALUE    |                    KEY                   |");
+
+	size_t i;
+	for (i = 0; i < map->capacity; i++)
+	{
+
+		printf("\n+-----------------------+------------+------------------------------------------+");
+
+		if (map->metadata[i] == INT_HASH_MAP_EMPTY)
+			printf("\n|         NULL          |    NULL    |                   NULL                   |");
+		else
+			printf("\n| %21zu | %10d | %40lld |", imap_distance(map, i), (map->hash_table)[i].value, (long long)(map->hash_table)[i].key);
+	}
+
+	printf("\n+-----------------------+------------+------------------------------------------+");
+
+	printf("\n");
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Resets                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+Status imap_delete_map(IntHashMap **map)
+{
+	if ((*map) == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	free((*map)->hash_table);
+	free((*map)->metadata);
+	free(*map);
+
+	*map = NULL;
+
+	return DS_OK;
+}
+
+// Removes every entry and keeps the capacity
+Status imap_erase_map(IntHashMap **map)
+{
+	if ((*map) == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	memset((*map)->metadata, INT_HASH_MAP_EMPTY, (*map)->capacity);
+
+	(*map)->size = 0;
+
+	return DS_OK;
+}
+
+Status imap_set_load_factor(IntHashMap *map, double load_factor)
+{
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (load_factor <= 0.0 || load_factor >= 1.0)
+		return DS_ERR_INVALID_ARGUMENT;
+
+	map->load_factor = load_factor;
+
+	if ((double)map->size > (double)map->capacity * map->load_factor)
+		return imap_rehash(map, map->capacity);
+
+	return DS_OK;
+}
+
+// Moves every entry to a new table with at least size slots. The table is
+// made larger if size slots can not hold every entry under the load factor.
+Status imap_rehash(IntHashMap *map, size_t size)
+{
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	size_t capacity = INT_HASH_MAP_INIT_SIZE;
+
+	while (capacity < size || (double)map->size > (double)capacity * map->load_factor)
+		capacity *= INT_HASH_MAP_GROW_RATE;
+
+	IntHashMapEntry *new_table = malloc(sizeof(IntHashMapEntry) * capacity);
+	uint8_t *new_metadata = malloc(capacity);
+
+	if (!new_table || !new_metadata)
+	{
+		free(new_table);
+		free(new_metadata);
+
+		return DS_ERR_ALLOC;
+	}
+
+	memset(new_metadata, INT_HASH_MAP_EMPTY, capacity);
+
+	IntHashMapEntry *old_table = map->hash_table;
+	uint8_t *old_metadata = map->metadata;
+	size_t old_capacity = map->capacity;
+
+	map->hash_table = new_table;
+	map->metadata = new_metadata;
+	map->capacity = capacity;
+
+	size_t i;
+	for (i = 0; i < old_capacity; i++)
+	{
+		if (old_metadata[i] != INT_HASH_MAP_EMPTY)
+			imap_place(map, old_table[i]);
+	}
+
+	free(old_table);
+	free(old_metadata);
+
+	return DS_OK;
+}
+
+// Makes room for at least size entries before the map grows again
+Status imap_reserve(IntHashMap *map, size_t size)
+{
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if ((double)size <= (double)map->capacity * map->load_factor)
+		return DS_OK;
+
+	return imap_rehash(map, (size_t)((double)size / map->load_factor) + 1);
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Search                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+Status imap_search(IntHashMap *map, int64_t key, int *value)
+{
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	size_t pos = imap_find(map, key);
+
+	if (pos == SIZE_MAX)
+		return DS_ERR_NOT_FOUND;
+
+	*value = (map->hash_table)[pos].value;
+
+	return DS_OK;
+}
+
+bool imap_contains(IntHashMap *map, int64_t key)
+{
+	if (map == NULL)
+		return false;
+
+	return imap_find(map, key) != SIZE_MAX;
+}
+
+Status imap_count_entries(IntHashMap *map, size_t *result)
+{
+	*result = 0;
+
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	*result = map->size;
+
+	return DS_OK;
+}
@@ -0,0 +1,606 @@
+/**
+ * @file IntHashSet.c
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Source file for @c IntHashSet implementations in C
+ *
+ */
+
+#include "IntHashSet.h"
+#include "HashFunctions.h"
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                          Initializers                                           |
+// +-------------------------------------------------------------------------------------------------+
+
+// Creates a set with room for at least size elements before it first grows
+Status iset_init_set(IntHashSet **set, size_t size)
+{
+	if (size == 0)
+		return DS_ERR_INVALID_SIZE;
+
+	size_t capacity = INT_HASH_SET_INIT_SIZE;
+
+	while ((double)size > (double)capacity * INT_HASH_SET_LOAD_FACTOR)
+		capacity *= INT_HASH_SET_GROW_RATE;
+
+	*set = malloc(sizeof(IntHashSet));
+
+	if (!(*set))
+		return DS_ERR_ALLOC;
+
+	(*set)->keys = malloc(sizeof(int64_t) * capacity);
+	(*set)->metadata = malloc(capacity);
+
+	if (!((*set)->keys) || !((*set)->metadata))
+	{
+		free((*set)->keys);
+		free((*set)->metadata);
+		free(*set);
+
+		*set = NULL;
+
+		return DS_ERR_ALLOC;
+	}
+
+	memset((*set)->metadata, INT_HASH_SET_EMPTY, capacity);
+
+	(*set)->size = 0;
+	(*set)->capacity = capacity;
+	(*set)->load_factor = INT_HASH_SET_LOAD_FACTOR;
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                            Probing                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+static size_t iset_home(IntHashSet *set, int64_t key)
+{
+	return hash_fmix64((uint64_t)key) & (set->capacity - 1);
+}
+
+static uint8_t iset_metadata(size_t dist)
+{
+	return dist + 1 < INT_HASH_SET_DISTANCE_MAX ? (uint8_t)(dist + 1) : INT_HASH_SET_DISTANCE_MAX;
+}
+
+// Distance of the element at pos from its home slot
+static size_t iset_distance(IntHashSet *set, size_t pos)
+{
+	uint8_t meta = set->metadata[pos];
+
+	if (meta < INT_HASH_SET_DISTANCE_MAX)
+		return (size_t)meta - 1;
+
+	return (pos - iset_home(set, (set->keys)[pos])) & (set->capacity - 1);
+}
+
+// Returns the slot holding key or SIZE_MAX. The search stops at the first
+// element that is closer to its home than key would be.
+static size_t iset_find(IntHashSet *set, int64_t key)
+{
+	size_t mask = set->capacity - 1;
+	size_t pos = iset_home(set, key);
+	size_t dist = 0;
+
+	while (set->metadata[pos] != INT_HASH_SET_EMPTY)
+	{
+		if (iset_distance(set, pos) < dist)
+			return SIZE_MAX;
+
+		if ((set->keys)[pos] == key)
+			return pos;
+
+		pos = (pos + 1) & mask;
+
+		dist++;
+	}
+
+	return SIZE_MAX;
+}
+
+// Places a key known not to be in the set, displacing elements that are
+// closer to their home than the key being placed
+static void iset_place(IntHashSet *set, int64_t key)
+{
+	size_t mask = set->capacity - 1;
+	size_t pos = iset_home(set, key);
+	size_t dist = 0, slot_dist;
+
+	int64_t temp;
+
+	while (set->metadata[pos] != INT_HASH_SET_EMPTY)
+	{
+		slot_dist = iset_distance(set, pos);
+
+		if (slot_dist < dist)
+		{
+			temp = (set->keys)[pos];
+			(set->keys)[pos] = key;
+			key = temp;
+
+			set->metadata[pos] = iset_metadata(dist);
+
+			dist = slot_dist;
+		}
+
+		pos = (pos + 1) & mask;
+
+		dist++;
+	}
+
+	(set->keys)[pos] = key;
+	set->metadata[pos] = iset_metadata(dist);
+}
+
+// Backward shift deletion of the element at pos
+static void iset_erase_at(IntHashSet *set, size_t pos)
+{
+	size_t mask = set->capacity - 1;
+	size_t next = (pos + 1) & mask;
+	size_t dist;
+
+	while (set->metadata[next] != INT_HASH_SET_EMPTY && (dist = iset_distance(set, next)) != 0)
+	{
+		(set->keys)[pos] = (set->keys)[next];
+		set->metadata[pos] = iset_metadata(dist - 1);
+
+		pos = next;
+		next = (next + 1) & mask;
+	}
+
+	set->metadata[pos] = INT_HASH_SET_EMPTY;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                            Insertion                                            |
+// +-------------------------------------------------------------------------------------------------+
+
+// Adds a key already known not to be in the set
+static Status iset_add(IntHashSet *set, int64_t key)
+{
+	if ((double)(set->size + 1) > (double)set->capacity * set->load_factor)
+	{
+		Status st = iset_rehash(set, set->capacity * INT_HASH_SET_GROW_RATE);
+
+		if (st != DS_OK)
+			return st;
+	}
+
+	iset_place(set, key);
+
+	(set->size)++;
+
+	return DS_OK;
+}
+
+Status iset_insert(IntHashSet *set, int64_t key)
+{
+	if (set == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (iset_find(set, key) != SIZE_MAX)
+		return DS_OK;
+
+	return iset_add(set, key);
+}
+
+// Reserves room for every key up front so the set grows at most once
+Status iset_insert_bulk(IntHashSet *set, int64_t *keys, size_t count)
+{
+	if (set == NULL || keys == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	Status st = iset_reserve(set, set->size + count);
+
+	if (st != DS_OK)
+		return st;
+
+	size_t i;
+	for (i = 0; i < count; i++)
+	{
+		st = iset_insert(set, keys[i]);
+
+		if (st != DS_OK)
+			return st;
+	}
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Removal                                             |
+// +-------------------------------------------------------------------------------------------------+
+
+Status iset_remove(IntHashSet *set, int64_t key)
+{
+	if (set == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (iset_is_empty(set))
+		return DS_ERR_INVALID_OPERATION;
+
+	size_t pos = iset_find(set, key);
+
+	if (pos == SIZE_MAX)
+		return DS_ERR_NOT_FOUND;
+
+	iset_erase_at(set, pos);
+
+	(set->size)--;
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Display                                             |
+// +-------------------------------------------------------------------------------------------------+
+
+Status iset_display_set(IntHashSet *set)
+{
+	if (set == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	printf("\n+------------------------------------------------------------------------------+");
+	printf("\n|                               Int Hash Set                                   |");
+	printf("\n+-----------------------+------------------------------------------------------+");
+	printf("\n|       DISTANCE        |                          KEY                         |");
+
+	size_t i;
+	for (i = 0; i < set->capacity; i++)
+	{
+
+		printf("\n+-----------------------+------------------------------------------------------+");
+
+		if (set->metadata[i] == INT_HASH_SET_EMPTY)
+			printf("\n|         NULL          |                           NULL                       |");
+		else
+			printf("\n| %21zu | %52lld |", iset_distance(set, i), (long long)(set->keys)[i]);
+	}
+
+	printf("\n+-----------------------+------------------------------------------------------+");
+
+	printf("\n");
+
+	return DS_OK;
+}
+
+Status iset_display_elements(IntHashSet *set)
+{
+	if (set == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	printf("\nInt Hash Set\n");
+
+	if (iset_is_empty(set))
+		printf("[ empty ]\n");
+	else
+	{
+
+		printf("( ");
+
+		size_t i;
+		for (i = 0; i < set->capacity; i++)
+		{
+
+			if (set->metadata[i] != INT_HASH_SET_EMPTY)
+				printf("< %lld > ", (long long)(set->keys)[i]);
+		}
+
+		printf(")");
+	}
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Resets                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+Status iset_delete_set(IntHashSet **set)
+{
+	if ((*set) == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	free((*set)->keys);
+	free((*set)->metadata);
+	free(*set);
+
+	*set = NULL;
+
+	return DS_OK;
+}
+
+// Removes every element and keeps the capacity
+Status iset_erase_set(IntHashSet **set)
+{
+	if ((*set) == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	memset((*set)->metadata, INT_HASH_SET_EMPTY, (*set)->capacity);
+
+	(*set)->size = 0;
+
+	return DS_OK;
+}
+
+Status iset_set_load_factor(IntHashSet *set, double load_factor)
+{
+	if (set == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (load_factor <= 0.0 || load_factor >= 1.0)
+		return DS_ERR_INVALID_ARGUMENT;
+
+	set->load_factor = load_factor;
+
+	if ((double)set->size > (double)set->capacity * set->load_factor)
+		return iset_rehash(set, set->capacity);
+
+	return DS_OK;
+}
+
+// Moves every element to a new table with at least size slots. The table
+// is made larger if size slots can not hold every element under the load
+// factor.
+Status iset_rehash(IntHashSet *set, size_t size)
+{
+	if (set == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	size_t capacity = INT_HASH_SET_INIT_SIZE;
+
+	while (capacity < size || (double)set->size > (double)capacity * set->load_factor)
+		capacity *= INT_HASH_SET_GROW_RATE;
+
+	int64_t *new_keys = malloc(sizeof(int64_t) * capacity);
+	uint8_t *new_metadata = malloc(capacity);
+
+	if (!new_keys || !new_metadata)
+	{
+		free(new_keys);
+		free(new_metadata);
+
+		return DS_ERR_ALLOC;
+	}
+
+	memset(new_metadata, INT_HASH_SET_EMPTY, capacity);
+
+	int64_t *old_keys = set->keys;
+	uint8_t *old_metadata = set->metadata;
+	size_t old_capacity = set->capacity;
+
+	set->keys = new_keys;
+	set->metadata = new_metadata;
+	set->capacity = capacity;
+
+	size_t i;
+	for (i = 0; i < old_capacity; i++)
+	{
+		if (old_metadata[i] != INT_HASH_SET_EMPTY)
+			iset_place(set, old_keys[i]);
+	}
+
+	free(old_keys);
+	free(old_metadata);
+
+	return DS_OK;
+}
+
+// Makes room for at least size elements before the set grows again
+Status iset_reserve(IntHashSet *set, size_t size)
+{
+	if (set == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if ((double)size <= (double)set->capacity * set->load_factor)
+		return DS_OK;
+
+	return iset_rehash(set, (size_t)((double)size / set->load_factor) + 1);
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Search                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+bool iset_is_empty(IntHashSet *set)
+{
+	return (set->size == 0);
+}
+
+Status iset_contains(IntHashSet *set, int64_t key, bool *result)
+{
+	*result = false;
+
+	if (set == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	*result = iset_find(set, key) != SIZE_MAX;
+
+	return DS_OK;
+}
+
+bool iset_exists(IntHashSet *set, int64_t key)
+{
+	if (set == NULL)
+		return false;
+
+	return iset_find(set, key) != SIZE_MAX;
+}
+
+Status iset_count_elements(IntHashSet *set, size_t *result)
+{
+	*result = 0;
+
+	if (set == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	*result = set->size;
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Set                                                 |
+// +-------------------------------------------------------------------------------------------------+
+
+// Set operations are passes over one set, as in HashSet. A pass visits every
+// element of scan, or only those that are or are not in other, and the
+// passes of an operation never visit the same key twice.
+typedef struct IntSetPass
+{
+	IntHashSet *scan;
+	IntHashSet *other; // NULL to visit every element of scan
+	bool member;	   // Whether elements must be in other to be visited
+} IntSetPass;
+
+typedef enum IntSetOperation
+{
+	ISET_UNION,
+	ISET_INTERSECTION,
+	ISET_DIFFERENCE,
+	ISET_SYM_DIFF
+} IntSetOperation;
+
+static size_t iset_plan(IntSetOperation operation, IntHashSet *set1, IntHashSet *set2, IntSetPass passes[2], size_t *size)
+{
+	IntHashSet *small = set1->size <= set2->size ? set1 : set2;
+	IntHashSet *large = small == set1 ? set2 : set1;
+
+	switch (operation)
+	{
+	case ISET_UNION:
+		passes[0] = (IntSetPass){large, NULL, false};
+		passes[1] = (IntSetPass){small, large, false};
+		*size = large->size;
+		return 2;
+	case ISET_INTERSECTION:
+		passes[0] = (IntSetPass){small, large, true};
+		*size = small->size;
+		return 1;
+	case ISET_DIFFERENCE:
+		passes[0] = (IntSetPass){set1, set2, false};
+		*size = set1->size;
+		return 1;
+	default:
+		passes[0] = (IntSetPass){set1, set2, false};
+		passes[1] = (IntSetPass){set2, set1, false};
+		*size = large->size;
+		return 2;
+	}
+}
+
+// Runs every pass of operation, adding the keys visited to result or
+// handing them to visitor when result is NULL
+static Status iset_operation(IntSetOperation operation, IntHashSet *set1, IntHashSet *set2, IntHashSet *result, iset_visitor_t visitor, void *data)
+{
+	IntSetPass passes[2];
+	size_t size;
+
+	size_t count = iset_plan(operation, set1, set2, passes, &size);
+
+	Status st;
+
+	if (result != NULL)
+	{
+		st = iset_reserve(result, size);
+
+		if (st != DS_OK)
+			return st;
+	}
+
+	IntSetPass *pass;
+	int64_t key;
+
+	size_t i, j;
+	for (i = 0; i < count; i++)
+	{
+		pass = passes + i;
+
+		for (j = 0; j < pass->scan->capacity; j++)
+		{
+			if (pass->scan->metadata[j] == INT_HASH_SET_EMPTY)
+				continue;
+
+			key = (pass->scan->keys)[j];
+
+			if (pass->other != NULL && (iset_find(pass->other, key) != SIZE_MAX) != pass->member)
+				continue;
+
+			st = result != NULL ? iset_add(result, key) : visitor(key, data);
+
+			if (st != DS_OK)
+				return st;
+		}
+	}
+
+	return DS_OK;
+}
+
+static Status iset_operation_into(IntSetOperation operation, IntHashSet *set1, IntHashSet *set2, IntHashSet *result)
+{
+	if (set1 == NULL || set2 == NULL || result == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (!iset_is_empty(result))
+		return DS_ERR_INVALID_ARGUMENT;
+
+	return iset_operation(operation, set1, set2, result, NULL, NULL);
+}
+
+static Status iset_operation_each(IntSetOperation operation, IntHashSet *set1, IntHashSet *set2, iset_visitor_t visitor, void *data)
+{
+	if (set1 == NULL || set2 == NULL || visitor == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return iset_operation(operation, set1, set2, NULL, visitor, data);
+}
+
+Status iset_union(IntHashSet *set1, IntHashSet *set2, IntHashSet *result)
+{
+	return iset_operation_into(ISET_UNION, set1, set2, result);
+}
+
+Status iset_intersection(IntHashSet *set1, IntHashSet *set2, IntHashSet *result)
+{
+	return iset_operation_into(ISET_INTERSECTION, set1, set2, result);
+}
+
+Status iset_difference(IntHashSet *set1, IntHashSet *set2, IntHashSet *result)
+{
+	return iset_operation_into(ISET_DIFFERENCE, set1, set2, result);
+}
+
+Status iset_complement(IntHashSet *set1, IntHashSet *set2, IntHashSet *result)
+{
+	return iset_difference(set2, set1, result);
+}
+
+Status iset_sym_diff(IntHashSet *set1, IntHashSet *set2, IntHashSet *result)
+{
+	return iset_operation_into(ISET_SYM_DIFF, set1, set2, result);
+}
+
+Status iset_union_each(IntHashSet *set1, IntHashSet *set2, iset_visitor_t visitor, void *data)
+{
+	return iset_operation_each(ISET_UNION, set1, set2, visitor, data);
+}
+
+Status iset_intersection_each(IntHashSet *set1, IntHashSet *set2, iset_visitor_t visitor, void *data)
+{
+	return iset_operation_each(ISET_INTERSECTION, set1, set2, visitor, data);
+}
+
+Status iset_difference_each(IntHashSet *set1, IntHashSet *set2, iset_visitor_t visitor, void *data)
+{
+	return iset_operation_each(ISET_DIFFERENCE, set1, set2, visitor, data);
+}
+
+Status iset_sym_diff_each(IntHashSet *set1, IntHashSet *set2, iset_visitor_t visitor, void *data)
+{
+	return iset_operation_each(ISET_SYM_DIFF, set1, set2, visitor, data);
+}
@@ -0,0 +1,588 @@
+/**
+ * @file PerfectHash.c
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Source file for @c PerfectHash implementations in C
+ *
+ */
+
+#include <intrin.h>
+#include <limits.h>
+#include "PerfectHash.h"
+#include "Cpu.h"
+
+#define PERFECT_HASH_LEVEL_SEED 0x9E3779B97F4A7C15ull
+#define PERFECT_HASH_FINGERPRINT_SEED 0xD6E8FEB86659FD93ull
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Helpers                                             |
+// +-------------------------------------------------------------------------------------------------+
+
+// Finalizer of splitmix64, every input bit affects every output bit
+static uint64_t mph_mix(uint64_t x)
+{
+	x ^= x >> 30;
+	x *= 0xBF58476D1CE4E5B9ull;
+	x ^= x >> 27;
+	x *= 0x94D049BB133111EBull;
+	x ^= x >> 31;
+
+	return x;
+}
+
+// Bit of a key at a level of size bits
+static size_t mph_position(uint64_t hash, size_t level, size_t size)
+{
+	uint64_t x = mph_mix(hash + (level + 1) * PERFECT_HASH_LEVEL_SEED);
+
+#if defined(_M_X64)
+	return (size_t)__umulh(x, (uint64_t)size);
+#else
+	return (size_t)(x % size);
+#endif
+}
+
+static uint64_t mph_fingerprint(uint64_t hash, size_t bits)
+{
+	return mph_mix(hash ^ PERFECT_HASH_FINGERPRINT_SEED) & ((1ull << bits) - 1);
+}
+
+static size_t mph_popcount(uint64_t x)
+{
+#if defined(_M_X64)
+	static int popcnt = -1;
+
+	if (popcnt < 0)
+		popcnt = cpu_has(CPU_POPCNT) ? 1 : 0;
+
+	if (popcnt)
+		return (size_t)__popcnt64(x);
+#endif
+
+	x = x - ((x >> 1) & 0x5555555555555555ull);
+	x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+	x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+
+	return (size_t)((x * 0x0101010101010101ull) >> 56);
+}
+
+static bool mph_bit(const uint64_t *bits, size_t pos)
+{
+	return (bits[pos >> 6] >> (pos & 63)) & 1;
+}
+
+// Number of bits set before pos
+static size_t mph_rank(PerfectHash *mph, size_t pos)
+{
+	size_t word = pos >> 6;
+	size_t result = mph->ranks[pos >> 9];
+
+	size_t i;
+	for (i = (pos >> 9) << 3; i < word; i++)
+		result += mph_popcount(mph->bits[i]);
+
+	return result + mph_popcount(mph->bits[word] & ((1ull << (pos & 63)) - 1));
+}
+
+// Fingerprints are packed back to back and may straddle two words
+static uint64_t mph_packed_get(const uint64_t *words, size_t index, size_t bits)
+{
+	size_t pos = index * bits;
+	size_t off = pos & 63;
+
+	uint64_t v = words[pos >> 6] >> off;
+
+	if (off + bits > 64)
+		v |= words[(pos >> 6) + 1] << (64 - off);
+
+	return v & ((1ull << bits) - 1);
+}
+
+static void mph_packed_set(uint64_t *words, size_t index, size_t bits, uint64_t value)
+{
+	size_t pos = index * bits;
+	size_t off = pos & 63;
+
+	words[pos >> 6] |= value << off;
+
+	if (off + bits > 64)
+		words[(pos >> 6) + 1] |= value >> (64 - off);
+}
+
+static Status mph_hash_key(PerfectHash *mph, char *key, size_t length, bool terminated, size_t *hash)
+{
+	if (mph->hash_function_n != NULL)
+		return mph->hash_function_n(key, length, hash);
+
+	if (terminated)
+		return mph->hash_function(key, hash);
+
+	char small[PERFECT_HASH_KEY_BUFFER];
+	char *buffer = small;
+
+	if (length >= PERFECT_HASH_KEY_BUFFER)
+	{
+		buffer = malloc(length + 1);
+
+		if (!buffer)
+			return DS_ERR_ALLOC;
+	}
+
+	memcpy(buffer, key, length);
+	buffer[length] = '\0';
+
+	Status st = mph->hash_function(buffer, hash);
+
+	if (buffer != small)
+		free(buffer);
+
+	return st;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Builder                                             |
+// +-------------------------------------------------------------------------------------------------+
+
+// Places as many of the count keys of remaining as possible on a new level.
+// Placed keys get their bit in positions and the others are moved to the
+// front of remaining, their number returned in left.
+static Status mph_build_level(PerfectHash *mph, uint64_t *hashes, size_t *remaining, size_t count, size_t *positions, uint64_t *collisions, size_t *left)
+{
+	size_t level = mph->levels;
+	size_t size = (size_t)((double)count * mph->gamma) + 1;
+
+	// Whole words so every level starts at a word boundary
+	size = ((size + 63) >> 6) << 6;
+
+	size_t words = size >> 6;
+
+	uint64_t *new_bits = realloc(mph->bits, sizeof(uint64_t) * (mph->words + words));
+
+	if (!new_bits)
+		return DS_ERR_ALLOC;
+
+	mph->bits = new_bits;
+
+	uint64_t *bits = mph->bits + mph->words;
+
+	memset(bits, 0, sizeof(uint64_t) * words);
+	memset(collisions, 0, sizeof(uint64_t) * words);
+
+	size_t i, pos;
+
+	// A bit is kept only if a single key hashed to it
+	for (i = 0; i < count; i++)
+	{
+		pos = mph_position(hashes[remaining[i]], level, size);
+
+		if (mph_bit(bits, pos))
+			collisions[pos >> 6] |= 1ull << (pos & 63);
+		else
+			bits[pos >> 6] |= 1ull << (pos & 63);
+	}
+
+	for (i = 0; i < words; i++)
+		bits[i] &= ~collisions[i];
+
+	size_t offset = mph->words << 6;
+
+	*left = 0;
+
+	for (i = 0; i < count; i++)
+	{
+		pos = mph_position(hashes[remaining[i]], level, size);
+
+		if (mph_bit(bits, pos))
+			positions[remaining[i]] = offset + pos;
+		else
+			remaining[(*left)++] = remaining[i];
+	}
+
+	mph->level_offset[level] = offset;
+	mph->level_size[level] = size;
+	mph->words += words;
+	mph->levels++;
+
+	return DS_OK;
+}
+
+static Status mph_build_ranks(PerfectHash *mph)
+{
+	size_t blocks = (mph->words + 7) >> 3;
+
+	mph->ranks = malloc(sizeof(size_t) * (blocks + 1));
+
+	if (!mph->ranks)
+		return DS_ERR_ALLOC;
+
+	size_t i, total = 0;
+	for (i = 0; i < mph->words; i++)
+	{
+		if ((i & 7) == 0)
+			mph->ranks[i >> 3] = total;
+
+		total += mph_popcount(mph->bits[i]);
+	}
+
+	mph->ranks[blocks] = total;
+
+	mph->placed = total;
+
+	return DS_OK;
+}
+
+// Keys no level could place go to a HashMap indexed after the placed ones.
+// Only keys with equal hashes can get here after many levels and the
+// HashMap tells them apart by comparing the keys themselves.
+static Status mph_build_fallback(PerfectHash *mph, char **keys, uint64_t *hashes, size_t *remaining, size_t count, size_t *positions)
+{
+	Status st = map_init_map(&(mph->fallback), count, mph->hash_function);
+
+	if (st != DS_OK)
+		return st;
+
+	// mph_search is read only and may run on many threads at once
+	map_set_stats(mph->fallback, false);
+
+	size_t i;
+	for (i = 0; i < count; i++)
+	{
+		char *key = keys[remaining[i]];
+		size_t length = strlen(key);
+		int index;
+
+		if (map_search_hashed(mph->fallback, key, length, (size_t)hashes[remaining[i]], &index) == DS_OK)
+			return DS_ERR_INVALID_ARGUMENT;
+
+		st = map_insert_hashed(mph->fallback, key, length, (size_t)hashes[remaining[i]], (int)i);
+
+		if (st != DS_OK)
+			return st;
+
+		positions[remaining[i]] = mph->placed + i;
+	}
+
+	return DS_OK;
+}
+
+Status mph_build(PerfectHash **mph, char **keys, size_t count, int *values, size_t fingerprint_bits, hash_function_t hash_function)
+{
+	return mph_build_gamma(mph, keys, count, values, fingerprint_bits, PERFECT_HASH_GAMMA, hash_function);
+}
+
+// Builds a PerfectHash for count distinct keys. The keys are only read while
+// building, values may be NULL and fingerprint_bits may be 0 to disable
+// fingerprints. Duplicated keys make the build fail.
+Status mph_build_gamma(PerfectHash **mph, char **keys, size_t count, int *values, size_t fingerprint_bits, double gamma, hash_function_t hash_function)
+{
+	*mph = NULL;
+
+	if (keys == NULL || hash_function == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (count == 0 || count > INT_MAX)
+		return DS_ERR_INVALID_SIZE;
+
+	if (fingerprint_bits > PERFECT_HASH_MAX_FINGERPRINT || gamma < 1.0)
+		return DS_ERR_INVALID_ARGUMENT;
+
+	*mph = calloc(1, sizeof(PerfectHash));
+
+	if (!(*mph))
+		return DS_ERR_ALLOC;
+
+	(*mph)->size = count;
+	(*mph)->gamma = gamma;
+	(*mph)->fingerprint_bits = fingerprint_bits;
+	(*mph)->hash_function = hash_function;
+	(*mph)->hash_function_n = map_hash_length_variant(hash_function);
+
+	uint64_t *hashes = malloc(sizeof(uint64_t) * count);
+	size_t *remaining = malloc(sizeof(size_t) * count);
+	size_t *positions = malloc(sizeof(size_t) * count);
+	uint64_t *collisions = malloc(sizeof(uint64_t) * (((size_t)((double)count * gamma) + 64) >> 6));
+
+	Status st = DS_OK;
+
+	if (!hashes || !remaining || !positions || !collisions)
+		st = DS_ERR_ALLOC;
+
+	size_t i, left = count;
+
+	for (i = 0; i < count && st == DS_OK; i++)
+	{
+		size_t hash;
+
+		if (keys[i] == NULL)
+			st = DS_ERR_NULL_POINTER;
+		else
+			st = hash_function(keys[i], &hash);
+
+		hashes[i] = (uint64_t)hash;
+		remaining[i] = i;
+		positions[i] = SIZE_MAX;
+	}
+
+	// A level that places nothing usually means the keys left have equal
+	// hashes and no further level would place them either
+	size_t before = 0;
+
+	while (st == DS_OK && left > 0 && left != before && (*mph)->levels < PERFECT_HASH_MAX_LEVELS)
+	{
+		before = left;
+
+		st = mph_build_level(*mph, hashes, remaining, left, positions, collisions, &left);
+	}
+
+	if (st == DS_OK)
+		st = mph_build_ranks(*mph);
+
+	// Bits become indices, keys not placed by any level are still SIZE_MAX
+	for (i = 0; i < count && st == DS_OK; i++)
+	{
+		if (positions[i] != SIZE_MAX)
+			positions[i] = mph_rank(*mph, positions[i]);
+	}
+
+	if (st == DS_OK && left > 0)
+		st = mph_build_fallback(*mph, keys, hashes, remaining, left, positions);
+
+	if (st == DS_OK && fingerprint_bits > 0)
+	{
+		(*mph)->fingerprints = calloc(((count * fingerprint_bits) >> 6) + 1, sizeof(uint64_t));
+
+		if (!(*mph)->fingerprints)
+			st = DS_ERR_ALLOC;
+	}
+
+	if (st == DS_OK && values != NULL)
+	{
+		(*mph)->values = malloc(sizeof(int) * count);
+
+		if (!(*mph)->values)
+			st = DS_ERR_ALLOC;
+	}
+
+	for (i = 0; i < count && st == DS_OK; i++)
+	{
+		size_t index = positions[i];
+
+		if ((*mph)->fingerprints)
+			mph_packed_set((*mph)->fingerprints, index, fingerprint_bits, mph_fingerprint(hashes[i], fingerprint_bits));
+
+		if ((*mph)->values)
+			(*mph)->values[index] = values[i];
+	}
+
+	free(hashes);
+	free(remaining);
+	free(positions);
+	free(collisions);
+
+	if (st != DS_OK)
+		mph_delete(mph);
+
+	return st;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Search                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+static Status mph_index_key(PerfectHash *mph, char *key, size_t length, bool terminated, size_t *index)
+{
+	size_t hash;
+
+	Status st = mph_hash_key(mph, key, length, terminated, &hash);
+
+	if (st != DS_OK)
+		return st;
+
+	size_t level, pos;
+
+	for (level = 0; level < mph->levels; level++)
+	{
+		pos = mph->level_offset[level] + mph_position((uint64_t)hash, level, mph->level_size[level]);
+
+		if (mph_bit(mph->bits, pos))
+		{
+			*index = mph_rank(mph, pos);
+
+			if (mph->fingerprints != NULL &&
+				mph_packed_get(mph->fingerprints, *index, mph->fingerprint_bits) != mph_fingerprint((uint64_t)hash, mph->fingerprint_bits))
+				return DS_ERR_NOT_FOUND;
+
+			return DS_OK;
+		}
+	}
+
+	if (mph->fallback != NULL)
+	{
+		int value;
+
+		if (map_search_hashed(mph->fallback, key, length, hash, &value) == DS_OK)
+		{
+			*index = mph->placed + (size_t)value;
+
+			return DS_OK;
+		}
+	}
+
+	return DS_ERR_NOT_FOUND;
+}
+
+// Index of key in [0, size). A key that is not in the set is either
+// rejected or gets the index of some other key, see PerfectHash.
+Status mph_index(PerfectHash *mph, char *key, size_t *index)
+{
+	*index = 0;
+
+	if (mph == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return mph_index_key(mph, key, strlen(key), true, index);
+}
+
+Status mph_index_n(PerfectHash *mph, char *key, size_t length, size_t *index)
+{
+	*index = 0;
+
+	if (mph == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return mph_index_key(mph, key, length, false, index);
+}
+
+static Status mph_search_key(PerfectHash *mph, char *key, size_t length, bool terminated, int *value)
+{
+	if (mph->values == NULL)
+		return DS_ERR_INVALID_OPERATION;
+
+	size_t index;
+
+	Status st = mph_index_key(mph, key, length, terminated, &index);
+
+	if (st != DS_OK)
+		return st;
+
+	*value = mph->values[index];
+
+	return DS_OK;
+}
+
+Status mph_search(PerfectHash *mph, char *key, int *value)
+{
+	*value = 0;
+
+	if (mph == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return mph_search_key(mph, key, strlen(key), true, value);
+}
+
+Status mph_search_n(PerfectHash *mph, char *key, size_t length, int *value)
+{
+	*value = 0;
+
+	if (mph == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return mph_search_key(mph, key, length, false, value);
+}
+
+bool mph_contains(PerfectHash *mph, char *key)
+{
+	size_t index;
+
+	return mph_index(mph, key, &index) == DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Counts                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+Status mph_count_entries(PerfectHash *mph, size_t *result)
+{
+	*result = 0;
+
+	if (mph == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	*result = mph->size;
+
+	return DS_OK;
+}
+
+// Bits used by the index itself: levels, rank samples and fingerprints.
+// Values and the fallback HashMap are not counted.
+Status mph_count_bits(PerfectHash *mph, size_t *result)
+{
+	*result = 0;
+
+	if (mph == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	*result = (mph->words << 6) + ((((mph->words + 7) >> 3) + 1) * sizeof(size_t) * 8);
+
+	if (mph->fingerprints != NULL)
+		*result += mph->size * mph->fingerprint_bits;
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Display                                             |
+// +-------------------------------------------------------------------------------------------------+
+
+Status mph_display(PerfectHash *mph)
+{
+	if (mph == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	size_t bits;
+
+	mph_count_bits(mph, &bits);
+
+	printf("\nPerfect Hash\n");
+	printf("\n%-10s %12s %12s", "Level", "Bits", "Keys");
+
+	size_t level;
+	for (level = 0; level < mph->levels; level++)
+	{
+		size_t begin = mph_rank(mph, mph->level_offset[level]);
+		size_t end = level + 1 < mph->levels ? mph_rank(mph, mph->level_offset[level + 1]) : mph->placed;
+
+		printf("\n%-10zu %12zu %12zu", level, mph->level_size[level], end - begin);
+	}
+
+	printf("\n%-10s %12s %12zu", "Fallback", "", mph->size - mph->placed);
+
+	printf("\n\nKeys: %zu, bits per key: %.2lf, fingerprint bits: %zu\n", mph->size, (double)bits / (double)mph->size, mph->fingerprint_bits);
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Delete                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+Status mph_delete(PerfectHash **mph)
+{
+	if (*mph == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if ((*mph)->fallback != NULL)
+		map_delete_map(&((*mph)->fallback));
+
+	free((*mph)->bits);
+	free((*mph)->ranks);
+	free((*mph)->fingerprints);
+	free((*mph)->values);
+	free(*mph);
+
+	*mph = NULL;
+
+	return DS_OK;
+}
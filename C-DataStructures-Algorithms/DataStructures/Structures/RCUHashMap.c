@@ -0,0 +1,651 @@
+/**
+ * @file RCUHashMap.c
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Source file for @c RCUHashMap implementations in C
+ *
+ */
+
+#include "RCUHashMap.h"
+
+#define RCU_HASH_MAP_KEY_BUFFER 256
+
+// Marks a removed entry so probe sequences going through it are not cut
+static HashMapEntry rmap_tombstone;
+
+#define RMAP_TOMBSTONE (&rmap_tombstone)
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                          Initializers                                           |
+// +-------------------------------------------------------------------------------------------------+
+
+static Status rmap_make_table(RCUHashMapTable **table, size_t capacity)
+{
+	*table = malloc(sizeof(RCUHashMapTable) + sizeof(HashMapEntry *) * capacity);
+
+	if (!(*table))
+		return DS_ERR_ALLOC;
+
+	(*table)->capacity = capacity;
+	(*table)->used = 0;
+	(*table)->slots = (HashMapEntry *volatile *)((*table) + 1);
+
+	memset((void *)(*table)->slots, 0, sizeof(HashMapEntry *) * capacity);
+
+	return DS_OK;
+}
+
+Status rmap_init_map(RCUHashMap **map, size_t size, hash_function_t hash_function)
+{
+	if (size == 0)
+		return DS_ERR_INVALID_SIZE;
+
+	if (hash_function == NULL)
+		return DS_ERR_INVALID_ARGUMENT;
+
+	size_t capacity = RCU_HASH_MAP_INIT_SIZE;
+
+	while ((double)size > (double)capacity * RCU_HASH_MAP_LOAD_FACTOR)
+		capacity *= 2;
+
+	*map = malloc(sizeof(RCUHashMap));
+
+	if (!(*map))
+		return DS_ERR_ALLOC;
+
+	RCUHashMapTable *table;
+
+	Status st = rmap_make_table(&table, capacity);
+
+	if (st != DS_OK)
+	{
+		free(*map);
+
+		*map = NULL;
+
+		return st;
+	}
+
+	(*map)->readers = calloc(RCU_HASH_MAP_MAX_READERS, sizeof(RCUHashMapReader));
+
+	if (!((*map)->readers))
+	{
+		free(table);
+		free(*map);
+
+		*map = NULL;
+
+		return DS_ERR_ALLOC;
+	}
+
+	(*map)->table = table;
+	(*map)->size = 0;
+	(*map)->epoch = 1;
+
+	(*map)->retired = NULL;
+	(*map)->retired_size = 0;
+	(*map)->retired_capacity = 0;
+
+	InitializeSRWLock(&((*map)->write_lock));
+
+	(*map)->hash_function = hash_function;
+	(*map)->hash_function_n = map_hash_length_variant(hash_function);
+
+	return DS_OK;
+}
+
+// Claims a reader slot for the calling thread. Every thread calling the
+// search functions needs its own reader.
+Status rmap_register_reader(RCUHashMap *map, size_t *reader)
+{
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	size_t i;
+	for (i = 0; i < RCU_HASH_MAP_MAX_READERS; i++)
+	{
+		if (InterlockedCompareExchange(&(map->readers[i].in_use), 1, 0) == 0)
+		{
+			*reader = i;
+
+			return DS_OK;
+		}
+	}
+
+	return DS_ERR_FULL;
+}
+
+Status rmap_unregister_reader(RCUHashMap *map, size_t reader)
+{
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (reader >= RCU_HASH_MAP_MAX_READERS)
+		return DS_ERR_INVALID_ARGUMENT;
+
+	WriteULongPtrRelease(&(map->readers[reader].epoch), 0);
+
+	InterlockedExchange(&(map->readers[reader].in_use), 0);
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                            Getters                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+static Status rmap_hash_key(RCUHashMap *map, char *key, size_t length, bool terminated, size_t *hash)
+{
+	if (map->hash_function_n != NULL)
+		return map->hash_function_n(key, length, hash);
+
+	if (terminated)
+		return map->hash_function(key, hash);
+
+	char small[RCU_HASH_MAP_KEY_BUFFER];
+	char *buffer = small;
+
+	if (length >= RCU_HASH_MAP_KEY_BUFFER)
+	{
+		buffer = malloc(length + 1);
+
+		if (!buffer)
+			return DS_ERR_ALLOC;
+	}
+
+	memcpy(buffer, key, length);
+	buffer[length] = '\0';
+
+	Status st = map->hash_function(buffer, hash);
+
+	if (buffer != small)
+		free(buffer);
+
+	return st;
+}
+
+// Entry and key in a single allocation so one free releases both
+static Status rmap_make_entry(HashMapEntry **entry, char *key, size_t length, size_t hash, int value)
+{
+	*entry = malloc(sizeof(HashMapEntry) + length + 1);
+
+	if (!(*entry))
+		return DS_ERR_ALLOC;
+
+	(*entry)->key = (char *)((*entry) + 1);
+
+	memcpy((*entry)->key, key, length);
+	(*entry)->key[length] = '\0';
+
+	(*entry)->value = value;
+	(*entry)->hash = hash;
+	(*entry)->length = length;
+
+	return DS_OK;
+}
+
+// Slot holding key, or the first free slot of its probe sequence with found
+// set to false. Tombstones are returned as free slots.
+static size_t rmap_find_slot(RCUHashMapTable *table, char *key, size_t length, size_t hash, bool *found)
+{
+	size_t mask = table->capacity - 1;
+	size_t pos = hash & mask;
+	size_t free_slot = SIZE_MAX;
+
+	*found = false;
+
+	while (true)
+	{
+		HashMapEntry *entry = table->slots[pos];
+
+		if (entry == NULL)
+			return free_slot != SIZE_MAX ? free_slot : pos;
+
+		if (entry == RMAP_TOMBSTONE)
+		{
+			if (free_slot == SIZE_MAX)
+				free_slot = pos;
+		}
+		else if (entry->hash == hash && entry->length == length && memcmp(entry->key, key, length) == 0)
+		{
+			*found = true;
+
+			return pos;
+		}
+
+		pos = (pos + 1) & mask;
+	}
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                           Reclamation                                           |
+// +-------------------------------------------------------------------------------------------------+
+
+static Status rmap_reclaim_locked(RCUHashMap *map);
+
+// Called with the write lock held once pointer is no longer reachable from
+// map->table
+static Status rmap_retire(RCUHashMap *map, void *pointer)
+{
+	if (map->retired_size == map->retired_capacity)
+	{
+		size_t capacity = map->retired_capacity == 0 ? RCU_HASH_MAP_RECLAIM_BATCH : map->retired_capacity * 2;
+
+		RCUHashMapRetired *retired = realloc(map->retired, sizeof(RCUHashMapRetired) * capacity);
+
+		if (!retired)
+			return DS_ERR_ALLOC;
+
+		map->retired = retired;
+		map->retired_capacity = capacity;
+	}
+
+	map->retired[map->retired_size].pointer = pointer;
+	map->retired[map->retired_size].epoch = map->epoch;
+
+	(map->retired_size)++;
+
+	if (map->retired_size % RCU_HASH_MAP_RECLAIM_BATCH == 0)
+		return rmap_reclaim_locked(map);
+
+	return DS_OK;
+}
+
+static Status rmap_reclaim_locked(RCUHashMap *map)
+{
+	// Retirements from now on belong to a newer epoch
+	WriteULongPtrRelease(&(map->epoch), map->epoch + 1);
+
+	// Pairs with the fence in rmap_read_lock: either the reader announced
+	// before this scan or it will not see anything retired so far
+	MemoryBarrier();
+
+	ULONG_PTR oldest = map->epoch;
+
+	size_t i;
+	for (i = 0; i < RCU_HASH_MAP_MAX_READERS; i++)
+	{
+		ULONG_PTR epoch = ReadULongPtrAcquire(&(map->readers[i].epoch));
+
+		if (epoch != 0 && epoch < oldest)
+			oldest = epoch;
+	}
+
+	size_t kept = 0;
+
+	for (i = 0; i < map->retired_size; i++)
+	{
+		if (map->retired[i].epoch < oldest)
+			free(map->retired[i].pointer);
+		else
+			map->retired[kept++] = map->retired[i];
+	}
+
+	map->retired_size = kept;
+
+	return DS_OK;
+}
+
+// Frees every retired entry and table no reader can still be using
+Status rmap_reclaim(RCUHashMap *map)
+{
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	AcquireSRWLockExclusive(&(map->write_lock));
+
+	Status st = rmap_reclaim_locked(map);
+
+	ReleaseSRWLockExclusive(&(map->write_lock));
+
+	return st;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                            Insertion                                            |
+// +-------------------------------------------------------------------------------------------------+
+
+// Builds a table without tombstones, growing it if needed, and publishes it
+static Status rmap_rebuild(RCUHashMap *map)
+{
+	RCUHashMapTable *old_table = map->table;
+
+	size_t capacity = old_table->capacity;
+
+	while ((double)(map->size + 1) > (double)capacity * RCU_HASH_MAP_LOAD_FACTOR)
+		capacity *= 2;
+
+	RCUHashMapTable *table;
+
+	Status st = rmap_make_table(&table, capacity);
+
+	if (st != DS_OK)
+		return st;
+
+	size_t i, mask = capacity - 1;
+	for (i = 0; i < old_table->capacity; i++)
+	{
+		HashMapEntry *entry = old_table->slots[i];
+
+		if (entry == NULL || entry == RMAP_TOMBSTONE)
+			continue;
+
+		size_t pos = entry->hash & mask;
+
+		while (table->slots[pos] != NULL)
+			pos = (pos + 1) & mask;
+
+		table->slots[pos] = entry;
+
+		(table->used)++;
+	}
+
+	// Entries are shared by both tables, only the old slot array is retired
+	WritePointerRelease((void *volatile *)&(map->table), table);
+
+	return rmap_retire(map, old_table);
+}
+
+static Status rmap_insert_key(RCUHashMap *map, char *key, size_t length, bool terminated, int value)
+{
+	size_t hash;
+
+	Status st = rmap_hash_key(map, key, length, terminated, &hash);
+
+	if (st != DS_OK)
+		return st;
+
+	HashMapEntry *entry;
+
+	st = rmap_make_entry(&entry, key, length, hash, value);
+
+	if (st != DS_OK)
+		return st;
+
+	AcquireSRWLockExclusive(&(map->write_lock));
+
+	RCUHashMapTable *table = map->table;
+
+	bool found;
+
+	size_t pos = rmap_find_slot(table, key, length, hash, &found);
+
+	if (found)
+	{
+		HashMapEntry *old_entry = table->slots[pos];
+
+		WritePointerRelease((void *volatile *)&(table->slots[pos]), entry);
+
+		st = rmap_retire(map, old_entry);
+
+		ReleaseSRWLockExclusive(&(map->write_lock));
+
+		return st;
+	}
+
+	if (table->slots[pos] == NULL && (double)(table->used + 1) > (double)table->capacity * RCU_HASH_MAP_LOAD_FACTOR)
+	{
+		st = rmap_rebuild(map);
+
+		if (st != DS_OK)
+		{
+			ReleaseSRWLockExclusive(&(map->write_lock));
+
+			free(entry);
+
+			return st;
+		}
+
+		table = map->table;
+
+		pos = rmap_find_slot(table, key, length, hash, &found);
+	}
+
+	if (table->slots[pos] == NULL)
+		(table->used)++;
+
+	// The entry is fully written before it becomes reachable
+	WritePointerRelease((void *volatile *)&(table->slots[pos]), entry);
+
+	(map->size)++;
+
+	ReleaseSRWLockExclusive(&(map->write_lock));
+
+	return DS_OK;
+}
+
+Status rmap_insert(RCUHashMap *map, char *key, int value)
+{
+	if (map == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return rmap_insert_key(map, key, strlen(key), true, value);
+}
+
+Status rmap_insert_n(RCUHashMap *map, char *key, size_t length, int value)
+{
+	if (map == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return rmap_insert_key(map, key, length, false, value);
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Removal                                             |
+// +-------------------------------------------------------------------------------------------------+
+
+static Status rmap_remove_key(RCUHashMap *map, char *key, size_t length, bool terminated)
+{
+	size_t hash;
+
+	Status st = rmap_hash_key(map, key, length, terminated, &hash);
+
+	if (st != DS_OK)
+		return st;
+
+	AcquireSRWLockExclusive(&(map->write_lock));
+
+	RCUHashMapTable *table = map->table;
+
+	bool found;
+
+	size_t pos = rmap_find_slot(table, key, length, hash, &found);
+
+	if (!found)
+	{
+		ReleaseSRWLockExclusive(&(map->write_lock));
+
+		return DS_ERR_NOT_FOUND;
+	}
+
+	HashMapEntry *entry = table->slots[pos];
+
+	WritePointerRelease((void *volatile *)&(table->slots[pos]), RMAP_TOMBSTONE);
+
+	(map->size)--;
+
+	st = rmap_retire(map, entry);
+
+	ReleaseSRWLockExclusive(&(map->write_lock));
+
+	return st;
+}
+
+Status rmap_remove(RCUHashMap *map, char *key)
+{
+	if (map == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return rmap_remove_key(map, key, strlen(key), true);
+}
+
+Status rmap_remove_n(RCUHashMap *map, char *key, size_t length)
+{
+	if (map == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return rmap_remove_key(map, key, length, false);
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Resets                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+// Not thread safe, no other thread may be using the map
+Status rmap_delete_map(RCUHashMap **map)
+{
+	if ((*map) == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	RCUHashMapTable *table = (*map)->table;
+
+	size_t i;
+	for (i = 0; i < table->capacity; i++)
+	{
+		if (table->slots[i] != RMAP_TOMBSTONE)
+			free(table->slots[i]);
+	}
+
+	for (i = 0; i < (*map)->retired_size; i++)
+		free((*map)->retired[i].pointer);
+
+	free(table);
+	free((*map)->retired);
+	free((*map)->readers);
+	free(*map);
+
+	*map = NULL;
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Search                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+// Announces the epoch the reader is in. The fence orders the announcement
+// before any load from the table.
+static void rmap_read_lock(RCUHashMap *map, RCUHashMapReader *reader)
+{
+	WriteULongPtrRelease(&(reader->epoch), ReadULongPtrAcquire(&(map->epoch)));
+
+	MemoryBarrier();
+}
+
+static void rmap_read_unlock(RCUHashMapReader *reader)
+{
+	WriteULongPtrRelease(&(reader->epoch), 0);
+}
+
+static Status rmap_search_key(RCUHashMap *map, size_t reader, char *key, size_t length, bool terminated, int *value)
+{
+	if (reader >= RCU_HASH_MAP_MAX_READERS)
+		return DS_ERR_INVALID_ARGUMENT;
+
+	size_t hash;
+
+	Status st = rmap_hash_key(map, key, length, terminated, &hash);
+
+	if (st != DS_OK)
+		return st;
+
+	RCUHashMapReader *slot = map->readers + reader;
+
+	rmap_read_lock(map, slot);
+
+	RCUHashMapTable *table = ReadPointerAcquire((void *volatile *)&(map->table));
+
+	size_t mask = table->capacity - 1;
+	size_t pos = hash & mask;
+
+	st = DS_ERR_NOT_FOUND;
+
+	while (true)
+	{
+		HashMapEntry *entry = ReadPointerAcquire((void *volatile *)&(table->slots[pos]));
+
+		if (entry == NULL)
+			break;
+
+		if (entry != RMAP_TOMBSTONE && entry->hash == hash && entry->length == length && memcmp(entry->key, key, length) == 0)
+		{
+			*value = entry->value;
+
+			st = DS_OK;
+
+			break;
+		}
+
+		pos = (pos + 1) & mask;
+	}
+
+	rmap_read_unlock(slot);
+
+	return st;
+}
+
+Status rmap_search(RCUHashMap *map, size_t reader, char *key, int *value)
+{
+	*value = 0;
+
+	if (map == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return rmap_search_key(map, reader, key, strlen(key), true, value);
+}
+
+Status rmap_search_n(RCUHashMap *map, size_t reader, char *key, size_t length, int *value)
+{
+	*value = 0;
+
+	if (map == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return rmap_search_key(map, reader, key, length, false, value);
+}
+
+bool rmap_contains(RCUHashMap *map, size_t reader, char *key)
+{
+	int value;
+
+	return rmap_search(map, reader, key, &value) == DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Counts                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+Status rmap_count_entries(RCUHashMap *map, size_t *result)
+{
+	*result = 0;
+
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	AcquireSRWLockShared(&(map->write_lock));
+
+	*result = map->size;
+
+	ReleaseSRWLockShared(&(map->write_lock));
+
+	return DS_OK;
+}
+
+// Entries and tables unlinked but not yet freed
+Status rmap_count_retired(RCUHashMap *map, size_t *result)
+{
+	*result = 0;
+
+	if (map == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	AcquireSRWLockShared(&(map->write_lock));
+
+	*result = map->retired_size;
+
+	ReleaseSRWLockShared(&(map->write_lock));
+
+	return DS_OK;
+}
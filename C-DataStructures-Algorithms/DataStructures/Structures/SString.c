@@ -9,470 +9,482 @@
  */
 
 #include "SString.h"
+#include "Scan.h"
 
 // +-------------------------------------------------------------------------------------------------+
-// |                                          Initializers                                           |
+// |                                            Helpers                                              |
 // +-------------------------------------------------------------------------------------------------+
 
-/**
-* Initializes the string structure
-*
-*
-*/
-Status str_init(String **str)
+static bool str_is_small(String *str)
 {
-	(*str) = malloc(sizeof(String));
+	return str->buffer == str->small;
+}
 
-	if (!(*str))
-		return DS_ERR_ALLOC;
+// Grows a flat buffer geometrically until it holds length characters and
+// the terminator, moving it out of the inline buffer if needed
+static Status str_reserve(String *str, size_t length)
+{
+	if (length < str->capacity)
+		return DS_OK;
 
-	(*str)->buffer = malloc(sizeof(char) * STRING_INIT_SIZE);
+	size_t capacity = str->capacity;
 
-	if (!((*str)->buffer))
-		return DS_ERR_ALLOC;
+	while (capacity <= length)
+		capacity *= str->growth_rate;
 
-	(*str)->buffer[0] = '\0';
+	char *buffer;
 
-	(*str)->capacity = STRING_INIT_SIZE;
-	(*str)->growth_rate = STRING_GROW_RATE;
+	if (str_is_small(str))
+	{
+		buffer = malloc(sizeof(char) * capacity);
 
-	(*str)->len = 0;
+		if (buffer)
+			memcpy(buffer, str->small, sizeof(char) * STRING_INLINE_SIZE);
+	}
+	else
+		buffer = realloc(str->buffer, sizeof(char) * capacity);
+
+	if (!buffer)
+		return DS_ERR_ALLOC;
+
+	str->buffer = buffer;
+	str->capacity = capacity;
 
 	return DS_OK;
 }
 
-/**
- * Initializes a null-terminated string
- *
- *
- */
-Status str_make(String **str, char *string)
+static Status str_piece_reserve(StringPieceTable *table, size_t count)
 {
-	size_t length = str_len(string);
-
-	if (length == 0)
-		return DS_ERR_INVALID_ARGUMENT;
+	if (table->count + count <= table->capacity)
+		return DS_OK;
 
-	Status st = str_init(str);
+	size_t capacity = table->capacity * 2;
 
-	if (st != DS_OK)
-		return st;
+	while (capacity < table->count + count)
+		capacity *= 2;
 
-	if ((*str)->capacity <= length)
-	{
-		size_t new_capacity = STRING_INIT_SIZE;
+	StringPiece *pieces = realloc(table->pieces, sizeof(StringPiece) * capacity);
 
-		while (new_capacity <= length)
-		{
-			new_capacity *= STRING_GROW_RATE;
-		}
-
-		char *new_buffer = realloc((*str)->buffer, sizeof(char) * new_capacity);
+	if (!pieces)
+		return DS_ERR_ALLOC;
 
-		if (!new_buffer)
-		{
-			(*str)->capacity = STRING_INIT_SIZE;
+	table->pieces = pieces;
+	table->capacity = capacity;
 
-			return DS_ERR_ALLOC;
-		}
+	return DS_OK;
+}
 
-		(*str)->buffer = new_buffer;
+// Finds the piece that holds the character at index, or count when index is
+// the length of the string, walking from the piece found last time
+static size_t str_piece_find(StringPieceTable *table, size_t index, size_t *start)
+{
+	size_t i = table->cursor, position = table->cursor_start;
 
-		(*str)->capacity = new_capacity;
+	while (i > 0 && position > index)
+	{
+		i--;
+		position -= table->pieces[i].length;
 	}
 
-	(*str)->len = length;
-
-	size_t i;
-	for (i = 0; i < length; i++)
+	while (i < table->count && position + table->pieces[i].length <= index)
 	{
-		(*str)->buffer[i] = string[i];
+		position += table->pieces[i].length;
+		i++;
 	}
 
-	(*str)->buffer[length] = '\0';
+	table->cursor = i;
+	table->cursor_start = position;
 
-	return DS_OK;
-}
+	*start = position;
 
-// +-------------------------------------------------------------------------------------------------+
-// |                                            Getters                                              |
-// +-------------------------------------------------------------------------------------------------+
+	return i;
+}
 
-Status str_get_string(String *str, char **result)
+// Splits the piece that holds index in two, if needed, and returns the
+// piece that starts at index
+static Status str_piece_split(StringPieceTable *table, size_t index, size_t *result)
 {
-	(*result) = NULL;
+	size_t start, i = str_piece_find(table, index, &start);
 
-	if (str == NULL)
-		return DS_ERR_NULL_POINTER;
+	if (i == table->count || start == index)
+	{
+		*result = i;
 
-	if (str_buffer_empty(str))
-		return DS_ERR_INVALID_OPERATION;
+		return DS_OK;
+	}
 
-	char *string = malloc(sizeof(char) * (str->len + 1));
+	Status st = str_piece_reserve(table, 1);
 
-	if (!string)
-		return DS_ERR_ALLOC;
+	if (st != DS_OK)
+		return st;
 
-	size_t i;
-	for (i = 0; i < str->len; i++)
-		string[i] = str->buffer[i];
+	StringPiece *pieces = table->pieces;
 
-	string[str->len] = '\0';
+	memmove(pieces + i + 2, pieces + i + 1, sizeof(StringPiece) * (table->count - i - 1));
 
-	(*result) = string;
+	pieces[i + 1] = pieces[i];
+	pieces[i + 1].start += index - start;
+	pieces[i + 1].length -= index - start;
+	pieces[i].length = index - start;
+
+	table->count++;
+	table->cursor = i + 1;
+	table->cursor_start = index;
+
+	*result = i + 1;
 
 	return DS_OK;
 }
 
-// +-------------------------------------------------------------------------------------------------+
-// |                                            Insertion                                            |
-// +-------------------------------------------------------------------------------------------------+
-
-Status str_push_char_front(String *str, char ch)
+// Appends the characters to the added buffer and links them in a piece at
+// index, or extends the piece before it when it ends where they were
+// appended, as it does while typing
+static Status str_piece_insert(String *str, size_t index, const char *chars, size_t length)
 {
-	if (str == NULL)
-		return DS_ERR_NULL_POINTER;
-
-	Status st;
+	StringPieceTable *table = str->pieces;
 
-	if (str_buffer_full(str))
+	if (table->added_len + length > table->added_capacity)
 	{
-		st = str_realloc(str);
+		size_t capacity = table->added_capacity * 2;
 
-		if (st != DS_OK)
-			return st;
-	}
+		if (capacity < table->added_len + length)
+			capacity = table->added_len + length;
 
-	size_t i;
-	for (i = str->len; i > 0; i--)
-	{
-		str->buffer[i] = str->buffer[i - 1];
-	}
+		char *added = realloc(table->added, sizeof(char) * capacity);
 
-	str->buffer[0] = ch;
+		if (!added)
+			return DS_ERR_ALLOC;
 
-	(str->len)++;
+		table->added = added;
+		table->added_capacity = capacity;
+	}
 
-	str->buffer[str->len] = '\0';
+	size_t offset = table->added_len, i;
 
-	return DS_OK;
-}
+	memcpy(table->added + offset, chars, sizeof(char) * length);
 
-Status str_push_char_at(String *str, char ch, size_t index)
-{
-	if (str == NULL)
-		return DS_ERR_NULL_POINTER;
+	table->added_len += length;
 
-	if (index > str->len)
-		return DS_ERR_INVALID_POSITION;
+	Status st = str_piece_split(table, index, &i);
 
-	Status st;
+	if (st != DS_OK)
+		return st;
+
+	StringPiece *prev = i > 0 ? table->pieces + i - 1 : NULL;
 
-	if (index == 0)
+	if (prev != NULL && prev->added && prev->start + prev->length == offset)
 	{
-		st = str_push_char_front(str, ch);
+		table->cursor = i - 1;
+		table->cursor_start = index - prev->length;
 
-		if (st != DS_OK)
-			return st;
+		prev->length += length;
 	}
-	else if (index == str->len)
+	else
 	{
-		st = str_push_char_front(str, ch);
+		st = str_piece_reserve(table, 1);
 
 		if (st != DS_OK)
 			return st;
-	}
-	else
-	{
-		if (str_buffer_full(str))
-		{
-			st = str_realloc(str);
 
-			if (st != DS_OK)
-				return st;
-		}
+		memmove(table->pieces + i + 1, table->pieces + i, sizeof(StringPiece) * (table->count - i));
 
-		size_t i;
-		for (i = str->len; i > index; i--)
-		{
-			str->buffer[i] = str->buffer[i - 1];
-		}
+		table->pieces[i].start = offset;
+		table->pieces[i].length = length;
+		table->pieces[i].added = true;
 
-		str->buffer[index] = ch;
+		table->count++;
+		table->cursor = i;
+		table->cursor_start = index;
+	}
 
-		(str->len)++;
+	str->len += length;
 
-		str->buffer[str->len] = '\0';
-	}
+	if (table->count > STRING_PIECE_MAX)
+		return str_flatten(str);
 
 	return DS_OK;
 }
 
-Status str_push_char_back(String *str, char ch)
+static Status str_piece_remove(String *str, size_t index, size_t length)
 {
-	if (str == NULL)
-		return DS_ERR_NULL_POINTER;
+	StringPieceTable *table = str->pieces;
 
-	Status st;
+	size_t first, last;
 
-	if (str_buffer_full(str))
-	{
-		st = str_realloc(str);
+	Status st = str_piece_split(table, index, &first);
 
-		if (st != DS_OK)
-			return st;
-	}
+	if (st != DS_OK)
+		return st;
 
-	str->buffer[str->len] = ch;
+	st = str_piece_split(table, index + length, &last);
 
-	(str->len)++;
+	if (st != DS_OK)
+		return st;
 
-	str->buffer[str->len] = '\0';
+	memmove(table->pieces + first, table->pieces + last, sizeof(StringPiece) * (table->count - last));
+
+	table->count -= last - first;
+	table->cursor = first;
+	table->cursor_start = index;
+
+	str->len -= length;
+
+	if (table->count > STRING_PIECE_MAX)
+		return str_flatten(str);
 
 	return DS_OK;
 }
 
-Status str_push_front(String *str, char *ch)
-{
-	if (str == NULL || ch == NULL)
-		return DS_ERR_NULL_POINTER;
+// Every insertion and removal goes through these two, which either shift
+// the characters of a flat buffer or edit the piece table
 
-	size_t len = str_len(ch);
+static Status str_insert(String *str, size_t index, const char *chars, size_t length)
+{
+	if (str->pieces != NULL)
+		return str_piece_insert(str, index, chars, length);
 
-	if (len == 0)
-		return DS_ERR_INVALID_ARGUMENT;
+	Status st = str_reserve(str, str->len + length);
 
-	Status st;
+	if (st != DS_OK)
+		return st;
 
-	while (!str_buffer_fits(str, len))
-	{
-		st = str_realloc(str);
+	// Also moves the terminator
+	memmove(str->buffer + index + length, str->buffer + index, sizeof(char) * (str->len - index + 1));
+	memcpy(str->buffer + index, chars, sizeof(char) * length);
 
-		if (st != DS_OK)
-			return st;
-	}
+	str->len += length;
 
-	size_t i;
-	for (i = str->len; i > 0; i--)
-	{
-		str->buffer[i + len - 1] = str->buffer[i - 1];
-	}
+	return DS_OK;
+}
 
-	for (i = 0; i < len; i++)
-	{
-		str->buffer[i] = ch[i];
-	}
+static Status str_cut(String *str, size_t index, size_t length)
+{
+	if (str->pieces != NULL)
+		return str_piece_remove(str, index, length);
 
-	str->len += len;
+	memmove(str->buffer + index, str->buffer + index + length, sizeof(char) * (str->len - index - length + 1));
 
-	str->buffer[str->len] = '\0';
+	str->len -= length;
 
 	return DS_OK;
 }
 
-Status str_push_at(String *str, char *ch, size_t index)
+// Makes buffer hold the whole string, for functions that read it directly
+static bool str_contiguous(String *str)
 {
-	if (str == NULL || ch == NULL)
-		return DS_ERR_NULL_POINTER;
+	return str->pieces == NULL || str_flatten(str) == DS_OK;
+}
 
-	Status st;
+// Position of the first occurrence of chars at or after from
+static Status str_search(String *str, const char *chars, size_t length, size_t from, size_t *pos)
+{
+	if (!str_contiguous(str))
+		return DS_ERR_ALLOC;
 
-	if (index == 0)
-	{
-		st = str_push_front(str, ch);
+	if (from > str->len || length > str->len - from)
+		return DS_ERR_NOT_FOUND;
 
-		if (st != DS_OK)
-			return st;
-	}
-	else if (index == str->len)
-	{
-		st = str_push_back(str, ch);
+	size_t found = scan_find_bytes(str->buffer + from, str->len - from, chars, length);
 
-		if (st != DS_OK)
-			return st;
-	}
-	else
-	{
-		size_t len = str_len(ch);
+	if (found > str->len - from - length)
+		return DS_ERR_NOT_FOUND;
 
-		if (len == 0)
-			return DS_ERR_INVALID_ARGUMENT;
+	*pos = from + found;
 
-		while (!str_buffer_fits(str, len))
-		{
-			st = str_realloc(str);
+	return DS_OK;
+}
 
-			if (st != DS_OK)
-				return st;
-		}
+// +-------------------------------------------------------------------------------------------------+
+// |                                          Initializers                                           |
+// +-------------------------------------------------------------------------------------------------+
 
-		size_t i, j;
-		for (i = str->len; i >= index; i--)
-		{
-			str->buffer[i + len] = str->buffer[i];
-		}
+/**
+* Initializes the string structure
+*
+*
+*/
+Status str_init(String **str)
+{
+	(*str) = malloc(sizeof(String));
 
-		for (i = index, j = 0; i < index + len; i++, j++)
-		{
-			str->buffer[i] = ch[j];
-		}
+	if (!(*str))
+		return DS_ERR_ALLOC;
 
-		str->len += len;
+	(*str)->buffer = (*str)->small;
 
-		str->buffer[str->len] = '\0';
-	}
+	(*str)->buffer[0] = '\0';
+
+	(*str)->capacity = STRING_INLINE_SIZE;
+	(*str)->growth_rate = STRING_GROW_RATE;
+	(*str)->pieces = NULL;
+
+	(*str)->len = 0;
 
 	return DS_OK;
 }
 
-Status str_push_back(String *str, char *ch)
+/**
+ * Initializes a null-terminated string
+ *
+ *
+ */
+Status str_make(String **str, char *string)
 {
-	if (str == NULL || ch == NULL)
-		return DS_ERR_NULL_POINTER;
-
-	size_t len = str_len(ch);
+	size_t length = str_len(string);
 
-	if (len == 0)
+	if (length == 0)
 		return DS_ERR_INVALID_ARGUMENT;
 
-	Status st;
+	Status st = str_init(str);
 
-	while (!str_buffer_fits(str, len))
-	{
-		st = str_realloc(str);
+	if (st != DS_OK)
+		return st;
 
-		if (st != DS_OK)
-			return st;
-	}
+	return str_insert(*str, 0, string, length);
+}
 
-	size_t i, j;
-	for (i = str->len, j = 0; i < len + str->len; i++, j++)
-	{
-		str->buffer[i] = ch[j];
-	}
+// +-------------------------------------------------------------------------------------------------+
+// |                                            Getters                                              |
+// +-------------------------------------------------------------------------------------------------+
 
-	str->len += len;
+Status str_get_string(String *str, char **result)
+{
+	(*result) = NULL;
 
-	str->buffer[str->len] = '\0';
+	if (str == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (str_buffer_empty(str))
+		return DS_ERR_INVALID_OPERATION;
+
+	if (!str_contiguous(str))
+		return DS_ERR_ALLOC;
+
+	char *string = malloc(sizeof(char) * (str->len + 1));
+
+	if (!string)
+		return DS_ERR_ALLOC;
+
+	memcpy(string, str->buffer, sizeof(char) * str->len);
+
+	string[str->len] = '\0';
+
+	(*result) = string;
 
 	return DS_OK;
 }
 
-Status str_prepend(String *str1, String *str2)
+// +-------------------------------------------------------------------------------------------------+
+// |                                            Insertion                                            |
+// +-------------------------------------------------------------------------------------------------+
+
+Status str_push_char_front(String *str, char ch)
 {
-	if (str1 == NULL || str2 == NULL)
+	if (str == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	if (str_buffer_empty(str2))
-		return DS_OK;
-
-	Status st;
-
-	while (!str_buffer_fits(str1, str2->len))
-	{
-		st = str_realloc(str1);
-
-		if (st != DS_OK)
-			return st;
-	}
+	return str_insert(str, 0, &ch, 1);
+}
 
-	size_t i;
-	for (i = str1->len; i > 0; i--)
-	{
-		str1->buffer[i + str2->len - 1] = str1->buffer[i - 1];
-	}
+Status str_push_char_at(String *str, char ch, size_t index)
+{
+	if (str == NULL)
+		return DS_ERR_NULL_POINTER;
 
-	for (i = 0; i < str2->len; i++)
-	{
-		str1->buffer[i] = str2->buffer[i];
-	}
+	if (index > str->len)
+		return DS_ERR_INVALID_POSITION;
 
-	str1->len += str2->len;
+	return str_insert(str, index, &ch, 1);
+}
 
-	str1->buffer[str1->len] = '\0';
+Status str_push_char_back(String *str, char ch)
+{
+	if (str == NULL)
+		return DS_ERR_NULL_POINTER;
 
-	return DS_OK;
+	return str_insert(str, str->len, &ch, 1);
 }
 
-Status str_add(String *str1, String *str2, size_t index)
+Status str_push_front(String *str, char *ch)
 {
-	if (str1 == NULL || str2 == NULL)
+	if (str == NULL || ch == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	Status st;
+	return str_push_at(str, ch, 0);
+}
 
-	if (index == 0)
-	{
-		st = str_prepend(str1, str2);
+Status str_push_at(String *str, char *ch, size_t index)
+{
+	if (str == NULL || ch == NULL)
+		return DS_ERR_NULL_POINTER;
 
-		if (st != DS_OK)
-			return st;
-	}
-	else if (index == str1->len)
-	{
-		st = str_append(str1, str2);
+	if (index > str->len)
+		return DS_ERR_INVALID_POSITION;
 
-		if (st != DS_OK)
-			return st;
-	}
-	else
-	{
-		while (!str_buffer_fits(str1, str2->len))
-		{
-			st = str_realloc(str1);
+	size_t len = str_len(ch);
 
-			if (st != DS_OK)
-				return st;
-		}
+	if (len == 0)
+		return DS_ERR_INVALID_ARGUMENT;
 
-		size_t i, j;
-		for (i = str1->len; i >= index; i--)
-		{
-			str1->buffer[i + str2->len] = str1->buffer[i];
-		}
+	return str_insert(str, index, ch, len);
+}
 
-		for (i = index, j = 0; i < index + str2->len; i++, j++)
-		{
-			str1->buffer[i] = str2->buffer[j];
-		}
+Status str_push_back(String *str, char *ch)
+{
+	if (str == NULL || ch == NULL)
+		return DS_ERR_NULL_POINTER;
 
-		str1->len += str2->len;
+	return str_push_at(str, ch, str->len);
+}
 
-		str1->buffer[str1->len] = '\0';
-	}
+Status str_prepend(String *str1, String *str2)
+{
+	if (str1 == NULL || str2 == NULL)
+		return DS_ERR_NULL_POINTER;
 
-	return DS_OK;
+	return str_add(str1, str2, 0);
 }
 
-Status str_append(String *str1, String *str2)
+Status str_add(String *str1, String *str2, size_t index)
 {
 	if (str1 == NULL || str2 == NULL)
 		return DS_ERR_NULL_POINTER;
 
+	if (index > str1->len)
+		return DS_ERR_INVALID_POSITION;
+
 	if (str_buffer_empty(str2))
 		return DS_OK;
 
-	Status st;
+	if (!str_contiguous(str2))
+		return DS_ERR_ALLOC;
 
-	while (!str_buffer_fits(str1, str2->len))
+	// Inserting a string into itself would read from a buffer that moves
+	if (str1 == str2)
 	{
-		st = str_realloc(str1);
+		char *copy = malloc(sizeof(char) * str2->len);
 
-		if (st != DS_OK)
-			return st;
-	}
+		if (!copy)
+			return DS_ERR_ALLOC;
 
-	size_t i, j;
-	for (i = str1->len, j = 0; i < str1->len + str2->len; i++, j++)
-	{
-		str1->buffer[i] = str2->buffer[j];
+		memcpy(copy, str2->buffer, sizeof(char) * str2->len);
+
+		Status st = str_insert(str1, index, copy, str2->len);
+
+		free(copy);
+
+		return st;
 	}
 
-	str1->len += str2->len;
+	return str_insert(str1, index, str2->buffer, str2->len);
+}
 
-	str1->buffer[str1->len] = '\0';
+Status str_append(String *str1, String *str2)
+{
+	if (str1 == NULL || str2 == NULL)
+		return DS_ERR_NULL_POINTER;
 
-	return DS_OK;
+	return str_add(str1, str2, str1->len);
 }
 
 // +-------------------------------------------------------------------------------------------------+
@@ -487,17 +499,7 @@ Status str_pop_char_front(String *str)
 	if (str_buffer_empty(str))
 		return DS_ERR_INVALID_OPERATION;
 
-	size_t i;
-	for (i = 0; i < str->len; i++)
-	{
-		str->buffer[i] = str->buffer[i + 1];
-	}
-
-	(str->len)--;
-
-	str->buffer[str->len] = '\0';
-
-	return DS_OK;
+	return str_cut(str, 0, 1);
 }
 
 Status str_pop_char_at(String *str, size_t index)
@@ -511,36 +513,7 @@ Status str_pop_char_at(String *str, size_t index)
 	if (index >= str->len)
 		return DS_ERR_INVALID_POSITION;
 
-	Status st;
-
-	if (index == 0)
-	{
-		st = str_pop_char_front(str);
-
-		if (st != DS_OK)
-			return st;
-	}
-	else if (index == str->len - 1)
-	{
-		st = str_pop_char_back(str);
-
-		if (st != DS_OK)
-			return st;
-	}
-	else
-	{
-		size_t i;
-		for (i = index; i < str->len; i++)
-		{
-			str->buffer[i] = str->buffer[i + 1];
-		}
-
-		(str->len)--;
-
-		str->buffer[str->len] = '\0';
-	}
-
-	return DS_OK;
+	return str_cut(str, index, 1);
 }
 
 Status str_pop_char_back(String *str)
@@ -551,14 +524,23 @@ Status str_pop_char_back(String *str)
 	if (str_buffer_empty(str))
 		return DS_ERR_INVALID_OPERATION;
 
-	(str->len)--;
+	return str_cut(str, str->len - 1, 1);
+}
 
-	str->buffer[str->len] = '\0';
+Status str_remove(String *str, size_t from, size_t to)
+{
+	if (str == NULL)
+		return DS_ERR_NULL_POINTER;
 
-	return DS_OK;
-}
+	if (from > to)
+		return DS_ERR_INVALID_ARGUMENT;
 
-//Status str_remove(String *str, size_t from, size_t to)
+	if (to >= str->len)
+		return DS_ERR_INVALID_POSITION;
+
+	// 'from' and 'to' are inclusive
+	return str_cut(str, from, to - from + 1);
+}
 
 //Status str_slice(String *str, size_t from, size_t to, String *result)
 
@@ -577,6 +559,9 @@ Status str_display(String *str)
 		return DS_OK;
 	}
 
+	if (!str_contiguous(str))
+		return DS_ERR_ALLOC;
+
 	printf("\nString\n%s\n", str->buffer);
 
 	return DS_OK;
@@ -592,6 +577,9 @@ Status str_display_raw(String *str)
 	if (str_buffer_empty(str))
 		return DS_OK;
 
+	if (!str_contiguous(str))
+		return DS_ERR_ALLOC;
+
 	printf("%s", str->buffer);
 
 	return DS_OK;
@@ -606,7 +594,15 @@ Status str_delete(String **str)
 	if ((*str) == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	free((*str)->buffer);
+	if ((*str)->pieces != NULL)
+	{
+		free((*str)->pieces->pieces);
+		free((*str)->pieces->added);
+		free((*str)->pieces);
+	}
+
+	if (!str_is_small(*str))
+		free((*str)->buffer);
 
 	free(*str);
 
@@ -643,6 +639,14 @@ Status str_clear(String *str)
 
 	str->buffer[0] = '\0';
 
+	if (str->pieces != NULL)
+	{
+		str->pieces->count = 0;
+		str->pieces->added_len = 0;
+		str->pieces->cursor = 0;
+		str->pieces->cursor_start = 0;
+	}
+
 	return DS_OK;
 }
 
@@ -658,6 +662,9 @@ Status str_front(String *str, char *result)
 	if (str_buffer_empty(str))
 		return DS_ERR_INVALID_OPERATION;
 
+	if (!str_contiguous(str))
+		return DS_ERR_ALLOC;
+
 	*result = str->buffer[0];
 
 	return DS_OK;
@@ -671,6 +678,9 @@ Status str_back(String *str, char *result)
 	if (str_buffer_empty(str))
 		return DS_ERR_INVALID_OPERATION;
 
+	if (!str_contiguous(str))
+		return DS_ERR_ALLOC;
+
 	*result = str->buffer[str->len - 1];
 
 	return DS_OK;
@@ -715,6 +725,9 @@ bool str_greater(String *str1, String *str2)
 	if (str1 == NULL || str2 == NULL)
 		return false;
 
+	if (!str_contiguous(str1) || !str_contiguous(str2))
+		return false;
+
 	size_t i, len = (str1->len > str2->len) ? str2->len : str1->len;
 	
 	for (i = 0; i < len; i++)
@@ -737,6 +750,9 @@ bool str_equals(String *str1, String *str2)
 	if (str1 == NULL || str2 == NULL)
 		return false;
 
+	if (!str_contiguous(str1) || !str_contiguous(str2))
+		return false;
+
 	if (str1->len != str2->len)
 		return false;
 
@@ -754,6 +770,9 @@ bool str_lesser(String *str1, String *str2)
 	if (str1 == NULL || str2 == NULL)
 		return false;
 
+	if (!str_contiguous(str1) || !str_contiguous(str2))
+		return false;
+
 	size_t i, len = (str1->len > str2->len) ? str2->len : str1->len;
 
 	for (i = 0; i < len; i++)
@@ -775,6 +794,9 @@ bool str_equals_str(String *str, char *string)
 	if (str == NULL || string == NULL)
 		return false;
 
+	if (!str_contiguous(str))
+		return false;
+
 	size_t len = str_len(string);
 
 	if (str->len != len)
@@ -789,14 +811,57 @@ bool str_equals_str(String *str, char *string)
 }
 
 // Returns true if str1 has substring str2
-//bool str_substring(String *str1, String *str2)
+bool str_substring(String *str1, String *str2)
+{
+	size_t pos;
+
+	return str_find_substring(str1, str2, &pos) == DS_OK;
+}
 
 // Returns true if str has substring ch
-//bool str_substr(String *str, char *ch)
+bool str_substr(String *str, char *ch)
+{
+	size_t pos;
+
+	return str_find_substr(str, ch, &pos) == DS_OK;
+}
+
+// Position of the first occurrence of key in str. An empty key is found at
+// position 0.
+Status str_find_substring(String *str, String *key, size_t *pos)
+{
+	if (str == NULL || key == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (!str_contiguous(key))
+		return DS_ERR_ALLOC;
+
+	return str_search(str, key->buffer, key->len, 0, pos);
+}
+
+Status str_find_substr(String *str, char *string, size_t *pos)
+{
+	if (str == NULL || string == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return str_search(str, string, str_len(string), 0, pos);
+}
+
+// Visits every occurrence of string in str, including overlapping ones, in
+// order of position. cursor must start at 0 and str must not be modified
+// until the iteration ends.
+bool str_find_next(String *str, char *string, size_t *cursor, size_t *pos)
+{
+	if (str == NULL || string == NULL)
+		return false;
 
-//Status str_find_substring(String *str, String *key, size_t *pos)
+	if (str_search(str, string, str_len(string), *cursor, pos) != DS_OK)
+		return false;
+
+	*cursor = *pos + 1;
 
-//Status str_find_substr(String *str, char *string, size_t *pos)
+	return true;
+}
 
 //Status str_reverse(String *str)
 
@@ -811,22 +876,20 @@ Status str_copy(String *str, String **result)
 	if (str == NULL)
 		return DS_ERR_NULL_POINTER;
 
+	if (!str_contiguous(str))
+		return DS_ERR_ALLOC;
+
 	Status st = str_init(result);
 
 	if (st != DS_OK)
 		return st;
 
-	while (!str_buffer_fits(*result, str->len))
-	{
-		st = str_realloc(*result);
+	st = str_reserve(*result, str->len);
 
-		if (st != DS_OK)
-			return st;
-	}
-
-	char *s1 = str->buffer, *s2 = (*result)->buffer;
+	if (st != DS_OK)
+		return st;
 
-	while (*s2++ = *s1++);
+	memcpy((*result)->buffer, str->buffer, sizeof(char) * (str->len + 1));
 
 	(*result)->len = str->len;
 
@@ -855,6 +918,9 @@ Status str_case_upper(String *str)
 	if (str_buffer_empty(str))
 		return DS_ERR_INVALID_OPERATION;
 
+	if (!str_contiguous(str))
+		return DS_ERR_ALLOC;
+
 	char ch;
 
 	size_t i;
@@ -877,6 +943,9 @@ Status str_case_lower(String *str)
 	if (str_buffer_empty(str))
 		return DS_ERR_INVALID_OPERATION;
 
+	if (!str_contiguous(str))
+		return DS_ERR_ALLOC;
+
 	char ch;
 
 	size_t i;
@@ -919,20 +988,128 @@ Status str_realloc(String *str)
 	if (str == NULL)
 		return DS_ERR_NULL_POINTER;
 
-	str->capacity *= str->growth_rate;
+	return str_reserve(str, str->capacity);
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                          Piece Table                                            |
+// +-------------------------------------------------------------------------------------------------+
+
+Status str_set_piece_table(String *str, bool enabled)
+{
+	if (str == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (!enabled)
+	{
+		if (str->pieces == NULL)
+			return DS_OK;
+
+		Status st = str_flatten(str);
+
+		if (st != DS_OK)
+			return st;
+
+		free(str->pieces->pieces);
+		free(str->pieces->added);
+		free(str->pieces);
+
+		str->pieces = NULL;
+
+		return DS_OK;
+	}
+
+	if (str->pieces != NULL)
+		return DS_OK;
 
-	char *new_buffer = realloc(str->buffer, sizeof(char) * str->capacity);
+	StringPieceTable *table = malloc(sizeof(StringPieceTable));
 
-	if (!new_buffer)
+	if (!table)
+		return DS_ERR_ALLOC;
+
+	table->capacity = 8;
+	table->pieces = malloc(sizeof(StringPiece) * table->capacity);
+
+	if (!table->pieces)
 	{
-		str->capacity /= str->growth_rate;
+		free(table);
 
 		return DS_ERR_ALLOC;
 	}
 
-	str->buffer = new_buffer;
+	// The whole string is the first piece of the original buffer
+	table->pieces[0].start = 0;
+	table->pieces[0].length = str->len;
+	table->pieces[0].added = false;
+
+	table->count = str->len > 0;
+	table->added = NULL;
+	table->added_len = 0;
+	table->added_capacity = 0;
+	table->cursor = 0;
+	table->cursor_start = 0;
 
-	str->buffer[str->len] = '\0';
+	str->pieces = table;
 
 	return DS_OK;
-}
\ No newline at end of file
+}
+
+// Copies the pieces into a new buffer, which becomes the only piece. The
+// string stays in piece table mode.
+Status str_flatten(String *str)
+{
+	if (str == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	StringPieceTable *table = str->pieces;
+
+	if (table == NULL)
+		return DS_OK;
+
+	// Already a prefix of the original buffer
+	if (table->count == 0 || (table->count == 1 && !table->pieces[0].added && table->pieces[0].start == 0))
+	{
+		str->buffer[str->len] = '\0';
+
+		return DS_OK;
+	}
+
+	size_t capacity = str->capacity;
+
+	while (capacity <= str->len)
+		capacity *= str->growth_rate;
+
+	char *buffer = malloc(sizeof(char) * capacity);
+
+	if (!buffer)
+		return DS_ERR_ALLOC;
+
+	size_t i, position = 0;
+	for (i = 0; i < table->count; i++)
+	{
+		StringPiece *piece = table->pieces + i;
+
+		memcpy(buffer + position, (piece->added ? table->added : str->buffer) + piece->start, sizeof(char) * piece->length);
+
+		position += piece->length;
+	}
+
+	buffer[str->len] = '\0';
+
+	if (!str_is_small(str))
+		free(str->buffer);
+
+	str->buffer = buffer;
+	str->capacity = capacity;
+
+	table->pieces[0].start = 0;
+	table->pieces[0].length = str->len;
+	table->pieces[0].added = false;
+
+	table->count = 1;
+	table->added_len = 0;
+	table->cursor = 0;
+	table->cursor_start = 0;
+
+	return DS_OK;
+}
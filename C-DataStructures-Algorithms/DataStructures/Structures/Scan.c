@@ -0,0 +1,1310 @@
+/**
+ * @file Scan.c
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Source file for vectorized scans over buffers of integers
+ *
+ * Each integer kernel works on four vectors per iteration so that loads
+ * and comparisons of independent registers overlap, and leaves the
+ * elements that do not fill those four vectors to the scalar kernel.
+ *
+ * Substrings are searched with the filter of Wojciech Mula, which compares
+ * the needle only where its first and last characters match. When too many
+ * of those candidates fail the search continues with the Two-Way algorithm
+ * of Crochemore and Perrin, so it stays linear for any needle.
+ *
+ */
+
+#include <Windows.h>
+#include <intrin.h>
+#include <immintrin.h>
+#include "Scan.h"
+#include "Cpu.h"
+
+// Elements counted per block, small enough that no 32-bit lane overflows
+#define SCAN_COUNT_BLOCK ((size_t)1 << 30)
+
+// The byte kernels give up for Two-Way once the candidates that failed,
+// times the needle length, exceed this many characters per position of
+// data plus a fixed allowance
+#define SCAN_FILTER_WORK 2
+#define SCAN_FILTER_SLACK 4096
+
+// Returned by scan_bytes_verify when no candidate matches
+#define SCAN_NO_MATCH SIZE_MAX
+
+// Hash of the character at p and the one before it, for the skip table of
+// Two-Way
+#define SCAN_HASH2(p) ((size_t)((p)[0] - ((size_t)(p)[-1] << 3)) & 255)
+
+typedef size_t (*scan_count_t)(const int *data, size_t size, int value);
+typedef size_t (*scan_find_t)(const int *data, size_t size, int value);
+typedef int (*scan_reduce_t)(const int *data, size_t size);
+typedef size_t (*scan_remove_t)(int *data, size_t size, int value);
+typedef size_t (*scan_bytes_t)(const char *data, size_t size, const char *needle, size_t length, size_t *scanned);
+
+static ScanKernel scan_kernel = SCAN_KERNEL_AUTO;
+static scan_count_t scan_count_kernel = NULL;
+static scan_find_t scan_first_kernel = NULL;
+static scan_find_t scan_last_kernel = NULL;
+static scan_reduce_t scan_max_kernel = NULL;
+static scan_reduce_t scan_min_kernel = NULL;
+static scan_remove_t scan_remove_kernel = NULL;
+static scan_bytes_t scan_bytes_kernel = NULL;
+
+// Lanes kept by each mask of 4 and 8 lanes moved to the front of a vector,
+// as byte shuffles for SSE and lane indices for AVX2, and how many they are
+static uint8_t scan_pack4[16][16];
+static uint64_t scan_pack8[256];
+static uint8_t scan_pack_count[256];
+
+static INIT_ONCE scan_tables_once = INIT_ONCE_STATIC_INIT;
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Scalar                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+static size_t scan_count_scalar(const int *data, size_t size, int value)
+{
+	size_t count = 0, i;
+
+	for (i = 0; i < size; i++)
+		count += data[i] == value;
+
+	return count;
+}
+
+static size_t scan_first_scalar(const int *data, size_t size, int value)
+{
+	size_t i;
+	for (i = 0; i < size; i++)
+	{
+		if (data[i] == value)
+			return i;
+	}
+
+	return size;
+}
+
+static size_t scan_last_scalar(const int *data, size_t size, int value)
+{
+	size_t i;
+	for (i = size; i > 0; i--)
+	{
+		if (data[i - 1] == value)
+			return i - 1;
+	}
+
+	return size;
+}
+
+static size_t scan_remove_scalar(int *data, size_t size, int value)
+{
+	size_t kept = 0, i;
+
+	for (i = 0; i < size; i++)
+	{
+		data[kept] = data[i];
+		kept += data[i] != value;
+	}
+
+	return kept;
+}
+
+static int scan_max_scalar(const int *data, size_t size)
+{
+	int result = data[0];
+
+	size_t i;
+	for (i = 1; i < size; i++)
+	{
+		if (data[i] > result)
+			result = data[i];
+	}
+
+	return result;
+}
+
+static int scan_min_scalar(const int *data, size_t size)
+{
+	int result = data[0];
+
+	size_t i;
+	for (i = 1; i < size; i++)
+	{
+		if (data[i] < result)
+			result = data[i];
+	}
+
+	return result;
+}
+
+// The byte kernels take needles of at least two characters and compare the
+// whole needle only where its first and last characters both match. They
+// return size if there is no match, or if they give up, and set scanned to
+// the number of positions searched.
+static size_t scan_bytes_scalar(const char *data, size_t size, const char *needle, size_t length, size_t *scanned)
+{
+	const size_t end = size - length + 1;
+
+	size_t misses = 0, i;
+	for (i = 0; i < end; i++)
+	{
+		if (data[i] != needle[0] || data[i + length - 1] != needle[length - 1])
+			continue;
+
+		if (memcmp(data + i + 1, needle + 1, length - 2) == 0)
+		{
+			*scanned = i;
+			return i;
+		}
+
+		if (++misses * length > SCAN_FILTER_WORK * i + SCAN_FILTER_SLACK)
+		{
+			*scanned = i + 1;
+			return size;
+		}
+	}
+
+	*scanned = end;
+	return size;
+}
+
+// First candidate of mask, bit b standing for data + b, where the whole
+// needle matches or SCAN_NO_MATCH, counting the ones that fail in misses
+static size_t scan_bytes_verify(const char *data, unsigned long mask, const char *needle, size_t length, size_t *misses)
+{
+	unsigned long bit;
+
+	while (mask != 0)
+	{
+		_BitScanForward(&bit, mask);
+
+		if (memcmp(data + bit + 1, needle + 1, length - 2) == 0)
+			return bit;
+
+		(*misses)++;
+		mask &= mask - 1;
+	}
+
+	return SCAN_NO_MATCH;
+}
+
+// Searches the positions left by a vectorized kernel, from i
+static size_t scan_bytes_tail(const char *data, size_t size, const char *needle, size_t length, size_t i, size_t *scanned)
+{
+	size_t pos = scan_bytes_scalar(data + i, size - i, needle, length, scanned);
+
+	*scanned += i;
+
+	return pos == size - i ? size : i + pos;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             SSE4.1                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+static size_t scan_count_sse41(const int *data, size_t size, int value)
+{
+	const __m128i key = _mm_set1_epi32(value);
+
+	size_t count = 0, i = 0, end;
+	uint32_t lanes[4];
+
+	while (size - i >= 16)
+	{
+		end = size - i < SCAN_COUNT_BLOCK ? size - i : SCAN_COUNT_BLOCK;
+		end = i + (end & ~(size_t)15);
+
+		// Matches are -1, so subtracting them counts
+		__m128i a0 = _mm_setzero_si128(), a1 = _mm_setzero_si128();
+
+		for (; i < end; i += 16)
+		{
+			a0 = _mm_sub_epi32(a0, _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(data + i)), key));
+			a1 = _mm_sub_epi32(a1, _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(data + i + 4)), key));
+			a0 = _mm_sub_epi32(a0, _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(data + i + 8)), key));
+			a1 = _mm_sub_epi32(a1, _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(data + i + 12)), key));
+		}
+
+		_mm_storeu_si128((__m128i *)lanes, _mm_add_epi32(a0, a1));
+
+		count += (size_t)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+	}
+
+	return count + scan_count_scalar(data + i, size - i, value);
+}
+
+// Bit i is set if element i of the 16 at data equals key
+static unsigned long scan_mask_sse41(const int *data, __m128i key)
+{
+	__m128i e0 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)data), key);
+	__m128i e1 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(data + 4)), key);
+	__m128i e2 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(data + 8)), key);
+	__m128i e3 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(data + 12)), key);
+
+	if (_mm_testz_si128(_mm_or_si128(_mm_or_si128(e0, e1), _mm_or_si128(e2, e3)), _mm_set1_epi32(-1)))
+		return 0;
+
+	return (unsigned long)_mm_movemask_ps(_mm_castsi128_ps(e0)) |
+		   (unsigned long)_mm_movemask_ps(_mm_castsi128_ps(e1)) << 4 |
+		   (unsigned long)_mm_movemask_ps(_mm_castsi128_ps(e2)) << 8 |
+		   (unsigned long)_mm_movemask_ps(_mm_castsi128_ps(e3)) << 12;
+}
+
+static size_t scan_first_sse41(const int *data, size_t size, int value)
+{
+	const __m128i key = _mm_set1_epi32(value);
+
+	unsigned long mask, bit;
+
+	size_t i;
+	for (i = 0; size - i >= 16; i += 16)
+	{
+		mask = scan_mask_sse41(data + i, key);
+
+		if (mask != 0)
+		{
+			_BitScanForward(&bit, mask);
+
+			return i + bit;
+		}
+	}
+
+	size_t pos = scan_first_scalar(data + i, size - i, value);
+
+	return pos == size - i ? size : i + pos;
+}
+
+static size_t scan_last_sse41(const int *data, size_t size, int value)
+{
+	const __m128i key = _mm_set1_epi32(value);
+
+	unsigned long mask, bit;
+
+	size_t i;
+	for (i = size; i >= 16; i -= 16)
+	{
+		mask = scan_mask_sse41(data + i - 16, key);
+
+		if (mask != 0)
+		{
+			_BitScanReverse(&bit, mask);
+
+			return i - 16 + bit;
+		}
+	}
+
+	size_t pos = scan_last_scalar(data, i, value);
+
+	return pos == i ? size : pos;
+}
+
+// Kept elements are moved to the front of each vector and the whole vector
+// is stored at the write position, which never passes the read position
+static size_t scan_remove_sse41(int *data, size_t size, int value)
+{
+	const __m128i key = _mm_set1_epi32(value);
+
+	size_t kept = 0, i;
+	unsigned keep;
+
+	for (i = 0; size - i >= 4; i += 4)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i *)(data + i));
+
+		keep = ~(unsigned)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v, key))) & 0x0F;
+
+		v = _mm_shuffle_epi8(v, _mm_loadu_si128((const __m128i *)scan_pack4[keep]));
+
+		_mm_storeu_si128((__m128i *)(data + kept), v);
+
+		kept += scan_pack_count[keep];
+	}
+
+	for (; i < size; i++)
+	{
+		data[kept] = data[i];
+		kept += data[i] != value;
+	}
+
+	return kept;
+}
+
+static int scan_max_sse41(const int *data, size_t size)
+{
+	if (size < 16)
+		return scan_max_scalar(data, size);
+
+	__m128i m0 = _mm_loadu_si128((const __m128i *)data), m1 = m0;
+
+	size_t i;
+	for (i = 0; size - i >= 16; i += 16)
+	{
+		m0 = _mm_max_epi32(m0, _mm_loadu_si128((const __m128i *)(data + i)));
+		m1 = _mm_max_epi32(m1, _mm_loadu_si128((const __m128i *)(data + i + 4)));
+		m0 = _mm_max_epi32(m0, _mm_loadu_si128((const __m128i *)(data + i + 8)));
+		m1 = _mm_max_epi32(m1, _mm_loadu_si128((const __m128i *)(data + i + 12)));
+	}
+
+	int lanes[4];
+
+	_mm_storeu_si128((__m128i *)lanes, _mm_max_epi32(m0, m1));
+
+	int result = scan_max_scalar(lanes, 4);
+
+	if (i < size)
+	{
+		int rest = scan_max_scalar(data + i, size - i);
+
+		if (rest > result)
+			result = rest;
+	}
+
+	return result;
+}
+
+static int scan_min_sse41(const int *data, size_t size)
+{
+	if (size < 16)
+		return scan_min_scalar(data, size);
+
+	__m128i m0 = _mm_loadu_si128((const __m128i *)data), m1 = m0;
+
+	size_t i;
+	for (i = 0; size - i >= 16; i += 16)
+	{
+		m0 = _mm_min_epi32(m0, _mm_loadu_si128((const __m128i *)(data + i)));
+		m1 = _mm_min_epi32(m1, _mm_loadu_si128((const __m128i *)(data + i + 4)));
+		m0 = _mm_min_epi32(m0, _mm_loadu_si128((const __m128i *)(data + i + 8)));
+		m1 = _mm_min_epi32(m1, _mm_loadu_si128((const __m128i *)(data + i + 12)));
+	}
+
+	int lanes[4];
+
+	_mm_storeu_si128((__m128i *)lanes, _mm_min_epi32(m0, m1));
+
+	int result = scan_min_scalar(lanes, 4);
+
+	if (i < size)
+	{
+		int rest = scan_min_scalar(data + i, size - i);
+
+		if (rest < result)
+			result = rest;
+	}
+
+	return result;
+}
+
+// Two vectors of candidates per iteration fill the 32-bit mask
+static size_t scan_bytes_sse41(const char *data, size_t size, const char *needle, size_t length, size_t *scanned)
+{
+	const __m128i first = _mm_set1_epi8(needle[0]);
+	const __m128i last = _mm_set1_epi8(needle[length - 1]);
+	const size_t end = size - length + 1;
+
+	__m128i e0, e1;
+	unsigned long mask;
+
+	size_t misses = 0, i, pos;
+	for (i = 0; end - i >= 32; i += 32)
+	{
+		e0 = _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + i)), first),
+						   _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + i + length - 1)), last));
+		e1 = _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + i + 16)), first),
+						   _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + i + 15 + length)), last));
+
+		mask = (unsigned long)_mm_movemask_epi8(e0) | (unsigned long)_mm_movemask_epi8(e1) << 16;
+
+		if (mask == 0)
+			continue;
+
+		pos = scan_bytes_verify(data + i, mask, needle, length, &misses);
+
+		if (pos != SCAN_NO_MATCH)
+			return i + pos;
+
+		if (misses * length > SCAN_FILTER_WORK * i + SCAN_FILTER_SLACK)
+		{
+			*scanned = i + 32;
+			return size;
+		}
+	}
+
+	return scan_bytes_tail(data, size, needle, length, i, scanned);
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                              AVX2                                               |
+// +-------------------------------------------------------------------------------------------------+
+
+static size_t scan_count_avx2(const int *data, size_t size, int value)
+{
+	const __m256i key = _mm256_set1_epi32(value);
+
+	size_t count = 0, i = 0, end;
+	uint32_t lanes[8];
+
+	while (size - i >= 32)
+	{
+		end = size - i < SCAN_COUNT_BLOCK ? size - i : SCAN_COUNT_BLOCK;
+		end = i + (end & ~(size_t)31);
+
+		__m256i a0 = _mm256_setzero_si256(), a1 = _mm256_setzero_si256();
+
+		for (; i < end; i += 32)
+		{
+			a0 = _mm256_sub_epi32(a0, _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(data + i)), key));
+			a1 = _mm256_sub_epi32(a1, _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(data + i + 8)), key));
+			a0 = _mm256_sub_epi32(a0, _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(data + i + 16)), key));
+			a1 = _mm256_sub_epi32(a1, _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(data + i + 24)), key));
+		}
+
+		_mm256_storeu_si256((__m256i *)lanes, _mm256_add_epi32(a0, a1));
+
+		count += (size_t)lanes[0] + lanes[1] + lanes[2] + lanes[3] + lanes[4] + lanes[5] + lanes[6] + lanes[7];
+	}
+
+	return count + scan_count_scalar(data + i, size - i, value);
+}
+
+// Bit i is set if element i of the 32 at data equals key
+static unsigned long scan_mask_avx2(const int *data, __m256i key)
+{
+	__m256i e0 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)data), key);
+	__m256i e1 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(data + 8)), key);
+	__m256i e2 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(data + 16)), key);
+	__m256i e3 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(data + 24)), key);
+
+	if (_mm256_testz_si256(_mm256_or_si256(_mm256_or_si256(e0, e1), _mm256_or_si256(e2, e3)), _mm256_set1_epi32(-1)))
+		return 0;
+
+	return (unsigned long)_mm256_movemask_ps(_mm256_castsi256_ps(e0)) |
+		   (unsigned long)_mm256_movemask_ps(_mm256_castsi256_ps(e1)) << 8 |
+		   (unsigned long)_mm256_movemask_ps(_mm256_castsi256_ps(e2)) << 16 |
+		   (unsigned long)_mm256_movemask_ps(_mm256_castsi256_ps(e3)) << 24;
+}
+
+static size_t scan_first_avx2(const int *data, size_t size, int value)
+{
+	const __m256i key = _mm256_set1_epi32(value);
+
+	unsigned long mask, bit;
+
+	size_t i;
+	for (i = 0; size - i >= 32; i += 32)
+	{
+		mask = scan_mask_avx2(data + i, key);
+
+		if (mask != 0)
+		{
+			_BitScanForward(&bit, mask);
+
+			return i + bit;
+		}
+	}
+
+	size_t pos = scan_first_scalar(data + i, size - i, value);
+
+	return pos == size - i ? size : i + pos;
+}
+
+static size_t scan_last_avx2(const int *data, size_t size, int value)
+{
+	const __m256i key = _mm256_set1_epi32(value);
+
+	unsigned long mask, bit;
+
+	size_t i;
+	for (i = size; i >= 32; i -= 32)
+	{
+		mask = scan_mask_avx2(data + i - 32, key);
+
+		if (mask != 0)
+		{
+			_BitScanReverse(&bit, mask);
+
+			return i - 32 + bit;
+		}
+	}
+
+	size_t pos = scan_last_scalar(data, i, value);
+
+	return pos == i ? size : pos;
+}
+
+static size_t scan_remove_avx2(int *data, size_t size, int value)
+{
+	const __m256i key = _mm256_set1_epi32(value);
+
+	size_t kept = 0, i;
+	unsigned keep;
+
+	for (i = 0; size - i >= 8; i += 8)
+	{
+		__m256i v = _mm256_loadu_si256((const __m256i *)(data + i));
+
+		keep = ~(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, key))) & 0xFF;
+
+		v = _mm256_permutevar8x32_epi32(v, _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)&scan_pack8[keep])));
+
+		_mm256_storeu_si256((__m256i *)(data + kept), v);
+
+		kept += scan_pack_count[keep];
+	}
+
+	for (; i < size; i++)
+	{
+		data[kept] = data[i];
+		kept += data[i] != value;
+	}
+
+	return kept;
+}
+
+static int scan_max_avx2(const int *data, size_t size)
+{
+	if (size < 32)
+		return scan_max_sse41(data, size);
+
+	__m256i m0 = _mm256_loadu_si256((const __m256i *)data), m1 = m0;
+
+	size_t i;
+	for (i = 0; size - i >= 32; i += 32)
+	{
+		m0 = _mm256_max_epi32(m0, _mm256_loadu_si256((const __m256i *)(data + i)));
+		m1 = _mm256_max_epi32(m1, _mm256_loadu_si256((const __m256i *)(data + i + 8)));
+		m0 = _mm256_max_epi32(m0, _mm256_loadu_si256((const __m256i *)(data + i + 16)));
+		m1 = _mm256_max_epi32(m1, _mm256_loadu_si256((const __m256i *)(data + i + 24)));
+	}
+
+	int lanes[8];
+
+	_mm256_storeu_si256((__m256i *)lanes, _mm256_max_epi32(m0, m1));
+
+	int result = scan_max_scalar(lanes, 8);
+
+	if (i < size)
+	{
+		int rest = scan_max_scalar(data + i, size - i);
+
+		if (rest > result)
+			result = rest;
+	}
+
+	return result;
+}
+
+static int scan_min_avx2(const int *data, size_t size)
+{
+	if (size < 32)
+		return scan_min_sse41(data, size);
+
+	__m256i m0 = _mm256_loadu_si256((const __m256i *)data), m1 = m0;
+
+	size_t i;
+	for (i = 0; size - i >= 32; i += 32)
+	{
+		m0 = _mm256_min_epi32(m0, _mm256_loadu_si256((const __m256i *)(data + i)));
+		m1 = _mm256_min_epi32(m1, _mm256_loadu_si256((const __m256i *)(data + i + 8)));
+		m0 = _mm256_min_epi32(m0, _mm256_loadu_si256((const __m256i *)(data + i + 16)));
+		m1 = _mm256_min_epi32(m1, _mm256_loadu_si256((const __m256i *)(data + i + 24)));
+	}
+
+	int lanes[8];
+
+	_mm256_storeu_si256((__m256i *)lanes, _mm256_min_epi32(m0, m1));
+
+	int result = scan_min_scalar(lanes, 8);
+
+	if (i < size)
+	{
+		int rest = scan_min_scalar(data + i, size - i);
+
+		if (rest < result)
+			result = rest;
+	}
+
+	return result;
+}
+
+static size_t scan_bytes_avx2(const char *data, size_t size, const char *needle, size_t length, size_t *scanned)
+{
+	const __m256i first = _mm256_set1_epi8(needle[0]);
+	const __m256i last = _mm256_set1_epi8(needle[length - 1]);
+	const size_t end = size - length + 1;
+
+	unsigned long mask;
+
+	size_t misses = 0, i, pos;
+	for (i = 0; end - i >= 32; i += 32)
+	{
+		mask = (unsigned long)(uint32_t)_mm256_movemask_epi8(
+			_mm256_and_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + i)), first),
+							 _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + i + length - 1)), last)));
+
+		if (mask == 0)
+			continue;
+
+		pos = scan_bytes_verify(data + i, mask, needle, length, &misses);
+
+		if (pos != SCAN_NO_MATCH)
+			return i + pos;
+
+		if (misses * length > SCAN_FILTER_WORK * i + SCAN_FILTER_SLACK)
+		{
+			*scanned = i + 32;
+			return size;
+		}
+	}
+
+	return scan_bytes_tail(data, size, needle, length, i, scanned);
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             AVX-512                                             |
+// +-------------------------------------------------------------------------------------------------+
+
+static size_t scan_count_avx512(const int *data, size_t size, int value)
+{
+	const __m512i key = _mm512_set1_epi32(value);
+	const __m512i one = _mm512_set1_epi32(1);
+
+	size_t count = 0, i = 0, end;
+	uint32_t lanes[16];
+
+	while (size - i >= 64)
+	{
+		end = size - i < SCAN_COUNT_BLOCK ? size - i : SCAN_COUNT_BLOCK;
+		end = i + (end & ~(size_t)63);
+
+		__m512i a0 = _mm512_setzero_si512(), a1 = _mm512_setzero_si512();
+
+		for (; i < end; i += 64)
+		{
+			a0 = _mm512_mask_add_epi32(a0, _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(data + i), key), a0, one);
+			a1 = _mm512_mask_add_epi32(a1, _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(data + i + 16), key), a1, one);
+			a0 = _mm512_mask_add_epi32(a0, _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(data + i + 32), key), a0, one);
+			a1 = _mm512_mask_add_epi32(a1, _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(data + i + 48), key), a1, one);
+		}
+
+		_mm512_storeu_si512(lanes, _mm512_add_epi32(a0, a1));
+
+		size_t j;
+		for (j = 0; j < 16; j++)
+			count += lanes[j];
+	}
+
+	return count + scan_count_scalar(data + i, size - i, value);
+}
+
+static size_t scan_first_avx512(const int *data, size_t size, int value)
+{
+	const __m512i key = _mm512_set1_epi32(value);
+
+	__mmask16 m[4];
+	unsigned long bit;
+
+	size_t i, j;
+	for (i = 0; size - i >= 64; i += 64)
+	{
+		m[0] = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(data + i), key);
+		m[1] = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(data + i + 16), key);
+		m[2] = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(data + i + 32), key);
+		m[3] = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(data + i + 48), key);
+
+		if ((m[0] | m[1] | m[2] | m[3]) == 0)
+			continue;
+
+		for (j = 0; j < 4; j++)
+		{
+			if (_BitScanForward(&bit, m[j]))
+				return i + j * 16 + bit;
+		}
+	}
+
+	size_t pos = scan_first_scalar(data + i, size - i, value);
+
+	return pos == size - i ? size : i + pos;
+}
+
+static size_t scan_last_avx512(const int *data, size_t size, int value)
+{
+	const __m512i key = _mm512_set1_epi32(value);
+
+	__mmask16 m[4];
+	unsigned long bit;
+
+	size_t i, j;
+	for (i = size; i >= 64; i -= 64)
+	{
+		m[0] = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(data + i - 64), key);
+		m[1] = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(data + i - 48), key);
+		m[2] = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(data + i - 32), key);
+		m[3] = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(data + i - 16), key);
+
+		if ((m[0] | m[1] | m[2] | m[3]) == 0)
+			continue;
+
+		for (j = 4; j > 0; j--)
+		{
+			if (_BitScanReverse(&bit, m[j - 1]))
+				return i - 64 + (j - 1) * 16 + bit;
+		}
+	}
+
+	size_t pos = scan_last_scalar(data, i, value);
+
+	return pos == i ? size : pos;
+}
+
+static size_t scan_remove_avx512(int *data, size_t size, int value)
+{
+	const __m512i key = _mm512_set1_epi32(value);
+
+	size_t kept = 0, i;
+	__mmask16 keep;
+
+	for (i = 0; size - i >= 16; i += 16)
+	{
+		__m512i v = _mm512_loadu_si512(data + i);
+
+		keep = _mm512_cmpneq_epi32_mask(v, key);
+
+		_mm512_mask_compressstoreu_epi32(data + kept, keep, v);
+
+		kept += scan_pack_count[keep & 0xFF] + scan_pack_count[keep >> 8];
+	}
+
+	for (; i < size; i++)
+	{
+		data[kept] = data[i];
+		kept += data[i] != value;
+	}
+
+	return kept;
+}
+
+static int scan_max_avx512(const int *data, size_t size)
+{
+	if (size < 64)
+		return scan_max_avx2(data, size);
+
+	__m512i m0 = _mm512_loadu_si512(data), m1 = m0;
+
+	size_t i;
+	for (i = 0; size - i >= 64; i += 64)
+	{
+		m0 = _mm512_max_epi32(m0, _mm512_loadu_si512(data + i));
+		m1 = _mm512_max_epi32(m1, _mm512_loadu_si512(data + i + 16));
+		m0 = _mm512_max_epi32(m0, _mm512_loadu_si512(data + i + 32));
+		m1 = _mm512_max_epi32(m1, _mm512_loadu_si512(data + i + 48));
+	}
+
+	int lanes[16];
+
+	_mm512_storeu_si512(lanes, _mm512_max_epi32(m0, m1));
+
+	int result = scan_max_scalar(lanes, 16);
+
+	if (i < size)
+	{
+		int rest = scan_max_scalar(data + i, size - i);
+
+		if (rest > result)
+			result = rest;
+	}
+
+	return result;
+}
+
+static int scan_min_avx512(const int *data, size_t size)
+{
+	if (size < 64)
+		return scan_min_avx2(data, size);
+
+	__m512i m0 = _mm512_loadu_si512(data), m1 = m0;
+
+	size_t i;
+	for (i = 0; size - i >= 64; i += 64)
+	{
+		m0 = _mm512_min_epi32(m0, _mm512_loadu_si512(data + i));
+		m1 = _mm512_min_epi32(m1, _mm512_loadu_si512(data + i + 16));
+		m0 = _mm512_min_epi32(m0, _mm512_loadu_si512(data + i + 32));
+		m1 = _mm512_min_epi32(m1, _mm512_loadu_si512(data + i + 48));
+	}
+
+	int lanes[16];
+
+	_mm512_storeu_si512(lanes, _mm512_min_epi32(m0, m1));
+
+	int result = scan_min_scalar(lanes, 16);
+
+	if (i < size)
+	{
+		int rest = scan_min_scalar(data + i, size - i);
+
+		if (rest < result)
+			result = rest;
+	}
+
+	return result;
+}
+
+// Needs AVX-512BW for byte comparisons. The 64-bit mask is verified in
+// halves so that it also works where unsigned long has 32 bits.
+static size_t scan_bytes_avx512(const char *data, size_t size, const char *needle, size_t length, size_t *scanned)
+{
+	const __m512i first = _mm512_set1_epi8(needle[0]);
+	const __m512i last = _mm512_set1_epi8(needle[length - 1]);
+	const size_t end = size - length + 1;
+
+	__mmask64 mask;
+
+	size_t misses = 0, i, pos;
+	for (i = 0; end - i >= 64; i += 64)
+	{
+		mask = _mm512_mask_cmpeq_epi8_mask(_mm512_cmpeq_epi8_mask(_mm512_loadu_si512(data + i), first),
+										   _mm512_loadu_si512(data + i + length - 1), last);
+
+		if (mask == 0)
+			continue;
+
+		pos = scan_bytes_verify(data + i, (unsigned long)(uint32_t)mask, needle, length, &misses);
+
+		if (pos != SCAN_NO_MATCH)
+			return i + pos;
+
+		pos = scan_bytes_verify(data + i + 32, (unsigned long)(uint32_t)(mask >> 32), needle, length, &misses);
+
+		if (pos != SCAN_NO_MATCH)
+			return i + 32 + pos;
+
+		if (misses * length > SCAN_FILTER_WORK * i + SCAN_FILTER_SLACK)
+		{
+			*scanned = i + 64;
+			return size;
+		}
+	}
+
+	return scan_bytes_tail(data, size, needle, length, i, scanned);
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                            Two-Way                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+// Start of the maximal suffix of needle, for the order of characters or its
+// reverse, and the period of that suffix
+static size_t scan_maximal_suffix(const unsigned char *needle, size_t length, bool reverse, size_t *period)
+{
+	size_t suffix = SIZE_MAX, j = 0, k = 1, p = 1;
+	unsigned char a, b;
+
+	while (j + k < length)
+	{
+		a = needle[j + k];
+		b = needle[suffix + k];
+
+		if (a == b)
+		{
+			if (k != p)
+				k++;
+			else
+			{
+				j += p;
+				k = 1;
+			}
+		}
+		else if ((a < b) != reverse)
+		{
+			j += k;
+			k = 1;
+			p = j - suffix;
+		}
+		else
+		{
+			suffix = j++;
+			k = p = 1;
+		}
+	}
+
+	*period = p;
+
+	return suffix + 1;
+}
+
+// Splits needle at a critical position, where the local period equals the
+// period of the whole needle, which is the later of its two maximal suffixes
+static size_t scan_critical_factorization(const unsigned char *needle, size_t length, size_t *period)
+{
+	size_t forward, backward, forward_period, backward_period;
+
+	forward = scan_maximal_suffix(needle, length, false, &forward_period);
+	backward = scan_maximal_suffix(needle, length, true, &backward_period);
+
+	if (backward < forward)
+	{
+		*period = forward_period;
+		return forward;
+	}
+
+	*period = backward_period;
+	return backward;
+}
+
+// The right half of the needle is compared left to right and then the left
+// half right to left, and a mismatch shifts the window past it. For a
+// periodic needle the prefix of the left half known to match after a shift
+// by the period is remembered, so no character of data is compared more
+// than twice. Windows are first skipped as in Horspool's algorithm by the
+// last occurrence in the needle of a hash of the two characters at the end
+// of the window, which collisions only make shorter.
+static size_t scan_two_way(const char *data, size_t size, const char *needle, size_t length)
+{
+	const unsigned char *text = (const unsigned char *)data;
+	const unsigned char *key = (const unsigned char *)needle;
+
+	size_t shift[256];
+	size_t period, memory = 0, skip, i, j;
+
+	size_t suffix = scan_critical_factorization(key, length, &period);
+
+	for (i = 0; i < 256; i++)
+		shift[i] = length - 1;
+
+	for (i = 1; i < length; i++)
+		shift[SCAN_HASH2(key + i)] = length - i - 1;
+
+	if (memcmp(key, key + period, suffix) == 0)
+	{
+		for (j = 0; size - j >= length;)
+		{
+			skip = shift[SCAN_HASH2(text + j + length - 1)];
+
+			if (skip > 0)
+			{
+				memory = 0;
+				j += skip;
+				continue;
+			}
+
+			for (i = suffix > memory ? suffix : memory; i < length && key[i] == text[j + i]; i++)
+				;
+
+			if (i < length)
+			{
+				j += i - suffix + 1;
+				memory = 0;
+				continue;
+			}
+
+			for (i = suffix; i > memory && key[i - 1] == text[j + i - 1]; i--)
+				;
+
+			if (i <= memory)
+				return j;
+
+			j += period;
+			memory = length - period;
+		}
+	}
+	else
+	{
+		period = (suffix > length - suffix ? suffix : length - suffix) + 1;
+
+		for (j = 0; size - j >= length;)
+		{
+			skip = shift[SCAN_HASH2(text + j + length - 1)];
+
+			if (skip > 0)
+			{
+				j += skip;
+				continue;
+			}
+
+			for (i = suffix; i < length && key[i] == text[j + i]; i++)
+				;
+
+			if (i < length)
+			{
+				j += i - suffix + 1;
+				continue;
+			}
+
+			for (i = suffix; i > 0 && key[i - 1] == text[j + i - 1]; i--)
+				;
+
+			if (i == 0)
+				return j;
+
+			j += period;
+		}
+	}
+
+	return size;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                            Kernels                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+static BOOL CALLBACK scan_build_tables(PINIT_ONCE once, PVOID parameter, PVOID *context)
+{
+	(void)once;
+	(void)parameter;
+	(void)context;
+
+	unsigned mask, lane, count;
+
+	for (mask = 0; mask < 256; mask++)
+	{
+		count = 0;
+		scan_pack8[mask] = 0;
+
+		for (lane = 0; lane < 8; lane++)
+		{
+			if (mask & (1u << lane))
+			{
+				scan_pack8[mask] |= (uint64_t)lane << (8 * count);
+
+				if (mask < 16)
+				{
+					scan_pack4[mask][4 * count + 0] = (uint8_t)(4 * lane + 0);
+					scan_pack4[mask][4 * count + 1] = (uint8_t)(4 * lane + 1);
+					scan_pack4[mask][4 * count + 2] = (uint8_t)(4 * lane + 2);
+					scan_pack4[mask][4 * count + 3] = (uint8_t)(4 * lane + 3);
+				}
+
+				count++;
+			}
+		}
+
+		scan_pack_count[mask] = (uint8_t)count;
+	}
+
+	return TRUE;
+}
+
+// Binds the kernel function pointers on first use. Threads may get here at
+// the same time, so the tables are built once before any kernel reading them
+// is published and every pointer is swapped atomically.
+static void scan_select_kernel(void)
+{
+	ScanKernel kernel = scan_kernel;
+
+	scan_count_t count_kernel;
+	scan_find_t first_kernel, last_kernel;
+	scan_reduce_t max_kernel, min_kernel;
+	scan_remove_t remove_kernel;
+	scan_bytes_t bytes_kernel;
+
+	InitOnceExecuteOnce(&scan_tables_once, scan_build_tables, NULL, NULL);
+
+	if (kernel == SCAN_KERNEL_AUTO)
+	{
+		if (cpu_has(CPU_AVX512F))
+			kernel = SCAN_KERNEL_AVX512;
+		else if (cpu_has(CPU_AVX2))
+			kernel = SCAN_KERNEL_AVX2;
+		else if (cpu_has(CPU_SSE41))
+			kernel = SCAN_KERNEL_SSE41;
+		else
+			kernel = SCAN_KERNEL_SCALAR;
+	}
+
+	switch (kernel)
+	{
+	case SCAN_KERNEL_AVX512:
+		count_kernel = scan_count_avx512;
+		first_kernel = scan_first_avx512;
+		last_kernel = scan_last_avx512;
+		max_kernel = scan_max_avx512;
+		min_kernel = scan_min_avx512;
+		remove_kernel = scan_remove_avx512;
+		bytes_kernel = cpu_has(CPU_AVX512BW) ? scan_bytes_avx512 : scan_bytes_avx2;
+		break;
+	case SCAN_KERNEL_AVX2:
+		count_kernel = scan_count_avx2;
+		first_kernel = scan_first_avx2;
+		last_kernel = scan_last_avx2;
+		max_kernel = scan_max_avx2;
+		min_kernel = scan_min_avx2;
+		remove_kernel = scan_remove_avx2;
+		bytes_kernel = scan_bytes_avx2;
+		break;
+	case SCAN_KERNEL_SSE41:
+		count_kernel = scan_count_sse41;
+		first_kernel = scan_first_sse41;
+		last_kernel = scan_last_sse41;
+		max_kernel = scan_max_sse41;
+		min_kernel = scan_min_sse41;
+		remove_kernel = scan_remove_sse41;
+		bytes_kernel = scan_bytes_sse41;
+		break;
+	default:
+		count_kernel = scan_count_scalar;
+		first_kernel = scan_first_scalar;
+		last_kernel = scan_last_scalar;
+		max_kernel = scan_max_scalar;
+		min_kernel = scan_min_scalar;
+		remove_kernel = scan_remove_scalar;
+		bytes_kernel = scan_bytes_scalar;
+		break;
+	}
+
+	InterlockedExchangePointer((PVOID volatile *)&scan_count_kernel, (PVOID)count_kernel);
+	InterlockedExchangePointer((PVOID volatile *)&scan_first_kernel, (PVOID)first_kernel);
+	InterlockedExchangePointer((PVOID volatile *)&scan_last_kernel, (PVOID)last_kernel);
+	InterlockedExchangePointer((PVOID volatile *)&scan_max_kernel, (PVOID)max_kernel);
+	InterlockedExchangePointer((PVOID volatile *)&scan_min_kernel, (PVOID)min_kernel);
+	InterlockedExchangePointer((PVOID volatile *)&scan_remove_kernel, (PVOID)remove_kernel);
+	InterlockedExchangePointer((PVOID volatile *)&scan_bytes_kernel, (PVOID)bytes_kernel);
+}
+
+// Forces a kernel, mostly for benchmarking. Returns DS_ERR_INVALID_ARGUMENT
+// if the CPU does not support it.
+Status scan_set_kernel(ScanKernel kernel)
+{
+	if (kernel < SCAN_KERNEL_AUTO || kernel > SCAN_KERNEL_AVX512)
+		return DS_ERR_INVALID_ARGUMENT;
+
+	if (kernel == SCAN_KERNEL_SSE41 && !cpu_has(CPU_SSE41))
+		return DS_ERR_INVALID_ARGUMENT;
+
+	if (kernel == SCAN_KERNEL_AVX2 && !cpu_has(CPU_AVX2))
+		return DS_ERR_INVALID_ARGUMENT;
+
+	if (kernel == SCAN_KERNEL_AVX512 && !cpu_has(CPU_AVX512F))
+		return DS_ERR_INVALID_ARGUMENT;
+
+	scan_kernel = kernel;
+
+	scan_select_kernel();
+
+	return DS_OK;
+}
+
+ScanKernel scan_get_kernel(void)
+{
+	return scan_kernel;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                              Scans                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+// Number of elements equal to value
+size_t scan_count(const int *data, size_t size, int value)
+{
+	if (scan_count_kernel == NULL)
+		scan_select_kernel();
+
+	return scan_count_kernel(data, size, value);
+}
+
+// Position of the first element equal to value or size if there is none
+size_t scan_find_first(const int *data, size_t size, int value)
+{
+	if (scan_first_kernel == NULL)
+		scan_select_kernel();
+
+	return scan_first_kernel(data, size, value);
+}
+
+// Position of the last element equal to value or size if there is none
+size_t scan_find_last(const int *data, size_t size, int value)
+{
+	if (scan_last_kernel == NULL)
+		scan_select_kernel();
+
+	return scan_last_kernel(data, size, value);
+}
+
+// Largest element, 0 if size is 0
+int scan_max(const int *data, size_t size)
+{
+	if (size == 0)
+		return 0;
+
+	if (scan_max_kernel == NULL)
+		scan_select_kernel();
+
+	return scan_max_kernel(data, size);
+}
+
+// Smallest element, 0 if size is 0
+int scan_min(const int *data, size_t size)
+{
+	if (size == 0)
+		return 0;
+
+	if (scan_min_kernel == NULL)
+		scan_select_kernel();
+
+	return scan_min_kernel(data, size);
+}
+
+// Removes every element equal to value, keeping the others in order at the
+// front of data, and returns how many were kept
+size_t scan_remove(int *data, size_t size, int value)
+{
+	if (scan_remove_kernel == NULL)
+		scan_select_kernel();
+
+	return scan_remove_kernel(data, size, value);
+}
+
+// Position of the first occurrence of needle in data or size if there is
+// none. An empty needle is found at 0.
+size_t scan_find_bytes(const char *data, size_t size, const char *needle, size_t length)
+{
+	size_t found, scanned;
+
+	if (length == 0)
+		return 0;
+
+	if (length > size)
+		return size;
+
+	if (length == 1)
+	{
+		const char *hit = memchr(data, needle[0], size);
+
+		return hit == NULL ? size : (size_t)(hit - data);
+	}
+
+	if (scan_bytes_kernel == NULL)
+		scan_select_kernel();
+
+	found = scan_bytes_kernel(data, size, needle, length, &scanned);
+
+	if (found != size || scanned == size - length + 1)
+		return found;
+
+	// Too many candidates failed, the first scanned positions have no match
+	found = scan_two_way(data + scanned, size - scanned, needle, length);
+
+	return found == size - scanned ? size : scanned + found;
+}
+
+// Position of the first largest element. Two vectorized passes are still
+// much faster than a scalar pass tracking the position.
+size_t scan_max_pos(const int *data, size_t size)
+{
+	if (size == 0)
+		return 0;
+
+	return scan_find_first(data, size, scan_max(data, size));
+}
+
+size_t scan_min_pos(const int *data, size_t size)
+{
+	if (size == 0)
+		return 0;
+
+	return scan_find_first(data, size, scan_min(data, size));
+}
@@ -2374,43 +2374,62 @@ Status sll_remove_keys(SinglyLinkedList *sll, int key)
 	if (sll_is_empty(sll))
 		return DS_ERR_INVALID_OPERATION;
 
-	SinglyLinkedNode *prev = NULL;
-	SinglyLinkedNode *curr = sll->head;
+	// Unlinks through the pointer that points at each node, so removing the
+	// head needs no special case and the last node kept becomes the tail
+	SinglyLinkedNode **link = &(sll->head);
+	SinglyLinkedNode *curr;
 
-	while (curr != NULL)
+	sll->tail = NULL;
+
+	while ((curr = *link) != NULL)
 	{
 		if (curr->data == key)
 		{
+			*link = curr->next;
 
-			if (prev == NULL)
-			{
+			free(curr);
+
+			(sll->length)--;
+		}
+		else
+		{
+			sll->tail = curr;
+
+			link = &(curr->next);
+		}
+	}
 
-				sll->head = sll->head->next;
+	return DS_OK;
+}
 
-				free(curr);
+Status sll_remove_if(SinglyLinkedList *sll, int_predicate_t predicate, void *data)
+{
+	if (sll == NULL || predicate == NULL)
+		return DS_ERR_NULL_POINTER;
 
-				curr = sll->head;
+	if (sll_is_empty(sll))
+		return DS_ERR_INVALID_OPERATION;
 
-				(sll->length)--;
-			}
-			else
-			{
+	SinglyLinkedNode **link = &(sll->head);
+	SinglyLinkedNode *curr;
 
-				prev->next = curr->next;
+	sll->tail = NULL;
 
-				free(curr);
+	while ((curr = *link) != NULL)
+	{
+		if (predicate(curr->data, data))
+		{
+			*link = curr->next;
 
-				curr = prev->next;
+			free(curr);
 
-				(sll->length)--;
-			}
+			(sll->length)--;
 		}
 		else
 		{
+			sll->tail = curr;
 
-			prev = curr;
-
-			curr = curr->next;
+			link = &(curr->next);
 		}
 	}
 
@@ -0,0 +1,232 @@
+/**
+ * @file StringArena.c
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Source file for @c StringArena implementations in C
+ *
+ */
+
+#include "StringArena.h"
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                          Initializers                                           |
+// +-------------------------------------------------------------------------------------------------+
+
+// A slab_size of 0 uses STRING_ARENA_SLAB_SIZE. No memory is reserved until
+// the first allocation.
+Status arn_init_arena(StringArena **arena, size_t slab_size)
+{
+	*arena = malloc(sizeof(StringArena));
+
+	if (!(*arena))
+		return DS_ERR_ALLOC;
+
+	(*arena)->head = NULL;
+	(*arena)->slab_size = slab_size == 0 ? STRING_ARENA_SLAB_SIZE : slab_size;
+	(*arena)->slabs = 0;
+	(*arena)->reserved = 0;
+	(*arena)->used = 0;
+
+	return DS_OK;
+}
+
+static Status arn_make_slab(StringArena *arena, size_t size, StringArenaSlab **slab)
+{
+	*slab = malloc(sizeof(StringArenaSlab) + size);
+
+	if (!(*slab))
+		return DS_ERR_ALLOC;
+
+	(*slab)->next = NULL;
+	(*slab)->size = size;
+	(*slab)->used = 0;
+
+	(arena->slabs)++;
+	arena->reserved += size;
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                           Allocation                                            |
+// +-------------------------------------------------------------------------------------------------+
+
+// Bytes needed to align the next free byte of slab
+static size_t arn_padding(StringArenaSlab *slab, size_t alignment)
+{
+	uintptr_t next = (uintptr_t)((char *)(slab + 1) + slab->used);
+
+	return (size_t)((alignment - (next & (alignment - 1))) & (alignment - 1));
+}
+
+static Status arn_bump(StringArena *arena, size_t size, size_t alignment, void **result)
+{
+	StringArenaSlab *slab = arena->head;
+
+	Status st;
+
+	if (size + alignment > arena->slab_size / 4)
+	{
+		// Dedicated slab placed behind head so its free space is kept
+		st = arn_make_slab(arena, size + alignment, &slab);
+
+		if (st != DS_OK)
+			return st;
+
+		if (arena->head == NULL)
+			arena->head = slab;
+		else
+		{
+			slab->next = arena->head->next;
+			arena->head->next = slab;
+		}
+	}
+	else if (slab == NULL || slab->used + arn_padding(slab, alignment) + size > slab->size)
+	{
+		st = arn_make_slab(arena, arena->slab_size, &slab);
+
+		if (st != DS_OK)
+			return st;
+
+		slab->next = arena->head;
+		arena->head = slab;
+	}
+
+	size_t padding = arn_padding(slab, alignment);
+
+	*result = (char *)(slab + 1) + slab->used + padding;
+
+	slab->used += padding + size;
+	arena->used += padding + size;
+
+	return DS_OK;
+}
+
+// Memory aligned to STRING_ARENA_ALIGNMENT, suitable for any structure
+Status arn_alloc(StringArena *arena, size_t size, void **result)
+{
+	if (arena == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	if (size == 0)
+		return DS_ERR_INVALID_SIZE;
+
+	return arn_bump(arena, size, STRING_ARENA_ALIGNMENT, result);
+}
+
+Status arn_strdup(StringArena *arena, char *string, char **result)
+{
+	if (string == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	return arn_strndup(arena, string, strlen(string), result);
+}
+
+// Copies length bytes of string and a NUL terminator. Strings are packed
+// without any alignment.
+Status arn_strndup(StringArena *arena, char *string, size_t length, char **result)
+{
+	if (arena == NULL || string == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	void *buffer;
+
+	Status st = arn_bump(arena, length + 1, 1, &buffer);
+
+	if (st != DS_OK)
+		return st;
+
+	*result = buffer;
+
+	memcpy(*result, string, length);
+	(*result)[length] = '\0';
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Display                                             |
+// +-------------------------------------------------------------------------------------------------+
+
+Status arn_display_arena(StringArena *arena)
+{
+	if (arena == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	printf("\nString Arena");
+	printf("\n  Slabs    : %zu", arena->slabs);
+	printf("\n  Reserved : %zu bytes", arena->reserved);
+	printf("\n  Used     : %zu bytes", arena->used);
+
+	printf("\n");
+
+	return DS_OK;
+}
+
+// +-------------------------------------------------------------------------------------------------+
+// |                                             Resets                                              |
+// +-------------------------------------------------------------------------------------------------+
+
+// Invalidates every string handed out. A regular sized head slab is kept so
+// refilling the arena does not go back to malloc right away.
+Status arn_reset(StringArena *arena)
+{
+	if (arena == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	StringArenaSlab *keep = NULL;
+	StringArenaSlab *slab = arena->head;
+
+	if (slab != NULL && slab->size == arena->slab_size)
+	{
+		keep = slab;
+		slab = slab->next;
+	}
+
+	while (slab != NULL)
+	{
+		StringArenaSlab *next = slab->next;
+
+		free(slab);
+
+		slab = next;
+	}
+
+	arena->head = keep;
+	arena->slabs = keep == NULL ? 0 : 1;
+	arena->reserved = keep == NULL ? 0 : keep->size;
+	arena->used = 0;
+
+	if (keep != NULL)
+	{
+		keep->next = NULL;
+		keep->used = 0;
+	}
+
+	return DS_OK;
+}
+
+Status arn_delete_arena(StringArena **arena)
+{
+	if ((*arena) == NULL)
+		return DS_ERR_NULL_POINTER;
+
+	StringArenaSlab *slab = (*arena)->head;
+
+	while (slab != NULL)
+	{
+		StringArenaSlab *next = slab->next;
+
+		free(slab);
+
+		slab = next;
+	}
+
+	free(*arena);
+
+	*arena = NULL;
+
+	return DS_OK;
+}
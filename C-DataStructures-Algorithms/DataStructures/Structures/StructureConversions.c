@@ -96,6 +96,11 @@ Status convert_sll_to_darr(SinglyLinkedList *sll, DynamicArray **dar)
 	if (!(*dar))
 		return DS_ERR_ALLOC;
 
+	st = dar_reserve(*dar, list_size);
+
+	if (st != DS_OK)
+		return st;
+
 	size_t i;
 	for (i = 0; i < list_size; i++)
 	{
@@ -169,7 +174,12 @@ Status convert_darr_to_sll(DynamicArray **dar, SinglyLinkedList **sll)
 	if ((*dar)->size <= 0)
 		return DS_ERR_INVALID_OPERATION;
 
-	Status st = sll_init_list(sll);
+	Status st = dar_close_gap(*dar);
+
+	if (st != DS_OK)
+		return st;
+
+	st = sll_init_list(sll);
 
 	if (st != DS_OK)
 		return st;
@@ -213,6 +223,11 @@ Status convert_arr_to_dar(Array *arr, DynamicArray **dar)
 	if (!(*dar))
 		return DS_ERR_ALLOC;
 
+	st = dar_reserve(*dar, arr->size);
+
+	if (st != DS_OK)
+		return st;
+
 	size_t i;
 	for (i = 0; i < arr->size; i++)
 	{
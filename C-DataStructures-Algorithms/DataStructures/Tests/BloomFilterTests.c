@@ -0,0 +1,168 @@
+/**
+ * @file BloomFilterTests.c
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Test cases for @c BloomFilter implementations in C
+ *
+ */
+
+#include "BloomFilter.h"
+#include "HashSet.h"
+#include "HashFunctions.h"
+#include "Clock.h"
+
+int BloomFilterTests(void)
+{
+	printf("\n");
+	printf(" +-------------------------------------+\n");
+	printf(" |                                     |\n");
+	printf(" |           C Bloom Filter            |\n");
+	printf(" |                                     |\n");
+	printf(" +-------------------------------------+\n");
+	printf("\n");
+
+	BloomFilter *filter;
+	Status st;
+
+	char *houses[] = {"Stark", "Lannister", "Targaryen", "Baratheon", "Greyjoy", "Tyrell", "Martell", "Arryn", "Tully"};
+
+	size_t i, j;
+
+	st = blf_init(&filter, 100, 0.01, hash_wyhash);
+	print_status_repr(st);
+
+	for (i = 0; i < 9; i++)
+		blf_insert(filter, houses[i]);
+
+	printf("\nContains Stark: %d, contains Frey: %d", blf_contains(filter, "Stark"), blf_contains(filter, "Frey"));
+
+	blf_display(filter);
+
+	blf_delete(&filter);
+
+	// False positive rate against bits per key
+	const size_t total = 1 << 20;
+
+	char **members = malloc(sizeof(char *) * total);
+	char **others = malloc(sizeof(char *) * total);
+
+	for (i = 0; i < total; i++)
+	{
+		members[i] = malloc(32);
+		others[i] = malloc(32);
+
+		sprintf_s(members[i], 32, "user:%zu", i * 7919);
+		sprintf_s(others[i], 32, "guest:%zu", i * 7919);
+	}
+
+	double rates[] = {0.1, 0.01, 0.001, 0.0001};
+
+	Clock *clk;
+
+	clk_init(&clk);
+
+	printf("\n+------------+----------+--------+------------+------------+------------+");
+	printf("\n|   Target   | Bits/key | Hashes |  Measured  |  Expected  | Lookup (s) |");
+	printf("\n+------------+----------+--------+------------+------------+------------+");
+
+	for (j = 0; j < 4; j++)
+	{
+		blf_init(&filter, total, rates[j], hash_wyhash);
+
+		for (i = 0; i < total; i++)
+			blf_insert(filter, members[i]);
+
+		size_t missed = 0, accepted = 0;
+
+		for (i = 0; i < total; i++)
+			if (!blf_contains(filter, members[i]))
+				missed++;
+
+		clk_reset(clk);
+		clk_start(clk);
+
+		for (i = 0; i < total; i++)
+			if (blf_contains(filter, others[i]))
+				accepted++;
+
+		clk_stop(clk);
+
+		size_t bits;
+		double expected;
+
+		blf_count_bits(filter, &bits);
+		blf_estimate_fp_rate(total, bits, filter->hashes, &expected);
+
+		printf("\n| %10.4lf | %8.2lf | %6zu | %10.6lf | %10.6lf | %10.3lf |", rates[j], (double)bits / (double)total, filter->hashes, (double)accepted / (double)total, expected, clk->time);
+
+		if (missed != 0)
+			printf(" %zu false negatives", missed);
+
+		blf_delete(&filter);
+	}
+
+	printf("\n+------------+----------+--------+------------+------------+------------+");
+
+	// Filtering misses before they reach a HashSet
+	HashSet *set;
+
+	set_init_set(&set, total, hash_wyhash, NULL);
+	blf_init(&filter, total, 0.01, hash_wyhash);
+
+	for (i = 0; i < total; i++)
+	{
+		set_insert(set, members[i]);
+		blf_insert(filter, members[i]);
+	}
+
+	size_t found = 0;
+
+	clk_reset(clk);
+	clk_start(clk);
+
+	for (i = 0; i < total; i++)
+		if (set_exists(set, others[i]))
+			found++;
+
+	clk_stop(clk);
+
+	double t_set = clk->time;
+
+	clk_reset(clk);
+	clk_start(clk);
+
+	for (i = 0; i < total; i++)
+		if (blf_contains(filter, others[i]) && set_exists(set, others[i]))
+			found++;
+
+	clk_stop(clk);
+
+	double t_filtered = clk->time;
+
+	printf("\n\n+-----------------------+------------+");
+	printf("\n| %10zu misses     |  time (s)  |", total);
+	printf("\n+-----------------------+------------+");
+	printf("\n| set_exists            | %10.3lf |", t_set);
+	printf("\n| BloomFilter + HashSet | %10.3lf |", t_filtered);
+	printf("\n+-----------------------+------------+");
+	printf("\nElements found: %zu", found);
+
+	set_delete_set(&set);
+	blf_delete(&filter);
+
+	clk_delete(&clk);
+
+	for (i = 0; i < total; i++)
+	{
+		free(members[i]);
+		free(others[i]);
+	}
+
+	free(members);
+	free(others);
+
+	printf("\n");
+	return 0;
+}
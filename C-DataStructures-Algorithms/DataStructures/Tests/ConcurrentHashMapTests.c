@@ -0,0 +1,220 @@
+/**
+ * @file ConcurrentHashMapTests.c
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Test cases and benchmarks for @c ConcurrentHashMap implementations in C
+ *
+ */
+
+#include "ConcurrentHashMap.h"
+#include "HashFunctions.h"
+#include "Clock.h"
+
+#define CMAP_TEST_KEYS 65536
+#define CMAP_TEST_OPERATIONS 1048576
+#define CMAP_TEST_MAX_THREADS 64
+
+// Every worker of a run shares the same arguments except for its seed
+typedef struct CMapWorker
+{
+	ConcurrentHashMap *cmap; // Sharded map or NULL to use map and lock
+	HashMap *map;
+	SRWLOCK *lock;
+	char **keys;
+	size_t operations;
+	size_t read_percent;
+	size_t seed;
+} CMapWorker;
+
+static size_t cmap_test_random(size_t *state)
+{
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+
+	return *state;
+}
+
+static DWORD WINAPI cmap_test_worker(LPVOID argument)
+{
+	CMapWorker *worker = argument;
+
+	size_t i, r, state = worker->seed;
+	int value;
+
+	for (i = 0; i < worker->operations; i++)
+	{
+		r = cmap_test_random(&state);
+
+		char *key = worker->keys[r % CMAP_TEST_KEYS];
+
+		bool read = (r >> 8) % 100 < worker->read_percent;
+
+		if (worker->cmap != NULL)
+		{
+			if (read)
+				cmap_search(worker->cmap, key, &value);
+			else
+				cmap_insert(worker->cmap, key, (int)i);
+		}
+		else if (read)
+		{
+			AcquireSRWLockShared(worker->lock);
+			map_search(worker->map, key, &value);
+			ReleaseSRWLockShared(worker->lock);
+		}
+		else
+		{
+			AcquireSRWLockExclusive(worker->lock);
+			map_insert(worker->map, key, (int)i);
+			ReleaseSRWLockExclusive(worker->lock);
+		}
+	}
+
+	return 0;
+}
+
+// Millions of operations per second with threads workers
+static double cmap_test_run(CMapWorker *base, size_t threads)
+{
+	CMapWorker workers[CMAP_TEST_MAX_THREADS];
+	HANDLE handles[CMAP_TEST_MAX_THREADS];
+
+	Clock *clk;
+
+	clk_init(&clk);
+
+	clk_start(clk);
+
+	size_t i;
+	for (i = 0; i < threads; i++)
+	{
+		workers[i] = *base;
+		workers[i].operations = CMAP_TEST_OPERATIONS / threads;
+		workers[i].seed = (i + 1) * 2654435761u;
+
+		handles[i] = CreateThread(NULL, 0, cmap_test_worker, workers + i, 0, NULL);
+	}
+
+	WaitForMultipleObjects((DWORD)threads, handles, TRUE, INFINITE);
+
+	clk_stop(clk);
+
+	for (i = 0; i < threads; i++)
+		CloseHandle(handles[i]);
+
+	double seconds = clk->time > 0.0 ? clk->time : 1.0 / CLOCKS_PER_SEC;
+
+	clk_delete(&clk);
+
+	return (double)CMAP_TEST_OPERATIONS / seconds / 1e6;
+}
+
+int ConcurrentHashMapTests(void)
+{
+	printf("\n");
+	printf(" +-------------------------------------+\n");
+	printf(" |                                     |\n");
+	printf(" |       C Concurrent Hash Map         |\n");
+	printf(" |                                     |\n");
+	printf(" +-------------------------------------+\n");
+	printf("\n");
+
+	ConcurrentHashMap *cmap;
+	Status st;
+
+	int value;
+	size_t result;
+
+	cmap_init_map(&cmap, 8, 16, map_hash_djb2);
+
+	cmap_insert(cmap, "Hello World!", 1);
+	cmap_insert(cmap, "Fire and Blood", 2);
+	cmap_insert(cmap, "Hear me Roar", 3);
+	cmap_insert(cmap, "Winter is Coming", 4);
+	cmap_insert(cmap, "Hello World!", 5); // Updates value
+
+	st = cmap_search(cmap, "Hello World!", &value);
+	print_status_repr(st);
+	printf("\nValue for key Hello World! is %d", value);
+
+	st = cmap_remove(cmap, "Hear me Roar");
+	print_status_repr(st);
+
+	st = cmap_remove(cmap, "Hear me Roar");
+	print_status_repr(st);
+
+	printf("\nThe key [ Fire and Blood ] %s", cmap_contains(cmap, "Fire and Blood") ? "exists" : "does not exists");
+
+	cmap_count_entries(cmap, &result);
+	printf("\nTotal entries: %zu", result);
+
+	cmap_display_map(cmap);
+
+	cmap_delete_map(&cmap);
+
+	// Throughput
+	char **keys = malloc(sizeof(char *) * CMAP_TEST_KEYS);
+
+	size_t i, j, k;
+	for (i = 0; i < CMAP_TEST_KEYS; i++)
+	{
+		keys[i] = malloc(32);
+
+		sprintf_s(keys[i], 32, "session:%zu", i * 7919);
+	}
+
+	const size_t threads[] = {1, 2, 4, 8, 16, 32, 64};
+	const size_t read_percents[] = {50, 90, 99};
+
+	printf("\n+---------+--------+--------------+--------------+");
+	printf("\n| THREADS | READS  | GLOBAL LOCK  |   SHARDED    |");
+	printf("\n|         |  (%%)   |   (Mops/s)   |   (Mops/s)   |");
+	printf("\n+---------+--------+--------------+--------------+");
+
+	for (i = 0; i < sizeof(read_percents) / sizeof(read_percents[0]); i++)
+	{
+		for (j = 0; j < sizeof(threads) / sizeof(threads[0]); j++)
+		{
+			HashMap *map;
+			SRWLOCK lock;
+
+			InitializeSRWLock(&lock);
+
+			map_init_map(&map, CMAP_TEST_KEYS, hash_wyhash);
+			map_set_stats(map, false);
+			cmap_init_map(&cmap, CONCURRENT_HASH_MAP_SHARDS, CMAP_TEST_KEYS, hash_wyhash);
+
+			for (k = 0; k < CMAP_TEST_KEYS; k += 2)
+			{
+				map_insert(map, keys[k], (int)k);
+				cmap_insert(cmap, keys[k], (int)k);
+			}
+
+			CMapWorker base = {NULL, map, &lock, keys, 0, read_percents[i], 0};
+
+			double global = cmap_test_run(&base, threads[j]);
+
+			base.cmap = cmap;
+
+			double sharded = cmap_test_run(&base, threads[j]);
+
+			printf("\n| %7zu | %6zu | %12.2lf | %12.2lf |", threads[j], read_percents[i], global, sharded);
+
+			map_delete_map(&map);
+			cmap_delete_map(&cmap);
+		}
+	}
+
+	printf("\n+---------+--------+--------------+--------------+");
+
+	for (i = 0; i < CMAP_TEST_KEYS; i++)
+		free(keys[i]);
+
+	free(keys);
+
+	printf("\n");
+	return 0;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file CuckooFilterTests.c
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Test cases for @c CuckooFilter implementations in C
+ *
+ */
+
+#include "CuckooFilter.h"
+#include "HashFunctions.h"
+#include "Clock.h"
+
+int CuckooFilterTests(void)
+{
+	printf("\n");
+	printf(" +-------------------------------------+\n");
+	printf(" |                                     |\n");
+	printf(" |           C Cuckoo Filter           |\n");
+	printf(" |                                     |\n");
+	printf(" +-------------------------------------+\n");
+	printf("\n");
+
+	CuckooFilter *filter;
+	Status st;
+
+	char *houses[] = {"Stark", "Lannister", "Targaryen", "Baratheon", "Greyjoy", "Tyrell", "Martell", "Arryn", "Tully"};
+
+	size_t i, j, result;
+
+	st = ckf_init(&filter, 16, 12, hash_wyhash);
+	print_status_repr(st);
+
+	for (i = 0; i < 9; i++)
+		ckf_insert(filter, houses[i]);
+
+	printf("\nContains Stark: %d, contains Frey: %d", ckf_contains(filter, "Stark"), ckf_contains(filter, "Frey"));
+
+	// Unlike a Bloom filter keys can be removed
+	st = ckf_remove(filter, "Stark");
+	print_status_repr(st);
+
+	printf("\nContains Stark: %d", ckf_contains(filter, "Stark"));
+
+	ckf_count_entries(filter, &result);
+	printf("\nTotal entries: %zu", result);
+
+	ckf_display(filter);
+
+	ckf_delete(&filter);
+
+	// False positive rate against bits per key
+	const size_t total = 1 << 20;
+
+	char **members = malloc(sizeof(char *) * total);
+	char **others = malloc(sizeof(char *) * total);
+
+	for (i = 0; i < total; i++)
+	{
+		members[i] = malloc(32);
+		others[i] = malloc(32);
+
+		sprintf_s(members[i], 32, "user:%zu", i * 7919);
+		sprintf_s(others[i], 32, "guest:%zu", i * 7919);
+	}
+
+	size_t fingerprints[] = {8, 12, 16};
+
+	Clock *clk;
+
+	clk_init(&clk);
+
+	printf("\n+-------------+----------+------------+------------+------------+------------+");
+	printf("\n| Fingerprint | Bits/key |  Measured  |  Expected  | Lookup (s) | Remove (s) |");
+	printf("\n+-------------+----------+------------+------------+------------+------------+");
+
+	for (j = 0; j < 3; j++)
+	{
+		ckf_init(&filter, total, fingerprints[j], hash_wyhash);
+
+		size_t failed = 0, missed = 0, accepted = 0, left = 0;
+
+		for (i = 0; i < total; i++)
+			if (ckf_insert(filter, members[i]) != DS_OK)
+				failed++;
+
+		for (i = 0; i < total; i++)
+			if (!ckf_contains(filter, members[i]))
+				missed++;
+
+		clk_reset(clk);
+		clk_start(clk);
+
+		for (i = 0; i < total; i++)
+			if (ckf_contains(filter, others[i]))
+				accepted++;
+
+		clk_stop(clk);
+
+		double t_lookup = clk->time;
+
+		size_t bits;
+
+		ckf_count_bits(filter, &bits);
+
+		clk_reset(clk);
+		clk_start(clk);
+
+		for (i = 0; i < total; i++)
+			ckf_remove(filter, members[i]);
+
+		clk_stop(clk);
+
+		for (i = 0; i < total; i++)
+			if (ckf_contains(filter, members[i]))
+				left++;
+
+		printf("\n| %11zu | %8.2lf | %10.6lf | %10.6lf | %10.3lf | %10.3lf |", fingerprints[j], (double)bits / (double)total, (double)accepted / (double)total,
+			   2.0 * CUCKOO_FILTER_BUCKET_SIZE / (double)(1ull << fingerprints[j]), t_lookup, clk->time);
+
+		if (failed != 0 || missed != 0 || left != 0)
+			printf(" %zu failed, %zu missed, %zu left", failed, missed, left);
+
+		ckf_delete(&filter);
+	}
+
+	printf("\n+-------------+----------+------------+------------+------------+------------+");
+
+	clk_delete(&clk);
+
+	for (i = 0; i < total; i++)
+	{
+		free(members[i]);
+		free(others[i]);
+	}
+
+	free(members);
+	free(others);
+
+	printf("\n");
+	return 0;
+}
@@ -9,9 +9,27 @@
  */
 
 #include "DynamicArray.h"
+#include "IntHashSet.h"
+#include "Clock.h"
 
 int DAR_IO_TESTS(void);
 int DAR_REALLOC_TEST(void);
+int DAR_GROWTH_TEST(void);
+int DAR_GAP_BUFFER_TEST(void);
+int DAR_REMOVE_TEST(void);
+int DAR_SORTED_TEST(void);
+
+static bool dar_test_multiple(int value, void *data)
+{
+	return value % *(int *)data == 0;
+}
+
+static int dar_test_compare(const void *a, const void *b)
+{
+	int x = *(const int *)a, y = *(const int *)b;
+
+	return (x > y) - (x < y);
+}
 
 int DynamicArrayTests(void)
 {
@@ -25,6 +43,10 @@ int DynamicArrayTests(void)
 
 	//DAR_IO_TESTS();
 	DAR_REALLOC_TEST();
+	DAR_GROWTH_TEST();
+	DAR_GAP_BUFFER_TEST();
+	DAR_REMOVE_TEST();
+	DAR_SORTED_TEST();
 
 	DynamicArray *array;
 
@@ -232,7 +254,9 @@ int DAR_REALLOC_TEST(void)
 
 	dar_init(&array);
 
-	array->growth_rate = 10000000000; // oops! wrong!
+	// A rate that never grows the buffer is rejected
+	print_status_repr(dar_set_growth_rate(array, 0.5));
+	print_status_repr(dar_set_growth_rate(array, 1.5));
 
 	// Testing realloc
 	int i;
@@ -251,3 +275,461 @@ int DAR_REALLOC_TEST(void)
 
 	return 0;
 }
+
+int DAR_GROWTH_TEST(void)
+{
+	printf("\n");
+	printf("\n ---------- ---------- ---------- --------- ---------- ---------- ----------");
+	printf("\n ---------- ---------- ------- DAR_GROWTH_TEST ------- ---------- ----------");
+	printf("\n ---------- ---------- ---------- --------- ---------- ---------- ----------");
+	printf("\n");
+
+	const size_t total = 1 << 25;
+
+	char *policies[] = {"Growth rate 2.0", "Growth rate 1.5", "dar_reserve", "dar_init_reserved"};
+
+	DynamicArray *array;
+	Clock *clk;
+
+	clk_init(&clk);
+
+	size_t i, j;
+
+	printf("\n+-------------------+------------+------------+");
+	printf("\n| %9zu appends |  time (s)  |  capacity  |", total);
+	printf("\n+-------------------+------------+------------+");
+
+	for (j = 0; j < 4; j++)
+	{
+		if (j == 3)
+			dar_init_reserved(&array, total);
+		else
+			dar_init(&array);
+
+		if (j == 1)
+			dar_set_growth_rate(array, 1.5);
+
+		clk_reset(clk);
+		clk_start(clk);
+
+		if (j == 2)
+			dar_reserve(array, total);
+
+		for (i = 0; i < total; i++)
+			dar_insert_back(array, (int)i);
+
+		clk_stop(clk);
+
+		printf("\n| %-17s | %10.3lf | %10zu |", policies[j], clk->time, dar_cap(array));
+
+		dar_delete(&array);
+	}
+
+	printf("\n+-------------------+------------+------------+");
+
+	// Returning unused capacity
+	dar_init(&array);
+
+	for (i = 0; i < 1000; i++)
+		dar_insert_back(array, (int)i);
+
+	dar_remove(array, 100, 999);
+
+	printf("\n\nSize: %zu Capacity: %zu", dar_size(array), dar_cap(array));
+
+	dar_shrink_to_fit(array);
+
+	printf("\nSize: %zu Capacity: %zu", dar_size(array), dar_cap(array));
+
+	dar_delete(&array);
+
+	clk_delete(&clk);
+
+	printf("\n");
+	printf("\n ---------- ---------- ---------- --------- ---------- ---------- ----------");
+	printf("\n ---------- ---------- ---------- End tests ---------- ---------- ----------");
+	printf("\n ---------- ---------- ---------- --------- ---------- ---------- ----------");
+	printf("\n");
+
+	return 0;
+}
+
+int DAR_GAP_BUFFER_TEST(void)
+{
+	printf("\n");
+	printf("\n ---------- ---------- ---------- --------- ---------- ---------- ----------");
+	printf("\n ---------- ---------- ----- DAR_GAP_BUFFER_TEST ----- ---------- ----------");
+	printf("\n ---------- ---------- ---------- --------- ---------- ---------- ----------");
+	printf("\n");
+
+	DynamicArray *array;
+
+	// Small demo where the gap follows the edits
+	dar_init(&array);
+	dar_set_gap_buffer(array, true);
+
+	int i;
+	for (i = 0; i < 10; i++)
+		dar_insert_back(array, i);
+
+	dar_insert_at(array, 100, 3);
+	dar_insert_at(array, 101, 4);
+	dar_remove_at(array, 2);
+
+	printf("\nGap at %zu of %zu elements", array->gap, array->size);
+
+	dar_display(array);
+
+	// Adding an array to itself while the gap is open
+	printf("\nAppending and prepending the array to itself:");
+
+	print_status_repr(dar_append(array, array));
+	dar_display(array);
+
+	dar_insert_at(array, 102, 5);
+	print_status_repr(dar_prepend(array, array));
+	dar_display(array);
+
+	dar_delete(&array);
+
+	// Bursts of typing: each burst starts at a random position and inserts
+	// consecutive elements, deleting one now and then
+	const size_t total = 1 << 20;
+	const size_t bursts = 200, burst = 100;
+
+	char *modes[] = {"memmove", "Gap buffer"};
+
+	size_t j, k, b, cursor, sizes[2];
+	int checks[2];
+
+	Clock *clk;
+
+	clk_init(&clk);
+
+	printf("\n+------------+------------+");
+	printf("\n|    Mode    |  time (s)  |");
+	printf("\n+------------+------------+");
+
+	for (j = 0; j < 2; j++)
+	{
+		dar_init(&array);
+		dar_set_gap_buffer(array, j == 1);
+
+		for (k = 0; k < total; k++)
+			dar_insert_back(array, (int)k);
+
+		srand(42);
+
+		clk_reset(clk);
+		clk_start(clk);
+
+		for (b = 0; b < bursts; b++)
+		{
+			cursor = ((size_t)rand() * (RAND_MAX + (size_t)1) + (size_t)rand()) % array->size;
+
+			for (k = 0; k < burst; k++)
+			{
+				if (k % 10 == 9)
+					dar_remove_at(array, --cursor);
+				else
+					dar_insert_at(array, -(int)k, cursor++);
+			}
+		}
+
+		clk_stop(clk);
+
+		printf("\n| %-10s | %10.3lf |", modes[j], clk->time);
+
+		sizes[j] = dar_size(array);
+		dar_get(array, total / 2, &checks[j]);
+
+		dar_delete(&array);
+	}
+
+	printf("\n+------------+------------+");
+
+	if (sizes[0] != sizes[1] || checks[0] != checks[1])
+		printf("\nResults differ between modes");
+
+	clk_delete(&clk);
+
+	printf("\n");
+	printf("\n ---------- ---------- ---------- --------- ---------- ---------- ----------");
+	printf("\n ---------- ---------- ---------- End tests ---------- ---------- ----------");
+	printf("\n ---------- ---------- ---------- --------- ---------- ---------- ----------");
+	printf("\n");
+
+	return 0;
+}
+
+int DAR_REMOVE_TEST(void)
+{
+	printf("\n");
+	printf("\n ---------- ---------- ---------- --------- ---------- ---------- ----------");
+	printf("\n ---------- ---------- ------- DAR_REMOVE_TEST ------- ---------- ----------");
+	printf("\n ---------- ---------- ---------- --------- ---------- ---------- ----------");
+	printf("\n");
+
+	DynamicArray *array;
+
+	int i, divisor = 3;
+
+	// Removing from both sides of a gap
+	dar_init(&array);
+	dar_set_gap_buffer(array, true);
+
+	for (i = 0; i < 20; i++)
+		dar_insert_back(array, i % 7);
+
+	dar_insert_at(array, 5, 10);
+
+	printf("\nRemoving 5 and then multiples of 3:");
+
+	dar_remove_keys(array, 5);
+	dar_display(array);
+
+	dar_remove_if(array, dar_test_multiple, &divisor);
+	dar_display(array);
+
+	dar_delete(&array);
+
+	// One in ten elements is removed, one at a time with dar_remove_at as
+	// dar_remove_keys used to do and then in a single pass
+	const size_t total = 1 << 16;
+
+	char *modes[] = {"dar_remove_at", "dar_remove_keys", "dar_remove_if"};
+
+	size_t j, k, sizes[3];
+	int checks[3];
+
+	divisor = 10;
+
+	Clock *clk;
+
+	clk_init(&clk);
+
+	printf("\n+-----------------+------------+");
+	printf("\n|      Mode       |  time (s)  |");
+	printf("\n+-----------------+------------+");
+
+	for (j = 0; j < 3; j++)
+	{
+		dar_init(&array);
+
+		for (k = 0; k < total; k++)
+			dar_insert_back(array, (int)(k * 2654435761u % 10));
+
+		clk_reset(clk);
+		clk_start(clk);
+
+		if (j == 0)
+		{
+			for (k = 0; k < array->size; k++)
+			{
+				if (array->buffer[k] == 0)
+					dar_remove_at(array, k--);
+			}
+		}
+		else if (j == 1)
+			dar_remove_keys(array, 0);
+		else
+			dar_remove_if(array, dar_test_multiple, &divisor);
+
+		clk_stop(clk);
+
+		printf("\n| %-15s | %10.6lf |", modes[j], clk->time);
+
+		sizes[j] = dar_size(array);
+		dar_get(array, sizes[j] / 2, &checks[j]);
+
+		dar_delete(&array);
+	}
+
+	printf("\n+-----------------+------------+");
+
+	if (sizes[0] != sizes[1] || sizes[0] != sizes[2] || checks[0] != checks[1] || checks[0] != checks[2])
+		printf("\nResults differ between modes");
+
+	clk_delete(&clk);
+
+	printf("\n");
+	printf("\n ---------- ---------- ---------- --------- ---------- ---------- ----------");
+	printf("\n ---------- ---------- ---------- End tests ---------- ---------- ----------");
+	printf("\n ---------- ---------- ---------- --------- ---------- ---------- ----------");
+	printf("\n");
+
+	return 0;
+}
+
+int DAR_SORTED_TEST(void)
+{
+	printf("\n");
+	printf("\n ---------- ---------- ---------- --------- ---------- ---------- ----------");
+	printf("\n ---------- ---------- ------- DAR_SORTED_TEST ------- ---------- ----------");
+	printf("\n ---------- ---------- ---------- --------- ---------- ---------- ----------");
+	printf("\n");
+
+	DynamicArray *set1, *set2, *result;
+	DynamicArray *runs[3];
+
+	int i;
+	size_t position;
+	bool sorted;
+
+	dar_init(&set1);
+	dar_init(&set2);
+
+	for (i = 0; i < 20; i++)
+	{
+		dar_insert_back(set1, (i * 7) % 13);
+		dar_insert_back(set2, (i * 5) % 17 + 6);
+	}
+
+	dar_sort(set1);
+	dar_unique(set1);
+	dar_sort(set2);
+	dar_unique(set2);
+
+	dar_is_sorted(set1, &sorted);
+	printf("\nSet 1 is %s", sorted ? "sorted" : "not sorted");
+	dar_display(set1);
+	dar_display(set2);
+
+	dar_lower_bound(set2, 10, &position);
+	printf("\nFirst element of set 2 not less than 10 at %zu", position);
+	printf("\nSet 1 %s 12", dar_contains_sorted(set1, 12) ? "contains" : "does not contain");
+
+	printf("\nUnion:");
+	dar_sorted_union(set1, set2, &result);
+	dar_display(result);
+	dar_delete(&result);
+
+	printf("\nIntersection:");
+	dar_sorted_intersection(set1, set2, &result);
+	dar_display(result);
+	dar_delete(&result);
+
+	printf("\nDifference:");
+	dar_sorted_difference(set1, set2, &result);
+	dar_display(result);
+	dar_delete(&result);
+
+	runs[0] = set1;
+	runs[1] = set2;
+	runs[2] = set1;
+
+	printf("\nMerge of set 1, set 2 and set 1:");
+	dar_merge_sorted_many(runs, 3, &result);
+	dar_display(result);
+	dar_delete(&result);
+
+	dar_delete(&set1);
+	dar_delete(&set2);
+
+	// Sorting random elements, then intersecting sets of the same size and
+	// a small set with a large one as sorted arrays and as IntHashSets
+	const size_t total = 1 << 22, small = 1 << 10;
+
+	Clock *clk;
+	IntHashSet *hash1, *hash2, *hash_result;
+
+	size_t j, k, sizes[2];
+	double sort_times[2], times[2][2];
+
+	int *data = malloc(sizeof(int) * total);
+
+	clk_init(&clk);
+
+	dar_init(&set1);
+	srand(42);
+
+	for (j = 0; j < total; j++)
+	{
+		data[j] = (int)((unsigned)rand() * (RAND_MAX + 1u) + (unsigned)rand());
+		dar_insert_back(set1, data[j]);
+	}
+
+	clk_reset(clk);
+	clk_start(clk);
+	dar_sort(set1);
+	clk_stop(clk);
+	sort_times[0] = clk->time;
+
+	clk_reset(clk);
+	clk_start(clk);
+	qsort(data, total, sizeof(int), dar_test_compare);
+	clk_stop(clk);
+	sort_times[1] = clk->time;
+
+	dar_unique(set1);
+
+	for (j = 0; j < 2; j++)
+	{
+		size_t count = j == 0 ? total : small;
+
+		dar_init(&set2);
+		iset_init_set(&hash1, total);
+		iset_init_set(&hash2, count);
+		iset_init_set(&hash_result, count);
+
+		for (k = 0; k < set1->size; k++)
+			iset_insert(hash1, set1->buffer[k]);
+
+		// Half of the elements of the second set are in the first
+		for (k = 0; k < count; k++)
+		{
+			int value = k % 2 ? set1->buffer[rand() % set1->size] : (int)((unsigned)rand() * (RAND_MAX + 1u) + (unsigned)rand());
+
+			dar_insert_back(set2, value);
+			iset_insert(hash2, value);
+		}
+
+		dar_sort(set2);
+		dar_unique(set2);
+
+		clk_reset(clk);
+		clk_start(clk);
+		dar_sorted_intersection(set1, set2, &result);
+		clk_stop(clk);
+		times[j][0] = clk->time;
+
+		clk_reset(clk);
+		clk_start(clk);
+		iset_intersection(hash2, hash1, hash_result);
+		clk_stop(clk);
+		times[j][1] = clk->time;
+
+		sizes[0] = result->size;
+		iset_count_elements(hash_result, &sizes[1]);
+
+		if (sizes[0] != sizes[1])
+			printf("\nIntersections differ: %zu and %zu elements", sizes[0], sizes[1]);
+
+		dar_delete(&result);
+		dar_delete(&set2);
+		iset_delete_set(&hash1);
+		iset_delete_set(&hash2);
+		iset_delete_set(&hash_result);
+	}
+
+	printf("\n+---------------------+------------+------------+");
+	printf("\n|      time (s)       |   Sorted   | IntHashSet |");
+	printf("\n+---------------------+------------+------------+");
+	printf("\n| sort (vs qsort)     | %10.4lf | %10.4lf |", sort_times[0], sort_times[1]);
+	printf("\n| 4M x 4M intersect   | %10.4lf | %10.4lf |", times[0][0], times[0][1]);
+	printf("\n| 1K x 4M intersect   | %10.6lf | %10.6lf |", times[1][0], times[1][1]);
+	printf("\n+---------------------+------------+------------+");
+
+	dar_delete(&set1);
+	free(data);
+
+	clk_delete(&clk);
+
+	printf("\n");
+	printf("\n ---------- ---------- ---------- --------- ---------- ---------- ----------");
+	printf("\n ---------- ---------- ---------- End tests ---------- ---------- ----------");
+	printf("\n ---------- ---------- ---------- --------- ---------- ---------- ----------");
+	printf("\n");
+
+	return 0;
+}
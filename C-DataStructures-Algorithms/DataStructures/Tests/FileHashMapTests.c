@@ -0,0 +1,160 @@
+/**
+ * @file FileHashMapTests.c
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Test cases for @c FileHashMap implementations in C
+ *
+ */
+
+#include "FileHashMap.h"
+#include "HashFunctions.h"
+#include "Clock.h"
+
+int FileHashMapTests(void)
+{
+	printf("\n");
+	printf(" +-------------------------------------+\n");
+	printf(" |                                     |\n");
+	printf(" |           C File Hash Map           |\n");
+	printf(" |                                     |\n");
+	printf(" +-------------------------------------+\n");
+	printf("\n");
+
+	const char *path = "FileHashMapTests.dat";
+
+	HashMap *map;
+	FileHashMap *fmap;
+	Status st;
+
+	int value;
+	size_t i, result;
+
+	map_init_map(&map, 8, map_hash_djb2);
+
+	map_insert(map, "Hello World!", 1);
+	map_insert(map, "Fire and Blood", 2);
+	map_insert(map, "Hear me Roar", 3);
+	map_insert(map, "Winter is Coming", 4);
+
+	st = fmap_write(map, path);
+	print_status_repr(st);
+
+	map_delete_map(&map);
+
+	st = fmap_open(&fmap, path, NULL);
+	print_status_repr(st);
+
+	st = fmap_search(fmap, "Hear me Roar", &value);
+	print_status_repr(st);
+	printf("\nValue for key Hear me Roar is %d", value);
+
+	st = fmap_search(fmap, "Ours is the Fury", &value);
+	print_status_repr(st);
+
+	fmap_count_entries(fmap, &result);
+	printf("\nTotal entries: %zu", result);
+
+	fmap_close(&fmap);
+
+	// A file written with a different hash function is rejected
+	st = fmap_open(&fmap, path, map_hash_sdbm);
+	print_status_repr(st);
+
+	// A custom length aware function is not recorded, so the file has to be
+	// opened with the same functions as the map
+	map_init_map(&map, 8, map_hash_djb2);
+	map_set_hash_function_n(map, hash_xxh3_n);
+
+	map_insert(map, "Ours is the Fury", 5);
+
+	fmap_write(map, path);
+
+	map_delete_map(&map);
+
+	st = fmap_open(&fmap, path, NULL);
+	print_status_repr(st);
+
+	fmap_open(&fmap, path, map_hash_djb2);
+	fmap_set_hash_function_n(fmap, hash_xxh3_n);
+
+	st = fmap_search(fmap, "Ours is the Fury", &value);
+	print_status_repr(st);
+	printf("\nValue for key Ours is the Fury is %d", value);
+
+	fmap_close(&fmap);
+
+	// Startup time
+	const size_t total = 1 << 20;
+
+	char **keys = malloc(sizeof(char *) * total);
+
+	for (i = 0; i < total; i++)
+	{
+		keys[i] = malloc(32);
+
+		sprintf_s(keys[i], 32, "user:%zu", i * 7919);
+	}
+
+	Clock *clk;
+
+	clk_init(&clk);
+
+	clk_start(clk);
+
+	map_init_map(&map, 1, hash_wyhash);
+
+	for (i = 0; i < total; i++)
+		map_insert(map, keys[i], (int)i);
+
+	clk_stop(clk);
+
+	double t_build = clk->time;
+
+	fmap_write(map, path);
+
+	map_delete_map(&map);
+
+	clk_reset(clk);
+	clk_start(clk);
+
+	fmap_open(&fmap, path, NULL);
+
+	clk_stop(clk);
+
+	double t_open = clk->time;
+
+	size_t wrong = 0;
+
+	clk_reset(clk);
+	clk_start(clk);
+
+	for (i = 0; i < total; i++)
+	{
+		if (fmap_search(fmap, keys[i], &value) != DS_OK || value != (int)i)
+			wrong++;
+	}
+
+	clk_stop(clk);
+
+	double t_search = clk->time;
+
+	fmap_close(&fmap);
+
+	printf("\n\nBuilt %zu keys in %lf seconds", total, t_build);
+	printf("\nOpened the file in %lf seconds", t_open);
+	printf("\nSearched every key in %lf seconds, %zu wrong", t_search, wrong);
+
+	clk_delete(&clk);
+
+	for (i = 0; i < total; i++)
+		free(keys[i]);
+
+	free(keys);
+
+	remove(path);
+
+	printf("\n");
+	return 0;
+}
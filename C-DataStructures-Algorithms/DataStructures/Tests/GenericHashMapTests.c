@@ -0,0 +1,156 @@
+/**
+ * @file GenericHashMapTests.c
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Test cases for @c GenericHashMap implementations in C
+ *
+ */
+
+#include "GenericHashMap.h"
+#include "Clock.h"
+
+typedef struct GMapPoint
+{
+	int x;
+	int y;
+} GMapPoint;
+
+typedef struct GMapAccount
+{
+	char name[24];
+	double balance;
+	size_t visits;
+} GMapAccount;
+
+int GenericHashMapTests(void)
+{
+	printf("\n");
+	printf(" +-------------------------------------+\n");
+	printf(" |                                     |\n");
+	printf(" |         C Generic Hash Map          |\n");
+	printf(" |                                     |\n");
+	printf(" +-------------------------------------+\n");
+	printf("\n");
+
+	GenericHashMap *map;
+	Status st;
+
+	size_t i, result;
+
+	// Structure keys and values compared by their bytes
+	gmap_init_map(&map, sizeof(GMapPoint), sizeof(GMapAccount), 8, NULL, NULL);
+
+	GMapPoint p1 = {1, 2}, p2 = {-4, 7}, p3 = {1, 3};
+	GMapAccount a1 = {"Ada Lovelace", 100.5, 1}, a2 = {"Alan Turing", 42.0, 3};
+	GMapAccount found;
+
+	gmap_insert(map, &p1, &a1);
+	gmap_insert(map, &p2, &a2);
+
+	st = gmap_search(map, &p1, &found);
+	print_status_repr(st);
+	printf("\n(%d, %d) -> %s %.2lf", p1.x, p1.y, found.name, found.balance);
+
+	st = gmap_search(map, &p3, &found);
+	print_status_repr(st);
+
+	// Updated in place, no copy in or out
+	GMapAccount *account;
+
+	gmap_get(map, &p2, (void **)&account);
+
+	account->balance += 8.0;
+	(account->visits)++;
+
+	gmap_search(map, &p2, &found);
+	printf("\n(%d, %d) -> %s %.2lf %zu visits", p2.x, p2.y, found.name, found.balance, found.visits);
+
+	st = gmap_remove(map, &p1);
+	print_status_repr(st);
+
+	printf("\nThe key (%d, %d) %s", p1.x, p1.y, gmap_contains(map, &p1) ? "exists" : "does not exists");
+
+	gmap_display_map(map);
+
+	gmap_delete_map(&map);
+
+	// String keys counting words
+	gmap_init_map(&map, sizeof(char *), sizeof(size_t), 8, gmap_hash_string, gmap_compare_string);
+
+	char *words[] = {"winter", "is", "coming", "the", "winter", "is", "here", "winter"};
+
+	for (i = 0; i < sizeof(words) / sizeof(words[0]); i++)
+	{
+		size_t *count;
+
+		gmap_emplace(map, &(words[i]), (void **)&count);
+
+		(*count)++;
+	}
+
+	size_t cursor = 0;
+	void *key, *value;
+
+	while (gmap_iter_next(map, &cursor, &key, &value))
+		printf("\n%-8s %zu", *(char **)key, *(size_t *)value);
+
+	gmap_count_entries(map, &result);
+	printf("\nTotal entries: %zu", result);
+
+	gmap_delete_map(&map);
+
+	// Integer keys
+	const size_t total = 1000000;
+
+	Clock *clk;
+
+	clk_init(&clk);
+
+	gmap_init_map(&map, sizeof(size_t), sizeof(GMapPoint), 1, NULL, NULL);
+
+	clk_start(clk);
+
+	for (i = 0; i < total; i++)
+	{
+		size_t k = i * 2654435761u;
+		GMapPoint p = {(int)i, (int)(i * 2)};
+
+		gmap_insert(map, &k, &p);
+	}
+
+	clk_stop(clk);
+
+	printf("\n\nInserted %zu integer keys in %lf seconds", total, clk->time);
+
+	size_t wrong = 0;
+
+	clk_reset(clk);
+	clk_start(clk);
+
+	for (i = 0; i < total; i++)
+	{
+		size_t k = i * 2654435761u;
+		GMapPoint p;
+
+		if (gmap_search(map, &k, &p) != DS_OK || p.x != (int)i)
+			wrong++;
+	}
+
+	clk_stop(clk);
+
+	printf("\nSearched %zu integer keys in %lf seconds, %zu wrong", total, clk->time, wrong);
+
+	gmap_count_collisions_max(map, &result);
+	printf("\nTotal max collisions: %zu", result);
+
+	gmap_display_map(map);
+
+	gmap_delete_map(&map);
+
+	clk_delete(&clk);
+
+	printf("\n");
+	return 0;
+}
@@ -0,0 +1,231 @@
+/**
+ * @file HashFunctionsTests.c
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Test cases and benchmarks for string hash functions
+ *
+ */
+
+#include "HashFunctions.h"
+#include "HashMap.h"
+#include "Clock.h"
+
+static const char *hf_names[] = {"djb2", "sdbm", "wyhash", "xxh3"};
+static hash_function_t hf_functions[] = {map_hash_djb2, map_hash_sdbm, hash_wyhash, hash_xxh3};
+static const size_t hf_total = 4;
+
+// Megabytes per second hashing keys of a given length
+static double hf_throughput(hash_function_t function, char **keys, size_t key_count, size_t len)
+{
+	Clock *clk;
+
+	clk_init(&clk);
+
+	size_t total = ((size_t)64 << 20) / (len + 1);
+	size_t i, hash, sink = 0;
+
+	clk_start(clk);
+
+	for (i = 0; i < total; i++)
+	{
+		function(keys[i % key_count], &hash);
+
+		sink += hash;
+	}
+
+	clk_stop(clk);
+
+	double seconds = clk->time > 0.0 ? clk->time : 1.0 / CLOCKS_PER_SEC;
+	double result = (double)total * (double)len / seconds / (1024.0 * 1024.0);
+
+	clk_delete(&clk);
+
+	// Keeps the loop from being optimized away
+	if (sink == 1)
+		printf(" ");
+
+	return result;
+}
+
+// Buckets selected with the low bits of the hash, as HashMap does
+static void hf_distribution(hash_function_t function, const char *name, size_t buckets)
+{
+	size_t *count = calloc(buckets, sizeof(size_t));
+
+	size_t keys = buckets * 4;
+	size_t i, hash, empty = 0, max = 0;
+
+	char key[32];
+
+	for (i = 0; i < keys; i++)
+	{
+		sprintf_s(key, 32, "user:%zu", i);
+
+		function(key, &hash);
+
+		count[hash & (buckets - 1)]++;
+	}
+
+	double expected = (double)keys / (double)buckets, chi = 0.0;
+
+	for (i = 0; i < buckets; i++)
+	{
+		if (count[i] == 0)
+			empty++;
+
+		if (count[i] > max)
+			max = count[i];
+
+		chi += ((double)count[i] - expected) * ((double)count[i] - expected) / expected;
+	}
+
+	// Around 1.0 for a uniform hash
+	chi /= (double)(buckets - 1);
+
+	printf("\n| %-8s | %12zu | %10zu | %12.3lf |", name, empty, max, chi);
+
+	free(count);
+}
+
+int HashFunctionsTests(void)
+{
+	printf("\n");
+	printf(" +-------------------------------------+\n");
+	printf(" |                                     |\n");
+	printf(" |          C Hash Functions           |\n");
+	printf(" |                                     |\n");
+	printf(" +-------------------------------------+\n");
+	printf("\n");
+
+	const size_t lengths[] = {4, 8, 16, 32, 64, 128, 256, 1024, 4096};
+	const size_t len_total = sizeof(lengths) / sizeof(lengths[0]);
+	const size_t key_count = 64;
+
+	const char charset[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+	const size_t c_len = strlen(charset);
+
+	char **keys = malloc(sizeof(char *) * key_count);
+
+	size_t i, j, k, hash, hash_sse2, hash_avx2;
+
+	// Every kernel must produce the same hash
+	char *long_key = malloc(5000);
+
+	for (i = 0; i < 4999; i++)
+		long_key[i] = charset[rand() % c_len];
+
+	long_key[4999] = '\0';
+
+	bool same = true;
+
+	for (i = 0; i < 4999; i += 37)
+	{
+		long_key[i + 1] = '\0';
+
+		hash_set_kernel(HASH_KERNEL_SCALAR);
+		hash_xxh3(long_key, &hash);
+
+		hash_sse2 = hash;
+		hash_avx2 = hash;
+
+		if (hash_set_kernel(HASH_KERNEL_SSE2) == DS_OK)
+			hash_xxh3(long_key, &hash_sse2);
+
+		if (hash_set_kernel(HASH_KERNEL_AVX2) == DS_OK)
+			hash_xxh3(long_key, &hash_avx2);
+
+		if (hash != hash_sse2 || hash != hash_avx2)
+			same = false;
+
+		long_key[i + 1] = charset[rand() % c_len];
+	}
+
+	hash_set_kernel(HASH_KERNEL_AUTO);
+
+	printf("\nKernels %s", same ? "agree" : "DISAGREE");
+
+	free(long_key);
+
+	// Throughput
+	printf("\n\n+----------+------------+------------+------------+------------+");
+	printf("\n|  LENGTH  |    djb2    |    sdbm    |   wyhash   |    xxh3    |");
+	printf("\n|  (bytes) |   (MB/s)   |   (MB/s)   |   (MB/s)   |   (MB/s)   |");
+	printf("\n+----------+------------+------------+------------+------------+");
+
+	for (i = 0; i < len_total; i++)
+	{
+		for (j = 0; j < key_count; j++)
+		{
+			keys[j] = malloc(lengths[i] + 1);
+
+			for (k = 0; k < lengths[i]; k++)
+				keys[j][k] = charset[rand() % c_len];
+
+			keys[j][lengths[i]] = '\0';
+		}
+
+		printf("\n| %8zu |", lengths[i]);
+
+		for (j = 0; j < hf_total; j++)
+			printf(" %10.1lf |", hf_throughput(hf_functions[j], keys, key_count, lengths[i]));
+
+		for (j = 0; j < key_count; j++)
+			free(keys[j]);
+	}
+
+	printf("\n+----------+------------+------------+------------+------------+");
+
+	// Kernels of xxh3 on long keys
+	const HashKernel kernels[] = {HASH_KERNEL_SCALAR, HASH_KERNEL_SSE2, HASH_KERNEL_AVX2};
+
+	printf("\n\n+----------+------------+------------+------------+");
+	printf("\n|  LENGTH  |   scalar   |    sse2    |    avx2    |");
+	printf("\n+----------+------------+------------+------------+");
+
+	for (i = 6; i < len_total; i++)
+	{
+		for (j = 0; j < key_count; j++)
+		{
+			keys[j] = malloc(lengths[i] + 1);
+
+			for (k = 0; k < lengths[i]; k++)
+				keys[j][k] = charset[rand() % c_len];
+
+			keys[j][lengths[i]] = '\0';
+		}
+
+		printf("\n| %8zu |", lengths[i]);
+
+		for (j = 0; j < 3; j++)
+		{
+			if (hash_set_kernel(kernels[j]) == DS_OK)
+				printf(" %10.1lf |", hf_throughput(hash_xxh3, keys, key_count, lengths[i]));
+			else
+				printf(" %10s |", "n/a");
+		}
+
+		for (j = 0; j < key_count; j++)
+			free(keys[j]);
+	}
+
+	printf("\n+----------+------------+------------+------------+");
+
+	hash_set_kernel(HASH_KERNEL_AUTO);
+
+	free(keys);
+
+	// Distribution
+	printf("\n\n+----------+--------------+------------+--------------+");
+	printf("\n| FUNCTION | EMPTY BUCKETS| MAX BUCKET | CHI^2 / DOF  |");
+	printf("\n+----------+--------------+------------+--------------+");
+
+	for (i = 0; i < hf_total; i++)
+		hf_distribution(hf_functions[i], hf_names[i], 1 << 16);
+
+	printf("\n+----------+--------------+------------+--------------+");
+
+	printf("\n");
+	return 0;
+}
@@ -9,6 +9,8 @@
  */
 
 #include "HashMap.h"
+#include "HashFunctions.h"
+#include "Clock.h"
 
 int HashMapTests(void)
 {
@@ -65,8 +67,8 @@ int HashMapTests(void)
 	map_insert(map, "Leonhard Euler", 15);
 	map_insert(map, "Carl Friedrich Gauss", 16);
 	map_insert(map, "Isaac Newton", 17);
-	map_insert(map, "Winter is Coming", 18); // Allowed
-	map_insert(map, "Isaac Newton", 19);	 // Allowed
+	map_insert(map, "Winter is Coming", 18); // Updates value
+	map_insert(map, "Isaac Newton", 19);	 // Updates value
 
 	map_display_map(map);
 
@@ -78,7 +80,7 @@ int HashMapTests(void)
 	printf("\nTotal empty spots: %zu", result);
 	map_count_entries(map, &result);
 	printf("\nTotal insertions: %zu", result);
-	printf("\nTotal size: %zu", map->size);
+	printf("\nTotal capacity: %zu", map->capacity);
 
 	int value;
 
@@ -104,11 +106,38 @@ int HashMapTests(void)
 	print_status_repr(st);
 	printf("\nValue for key %s is %d", s5, value);
 
+	// Length aware keys, only the first 11 bytes of s2 are used
+	st = map_search_n(map, s2, 11, &value);
+	print_status_repr(st);
+	printf("\nValue for key %.11s is %d", s2, value);
+
+	map_insert_n(map, "Fire and Blood and Ice", 14, 20);
+	st = map_search(map, "Fire and Blood", &value);
+	print_status_repr(st);
+	printf("\nValue for key Fire and Blood is %d", value);
+
+	st = map_remove(map, s1);
+	print_status_repr(st);
+	st = map_remove(map, s3);
+	print_status_repr(st);
+	printf("\nShouldn't find:");
+	st = map_remove(map, s1);
+	print_status_repr(st);
+	st = map_search(map, s1, &value);
+	print_status_repr(st);
+	st = map_search(map, s2, &value);
+	print_status_repr(st);
+	printf("\nValue for key %s is %d", s2, value);
+
+	map_count_entries(map, &result);
+	printf("\nTotal insertions after removal: %zu", result);
+
 	map_delete_map(&map);
 
 	size_t size = 1200;
 
-	map_init_map(&map, size, map_hash_djb2);
+	// Starts small and grows as needed
+	map_init_map(&map, 1, map_hash_djb2);
 
 	size_t i, j;
 	const char charset[] = " abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
@@ -128,7 +157,7 @@ int HashMapTests(void)
 			str[j] = charset[rand() % c_len];
 		}
 
-		str[j + 1] = '\0';
+		str[j] = '\0';
 
 		map_insert(map, str, rand());
 	}
@@ -143,10 +172,178 @@ int HashMapTests(void)
 	printf("\nTotal empty spots: %zu", result);
 	map_count_entries(map, &result);
 	printf("\nTotal insertions: %zu", result);
-	printf("\nTotal size: %zu", map->size);
+	printf("\nTotal capacity: %zu", map->capacity);
+
+	map_delete_map(&map);
+
+	// Incremental rehashing
+	map_init_map(&map, 1, map_hash_djb2);
+
+	map_set_rehash_step(map, HASH_MAP_REHASH_STEP);
+
+	size_t rehashing = 0;
+
+	for (i = 0; i < size; i++)
+	{
+		sprintf_s(str, str_len, "key-%zu", i);
+
+		map_insert(map, str, (int)i);
+
+		if (map_is_rehashing(map))
+			rehashing++;
+	}
+
+	printf("\nInsertions made while rehashing: %zu", rehashing);
+
+	map_count_entries(map, &result);
+	printf("\nTotal insertions: %zu", result);
+	printf("\nTotal capacity: %zu", map->capacity);
+
+	st = map_search(map, "key-0", &value);
+	print_status_repr(st);
+	printf("\nValue for key key-0 is %d", value);
 
 	map_delete_map(&map);
 
+	// A migration started by hand on a map that otherwise rehashes at once
+	map_init_map(&map, size, map_hash_djb2);
+
+	for (i = 0; i < size; i++)
+	{
+		sprintf_s(str, str_len, "key-%zu", i);
+
+		map_insert(map, str, (int)i);
+	}
+
+	map_rehash_start(map, map->capacity * 4);
+
+	size_t steps = 0;
+
+	while (map_is_rehashing(map) && steps <= map->old_capacity)
+	{
+		map_rehash_step(map);
+
+		steps++;
+	}
+
+	printf("\nRehashing %s after %zu steps", map_is_rehashing(map) ? "not finished" : "finished", steps);
+
+	map_count_entries(map, &result);
+	printf("\nTotal insertions: %zu", result);
+	printf("\nTotal capacity: %zu", map->capacity);
+
+	map_delete_map(&map);
+
+	free(str);
+
+	// Bulk insertion and batched search
+	const size_t total = 1 << 20;
+
+	char **keys = malloc(sizeof(char *) * total);
+	char **queries = malloc(sizeof(char *) * total);
+	int *values = malloc(sizeof(int) * total);
+	bool *found = malloc(sizeof(bool) * total);
+
+	for (i = 0; i < total; i++)
+	{
+		keys[i] = malloc(32);
+
+		sprintf_s(keys[i], 32, "user:%zu", i * 7919);
+
+		values[i] = (int)i;
+	}
+
+	// Half of the queries miss
+	for (i = 0; i < total; i++)
+		queries[i] = keys[(i * 2654435761u) % total];
+
+	for (i = 0; i < total; i += 2)
+		queries[i] = "missing key";
+
+	Clock *clk;
+
+	clk_init(&clk);
+
+	// Both maps are sized for every key up front so that only the batching
+	// differs between them
+	map_init_map(&map, total, hash_wyhash);
+
+	clk_start(clk);
+
+	for (i = 0; i < total; i++)
+		map_insert(map, keys[i], values[i]);
+
+	clk_stop(clk);
+
+	double t_insert = clk->time;
+
+	clk_reset(clk);
+	clk_start(clk);
+
+	for (i = 0; i < total; i++)
+		found[i] = map_search(map, queries[i], &(values[i])) == DS_OK;
+
+	clk_stop(clk);
+
+	double t_search = clk->time;
+
+	map_delete_map(&map);
+
+	for (i = 0; i < total; i++)
+		values[i] = (int)i;
+
+	map_init_map(&map, total, hash_wyhash);
+
+	clk_reset(clk);
+	clk_start(clk);
+
+	map_insert_bulk(map, keys, values, total);
+
+	clk_stop(clk);
+
+	double t_insert_bulk = clk->time;
+
+	clk_reset(clk);
+	clk_start(clk);
+
+	map_search_batch(map, queries, total, values, found);
+
+	clk_stop(clk);
+
+	double t_search_batch = clk->time;
+
+	size_t hits = 0;
+
+	for (i = 0; i < total; i++)
+		if (found[i])
+			hits++;
+
+	printf("\n\n+------------+------------+------------+");
+	printf("\n| %10zu |   single   |   batch    |", total);
+	printf("\n+------------+------------+------------+");
+	printf("\n| insert     | %9.3lfs | %9.3lfs |", t_insert, t_insert_bulk);
+	printf("\n| search     | %9.3lfs | %9.3lfs |", t_search, t_search_batch);
+	printf("\n+------------+------------+------------+");
+	printf("\nKeys found: %zu", hits);
+
+	// Counters kept while the map was used
+	HashMapStats stats;
+
+	map_stats(map, &stats);
+	map_display_stats(&stats);
+
+	map_delete_map(&map);
+
+	clk_delete(&clk);
+
+	for (i = 0; i < total; i++)
+		free(keys[i]);
+
+	free(keys);
+	free(queries);
+	free(values);
+	free(found);
+
 	printf("\n");
 	return 0;
 }
\ No newline at end of file
@@ -9,6 +9,19 @@
  */
 
 #include "HashSet.h"
+#include "HashFunctions.h"
+#include "Clock.h"
+
+// Counts the elements streamed by a set operation
+static Status set_test_count(char *value, size_t length, void *data)
+{
+	(void)value;
+	(void)length;
+
+	(*(size_t *)data)++;
+
+	return DS_OK;
+}
 
 int HashSetTests(void)
 {
@@ -34,7 +47,7 @@ int HashSetTests(void)
 
 	char *str = malloc(sizeof(char) * str_len);
 
-	while (!set_is_full(set))
+	for (i = 0; i < size; i++)
 	{
 		len = rand() % (str_len + 1 - 5) + 5;
 
@@ -43,7 +56,7 @@ int HashSetTests(void)
 			str[j] = charset[rand() % c_len];
 		}
 
-		str[j + 1] = '\0';
+		str[j] = '\0';
 
 		st = set_insert(set, str);
 	}
@@ -54,6 +67,63 @@ int HashSetTests(void)
 
 	set_delete_set(&set);
 
+	// Starts small and grows as needed
+	set_init_set(&set, 1, set_hash_djb2, NULL);
+
+	for (i = 0; i < 100000; i++)
+	{
+		sprintf_s(str, str_len, "key-%zu", i);
+
+		set_insert(set, str);
+	}
+
+	printf("\nSet size: %zu, capacity: %zu", set->size, set->capacity);
+
+	for (i = 0; i < 100000; i += 2)
+	{
+		sprintf_s(str, str_len, "key-%zu", i);
+
+		set_remove(set, str);
+	}
+
+	size_t missing = 0;
+
+	for (i = 1; i < 100000; i += 2)
+	{
+		sprintf_s(str, str_len, "key-%zu", i);
+
+		if (!set_exists(set, str))
+			missing++;
+	}
+
+	printf("\nSet size after removals: %zu, capacity: %zu, missing: %zu", set->size, set->capacity, missing);
+
+	// Removals leave no tombstones so churn never rebuilds the table
+	size_t round;
+
+	for (round = 0; round < 10; round++)
+	{
+		for (i = 0; i < 100000; i += 2)
+		{
+			sprintf_s(str, str_len, "churn-%zu-%zu", round, i);
+
+			set_insert(set, str);
+		}
+
+		for (i = 0; i < 100000; i += 2)
+		{
+			sprintf_s(str, str_len, "churn-%zu-%zu", round, i);
+
+			set_remove(set, str);
+		}
+	}
+
+	printf("\nSet size after churn: %zu, capacity: %zu", set->size, set->capacity);
+
+	set_delete_set(&set);
+
+	free(str);
+
 	set_init_set(&set, 30, set_hash_sdbm, set_rehash_prime);
 
 	printf("\nSet size: %zu", set->size);
@@ -114,6 +184,13 @@ int HashSetTests(void)
 			printf("\nThe element [ %s ] does not exists", words[i]);
 	}
 
+	// Length aware keys, only the first 12 bytes are used
+	char *line = "Isaac Newton;Alan Turing;Ada Lovelace";
+
+	printf("\nThe element [ %.12s ] %s", line, set_exists_n(set, line, 12) ? "exists" : "does not exists");
+	printf("\nThe element [ %.11s ] %s", line + 13, set_exists_n(set, line + 13, 11) ? "exists" : "does not exists");
+	printf("\nThe element [ %.5s ] %s", line, set_exists_n(set, line, 5) ? "exists" : "does not exists");
+
 	st = set_remove(set, "Winter is Coming");
 	print_status_repr(st);
 	st = set_remove(set, "Thomas Edson");
@@ -226,6 +303,137 @@ int HashSetTests(void)
 	set_delete_set(&set_b);
 	set_delete_set(&set_c);
 
+	// Membership checks, the metadata rejects most misses on its own
+	const size_t total = 1 << 20;
+
+	char **members = malloc(sizeof(char *) * total);
+	char **others = malloc(sizeof(char *) * total);
+
+	for (i = 0; i < total; i++)
+	{
+		members[i] = malloc(32);
+		others[i] = malloc(32);
+
+		sprintf_s(members[i], 32, "user:%zu", i * 7919);
+		sprintf_s(others[i], 32, "guest:%zu", i * 7919);
+	}
+
+	Clock *clk;
+
+	clk_init(&clk);
+
+	set_init_set(&set, 1, hash_wyhash, NULL);
+
+	for (i = 0; i < total; i++)
+		set_insert(set, members[i]);
+
+	size_t hits = 0;
+
+	clk_start(clk);
+
+	for (i = 0; i < total; i++)
+		if (set_exists(set, members[i]))
+			hits++;
+
+	clk_stop(clk);
+
+	double t_hits = clk->time;
+
+	clk_reset(clk);
+	clk_start(clk);
+
+	for (i = 0; i < total; i++)
+		if (set_exists(set, others[i]))
+			hits++;
+
+	clk_stop(clk);
+
+	double t_misses = clk->time;
+
+	printf("\n\n+------------+------------+------------+");
+	printf("\n| %10zu |    hits    |   misses   |", total);
+	printf("\n+------------+------------+------------+");
+	printf("\n| set_exists | %9.3lfs | %9.3lfs |", t_hits, t_misses);
+	printf("\n+------------+------------+------------+");
+	printf("\nElements found: %zu", hits);
+
+	// Intersection of two large sets, materialized, split among threads and
+	// streamed without building a result
+	HashSet *half, *result;
+
+	set_init_set(&half, total, hash_wyhash, NULL);
+
+	for (i = 0; i < total; i += 2)
+	{
+		set_insert(half, members[i]);
+		set_insert(half, others[i]);
+	}
+
+	size_t sizes[3];
+	double times[3];
+
+	set_init_set(&result, 1, hash_wyhash, NULL);
+
+	clk_reset(clk);
+	clk_start(clk);
+
+	set_intersection(set, half, result);
+
+	clk_stop(clk);
+
+	sizes[0] = result->size;
+	times[0] = clk->time;
+
+	set_delete_set(&result);
+
+	set_init_set(&result, 1, hash_wyhash, NULL);
+
+	clk_reset(clk);
+	clk_start(clk);
+
+	set_intersection_parallel(set, half, result, 4);
+
+	clk_stop(clk);
+
+	sizes[1] = result->size;
+	times[1] = clk->time;
+
+	set_delete_set(&result);
+
+	sizes[2] = 0;
+
+	clk_reset(clk);
+	clk_start(clk);
+
+	set_intersection_each(set, half, set_test_count, sizes + 2);
+
+	clk_stop(clk);
+
+	times[2] = clk->time;
+
+	printf("\n\n+-----------------------------+------------+------------+");
+	printf("\n| Intersection                |    size    |    time    |");
+	printf("\n+-----------------------------+------------+------------+");
+	printf("\n| set_intersection            | %10zu | %9.3lfs |", sizes[0], times[0]);
+	printf("\n| set_intersection_parallel 4 | %10zu | %9.3lfs |", sizes[1], times[1]);
+	printf("\n| set_intersection_each       | %10zu | %9.3lfs |", sizes[2], times[2]);
+	printf("\n+-----------------------------+------------+------------+");
+
+	set_delete_set(&half);
+
+	set_delete_set(&set);
+
+	clk_delete(&clk);
+
+	for (i = 0; i < total; i++)
+	{
+		free(members[i]);
+		free(others[i]);
+	}
+
+	free(members);
+	free(others);
+
 	printf("\n");
 	return 0;
 }
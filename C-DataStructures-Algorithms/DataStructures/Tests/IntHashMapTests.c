@@ -0,0 +1,146 @@
+/**
+ * @file IntHashMapTests.c
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Test cases for @c IntHashMap implementations in C
+ *
+ */
+
+#include "IntHashMap.h"
+#include "HashMap.h"
+#include "HashFunctions.h"
+#include "Clock.h"
+
+int IntHashMapTests(void)
+{
+	printf("\n");
+	printf(" +-------------------------------------+\n");
+	printf(" |                                     |\n");
+	printf(" |           C Int Hash Map            |\n");
+	printf(" |                                     |\n");
+	printf(" +-------------------------------------+\n");
+	printf("\n");
+
+	IntHashMap *map;
+	Status st;
+
+	int value;
+	size_t i, result;
+
+	imap_init_map(&map, 1);
+
+	imap_insert(map, 1815, 1);
+	imap_insert(map, 1912, 2);
+	imap_insert(map, -7, 3);
+	imap_insert(map, INT64_MAX, 4);
+
+	// Updates the value of an existing key
+	imap_insert(map, 1912, 20);
+
+	imap_display_map(map);
+
+	st = imap_search(map, 1912, &value);
+	print_status_repr(st);
+	printf("\nValue for key 1912 is %d", value);
+
+	st = imap_remove(map, -7);
+	print_status_repr(st);
+
+	st = imap_search(map, -7, &value);
+	print_status_repr(st);
+
+	imap_count_entries(map, &result);
+	printf("\nTotal entries: %zu", result);
+
+	imap_delete_map(&map);
+
+	// Integer ids against formatting them for a HashMap
+	const size_t total = 1 << 20;
+
+	int64_t *ids = malloc(sizeof(int64_t) * total);
+
+	for (i = 0; i < total; i++)
+		ids[i] = (int64_t)(i * 7919);
+
+	char key[32];
+
+	Clock *clk;
+	HashMap *smap;
+
+	clk_init(&clk);
+
+	clk_start(clk);
+
+	imap_init_map(&map, 1);
+
+	for (i = 0; i < total; i++)
+		imap_insert(map, ids[i], (int)i);
+
+	clk_stop(clk);
+
+	double t_insert = clk->time;
+
+	size_t wrong = 0;
+
+	clk_reset(clk);
+	clk_start(clk);
+
+	for (i = 0; i < total; i++)
+		if (imap_search(map, ids[i], &value) != DS_OK || value != (int)i)
+			wrong++;
+
+	clk_stop(clk);
+
+	double t_search = clk->time;
+
+	clk_reset(clk);
+	clk_start(clk);
+
+	map_init_map(&smap, 1, hash_wyhash);
+
+	for (i = 0; i < total; i++)
+	{
+		sprintf_s(key, 32, "%lld", (long long)ids[i]);
+
+		map_insert(smap, key, (int)i);
+	}
+
+	clk_stop(clk);
+
+	double t_sinsert = clk->time;
+
+	clk_reset(clk);
+	clk_start(clk);
+
+	for (i = 0; i < total; i++)
+	{
+		sprintf_s(key, 32, "%lld", (long long)ids[i]);
+
+		if (map_search(smap, key, &value) != DS_OK || value != (int)i)
+			wrong++;
+	}
+
+	clk_stop(clk);
+
+	double t_ssearch = clk->time;
+
+	printf("\n\n+-------------------+------------+------------+");
+	printf("\n| %17zu |   insert   |   search   |", total);
+	printf("\n+-------------------+------------+------------+");
+	printf("\n| IntHashMap        | %9.3lfs | %9.3lfs |", t_insert, t_search);
+	printf("\n| HashMap + sprintf | %9.3lfs | %9.3lfs |", t_sinsert, t_ssearch);
+	printf("\n+-------------------+------------+------------+");
+	printf("\nWrong values: %zu", wrong);
+
+	imap_delete_map(&map);
+	map_delete_map(&smap);
+
+	clk_delete(&clk);
+
+	free(ids);
+
+	printf("\n");
+	return 0;
+}
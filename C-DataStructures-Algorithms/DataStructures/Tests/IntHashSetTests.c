@@ -0,0 +1,160 @@
+/**
+ * @file IntHashSetTests.c
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Test cases for @c IntHashSet implementations in C
+ *
+ */
+
+#include "IntHashSet.h"
+#include "HashSet.h"
+#include "HashFunctions.h"
+#include "Clock.h"
+
+int IntHashSetTests(void)
+{
+	printf("\n");
+	printf(" +-------------------------------------+\n");
+	printf(" |                                     |\n");
+	printf(" |           C Int Hash Set            |\n");
+	printf(" |                                     |\n");
+	printf(" +-------------------------------------+\n");
+	printf("\n");
+
+	IntHashSet *set, *evens, *result;
+	Status st;
+
+	size_t i;
+
+	iset_init_set(&set, 1);
+	iset_init_set(&evens, 1);
+
+	for (i = 0; i < 12; i++)
+	{
+		iset_insert(set, (int64_t)i);
+		iset_insert(evens, (int64_t)(i * 2));
+	}
+
+	// Duplicates are ignored
+	iset_insert(set, 3);
+
+	iset_display_elements(set);
+
+	st = iset_remove(set, 11);
+	print_status_repr(st);
+
+	st = iset_remove(set, 11);
+	print_status_repr(st);
+
+	printf("\nContains 7: %d, contains 11: %d", iset_exists(set, 7), iset_exists(set, 11));
+
+	iset_init_set(&result, 1);
+
+	iset_intersection(set, evens, result);
+
+	printf("\n\nIntersection");
+	iset_display_elements(result);
+
+	iset_delete_set(&result);
+
+	iset_init_set(&result, 1);
+
+	iset_sym_diff(set, evens, result);
+
+	printf("\n\nSymmetric difference");
+	iset_display_elements(result);
+
+	iset_delete_set(&result);
+	iset_delete_set(&evens);
+	iset_delete_set(&set);
+
+	// Integer ids against formatting them for a HashSet
+	const size_t total = 1 << 20;
+
+	int64_t *ids = malloc(sizeof(int64_t) * total);
+
+	for (i = 0; i < total; i++)
+		ids[i] = (int64_t)(i * 7919);
+
+	char key[32];
+
+	Clock *clk;
+	HashSet *sset;
+
+	clk_init(&clk);
+
+	clk_start(clk);
+
+	iset_init_set(&set, 1);
+
+	for (i = 0; i < total; i++)
+		iset_insert(set, ids[i]);
+
+	clk_stop(clk);
+
+	double t_insert = clk->time;
+
+	size_t found = 0;
+
+	clk_reset(clk);
+	clk_start(clk);
+
+	for (i = 0; i < total; i++)
+		if (iset_exists(set, ids[i]))
+			found++;
+
+	clk_stop(clk);
+
+	double t_search = clk->time;
+
+	clk_reset(clk);
+	clk_start(clk);
+
+	set_init_set(&sset, 1, hash_wyhash, NULL);
+
+	for (i = 0; i < total; i++)
+	{
+		sprintf_s(key, 32, "%lld", (long long)ids[i]);
+
+		set_insert(sset, key);
+	}
+
+	clk_stop(clk);
+
+	double t_sinsert = clk->time;
+
+	clk_reset(clk);
+	clk_start(clk);
+
+	for (i = 0; i < total; i++)
+	{
+		sprintf_s(key, 32, "%lld", (long long)ids[i]);
+
+		if (set_exists(sset, key))
+			found++;
+	}
+
+	clk_stop(clk);
+
+	double t_ssearch = clk->time;
+
+	printf("\n\n+-------------------+------------+------------+");
+	printf("\n| %17zu |   insert   |   search   |", total);
+	printf("\n+-------------------+------------+------------+");
+	printf("\n| IntHashSet        | %9.3lfs | %9.3lfs |", t_insert, t_search);
+	printf("\n| HashSet + sprintf | %9.3lfs | %9.3lfs |", t_sinsert, t_ssearch);
+	printf("\n+-------------------+------------+------------+");
+	printf("\nElements found: %zu", found);
+
+	iset_delete_set(&set);
+	set_delete_set(&sset);
+
+	clk_delete(&clk);
+
+	free(ids);
+
+	printf("\n");
+	return 0;
+}
@@ -0,0 +1,160 @@
+/**
+ * @file PerfectHashTests.c
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Test cases for @c PerfectHash implementations in C
+ *
+ */
+
+#include "PerfectHash.h"
+#include "HashFunctions.h"
+#include "Clock.h"
+
+int PerfectHashTests(void)
+{
+	printf("\n");
+	printf(" +-------------------------------------+\n");
+	printf(" |                                     |\n");
+	printf(" |           C Perfect Hash            |\n");
+	printf(" |                                     |\n");
+	printf(" +-------------------------------------+\n");
+	printf("\n");
+
+	PerfectHash *mph;
+	Status st;
+
+	char *houses[] = {"Stark", "Lannister", "Targaryen", "Baratheon", "Greyjoy", "Tyrell", "Martell", "Arryn", "Tully"};
+	int seats[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+	size_t i, index, result;
+	int value;
+
+	st = mph_build(&mph, houses, 9, seats, 8, map_hash_djb2);
+	print_status_repr(st);
+
+	for (i = 0; i < 9; i++)
+	{
+		mph_index(mph, houses[i], &index);
+		mph_search(mph, houses[i], &value);
+
+		printf("\n%-10s index %zu value %d", houses[i], index, value);
+	}
+
+	// Rejected by its fingerprint with high probability
+	st = mph_search(mph, "Frey", &value);
+	print_status_repr(st);
+
+	mph_count_entries(mph, &result);
+	printf("\nTotal entries: %zu", result);
+
+	mph_delete(&mph);
+
+	// Duplicated keys can not be given distinct indices
+	char *twice[] = {"Stark", "Tully", "Stark"};
+
+	st = mph_build(&mph, twice, 3, NULL, 0, map_hash_djb2);
+	print_status_repr(st);
+
+	// Static map against HashMap
+	const size_t total = 1 << 20;
+
+	char **keys = malloc(sizeof(char *) * total);
+	char **others = malloc(sizeof(char *) * total);
+	int *values = malloc(sizeof(int) * total);
+
+	for (i = 0; i < total; i++)
+	{
+		keys[i] = malloc(32);
+		others[i] = malloc(32);
+
+		sprintf_s(keys[i], 32, "user:%zu", i * 7919);
+		sprintf_s(others[i], 32, "guest:%zu", i * 7919);
+
+		values[i] = (int)i;
+	}
+
+	Clock *clk;
+	HashMap *map;
+
+	clk_init(&clk);
+
+	map_init_map(&map, total, hash_wyhash);
+
+	for (i = 0; i < total; i++)
+		map_insert(map, keys[i], values[i]);
+
+	clk_start(clk);
+
+	mph_build(&mph, keys, total, values, 8, hash_wyhash);
+
+	clk_stop(clk);
+
+	double t_build = clk->time;
+
+	size_t wrong = 0;
+
+	clk_reset(clk);
+	clk_start(clk);
+
+	for (i = 0; i < total; i++)
+	{
+		if (mph_search(mph, keys[i], &value) != DS_OK || value != (int)i)
+			wrong++;
+	}
+
+	clk_stop(clk);
+
+	double t_mph = clk->time;
+
+	clk_reset(clk);
+	clk_start(clk);
+
+	for (i = 0; i < total; i++)
+	{
+		if (map_search(map, keys[i], &value) != DS_OK || value != (int)i)
+			wrong++;
+	}
+
+	clk_stop(clk);
+
+	double t_map = clk->time;
+
+	size_t accepted = 0;
+
+	for (i = 0; i < total; i++)
+	{
+		if (mph_contains(mph, others[i]))
+			accepted++;
+	}
+
+	printf("\n\nBuilt a perfect hash of %zu keys in %lf seconds", total, t_build);
+	printf("\n+--------------------+--------------+");
+	printf("\n| Structure          | Search (s)   |");
+	printf("\n+--------------------+--------------+");
+	printf("\n| PerfectHash        | %12lf |", t_mph);
+	printf("\n| HashMap            | %12lf |", t_map);
+	printf("\n+--------------------+--------------+");
+	printf("\n%zu wrong, %zu of %zu non-members accepted\n", wrong, accepted, total);
+
+	mph_display(mph);
+
+	mph_delete(&mph);
+	map_delete_map(&map);
+
+	clk_delete(&clk);
+
+	for (i = 0; i < total; i++)
+	{
+		free(keys[i]);
+		free(others[i]);
+	}
+
+	free(keys);
+	free(others);
+	free(values);
+
+	printf("\n");
+	return 0;
+}
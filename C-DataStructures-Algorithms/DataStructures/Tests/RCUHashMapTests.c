@@ -0,0 +1,235 @@
+/**
+ * @file RCUHashMapTests.c
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Test cases and benchmarks for @c RCUHashMap implementations in C
+ *
+ */
+
+#include "RCUHashMap.h"
+#include "ConcurrentHashMap.h"
+#include "HashFunctions.h"
+#include "Clock.h"
+
+#define RMAP_TEST_KEYS 16384
+#define RMAP_TEST_OPERATIONS 1048576
+#define RMAP_TEST_MAX_THREADS 16
+
+typedef struct RMapWorker
+{
+	RCUHashMap *rmap;		 // Read-optimized map or NULL to use cmap
+	ConcurrentHashMap *cmap;
+	char **keys;
+	size_t operations;
+	size_t seed;
+	size_t wrong;			 // Values read that were never written for their key
+} RMapWorker;
+
+static size_t rmap_test_random(size_t *state)
+{
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+
+	return *state;
+}
+
+// 99% searches, the other 1% alternates between updating and removing. The
+// value of keys[i] is always i so any other value read is an error.
+static DWORD WINAPI rmap_test_worker(LPVOID argument)
+{
+	RMapWorker *worker = argument;
+
+	size_t i, r, k, reader = 0, state = worker->seed;
+	int value;
+
+	if (worker->rmap != NULL && rmap_register_reader(worker->rmap, &reader) != DS_OK)
+		return 1;
+
+	for (i = 0; i < worker->operations; i++)
+	{
+		r = rmap_test_random(&state);
+		k = r % RMAP_TEST_KEYS;
+
+		bool read = (r >> 8) % 100 != 0;
+
+		if (worker->rmap != NULL)
+		{
+			if (read)
+			{
+				if (rmap_search(worker->rmap, reader, worker->keys[k], &value) == DS_OK && value != (int)k)
+					(worker->wrong)++;
+			}
+			else if (i & 1)
+				rmap_insert(worker->rmap, worker->keys[k], (int)k);
+			else
+				rmap_remove(worker->rmap, worker->keys[k]);
+		}
+		else
+		{
+			if (read)
+			{
+				if (cmap_search(worker->cmap, worker->keys[k], &value) == DS_OK && value != (int)k)
+					(worker->wrong)++;
+			}
+			else if (i & 1)
+				cmap_insert(worker->cmap, worker->keys[k], (int)k);
+			else
+				cmap_remove(worker->cmap, worker->keys[k]);
+		}
+	}
+
+	if (worker->rmap != NULL)
+		rmap_unregister_reader(worker->rmap, reader);
+
+	return 0;
+}
+
+// Millions of operations per second with threads workers
+static double rmap_test_run(RMapWorker *base, size_t threads, size_t *wrong)
+{
+	RMapWorker workers[RMAP_TEST_MAX_THREADS];
+	HANDLE handles[RMAP_TEST_MAX_THREADS];
+
+	Clock *clk;
+
+	clk_init(&clk);
+
+	clk_start(clk);
+
+	size_t i;
+	for (i = 0; i < threads; i++)
+	{
+		workers[i] = *base;
+		workers[i].operations = RMAP_TEST_OPERATIONS / threads;
+		workers[i].seed = (i + 1) * 2654435761u;
+
+		handles[i] = CreateThread(NULL, 0, rmap_test_worker, workers + i, 0, NULL);
+	}
+
+	WaitForMultipleObjects((DWORD)threads, handles, TRUE, INFINITE);
+
+	clk_stop(clk);
+
+	for (i = 0; i < threads; i++)
+	{
+		CloseHandle(handles[i]);
+
+		*wrong += workers[i].wrong;
+	}
+
+	double seconds = clk->time > 0.0 ? clk->time : 1.0 / CLOCKS_PER_SEC;
+
+	clk_delete(&clk);
+
+	return (double)RMAP_TEST_OPERATIONS / seconds / 1e6;
+}
+
+int RCUHashMapTests(void)
+{
+	printf("\n");
+	printf(" +-------------------------------------+\n");
+	printf(" |                                     |\n");
+	printf(" |           C RCU Hash Map            |\n");
+	printf(" |                                     |\n");
+	printf(" +-------------------------------------+\n");
+	printf("\n");
+
+	RCUHashMap *rmap;
+	ConcurrentHashMap *cmap;
+	Status st;
+
+	size_t reader, result;
+	int value;
+
+	rmap_init_map(&rmap, 4, map_hash_djb2);
+
+	rmap_register_reader(rmap, &reader);
+
+	rmap_insert(rmap, "Hello World!", 1);
+	rmap_insert(rmap, "Fire and Blood", 2);
+	rmap_insert(rmap, "Hear me Roar", 3);
+	rmap_insert(rmap, "Winter is Coming", 4);
+	rmap_insert(rmap, "Hello World!", 5); // Updates value
+
+	st = rmap_search(rmap, reader, "Hello World!", &value);
+	print_status_repr(st);
+	printf("\nValue for key Hello World! is %d", value);
+
+	st = rmap_remove(rmap, "Hear me Roar");
+	print_status_repr(st);
+
+	st = rmap_search(rmap, reader, "Hear me Roar", &value);
+	print_status_repr(st);
+
+	rmap_count_entries(rmap, &result);
+	printf("\nTotal entries: %zu", result);
+	rmap_count_retired(rmap, &result);
+	printf("\nRetired before reclaiming: %zu", result);
+
+	rmap_reclaim(rmap);
+
+	rmap_count_retired(rmap, &result);
+	printf("\nRetired after reclaiming: %zu", result);
+
+	rmap_unregister_reader(rmap, reader);
+
+	rmap_delete_map(&rmap);
+
+	// Throughput
+	char **keys = malloc(sizeof(char *) * RMAP_TEST_KEYS);
+
+	size_t i, j, wrong = 0;
+	for (i = 0; i < RMAP_TEST_KEYS; i++)
+	{
+		keys[i] = malloc(32);
+
+		sprintf_s(keys[i], 32, "session:%zu", i * 7919);
+	}
+
+	const size_t threads[] = {1, 2, 4, 8, 16};
+
+	printf("\n\n+---------+--------------+--------------+");
+	printf("\n| THREADS |   SHARDED    |     RCU      |");
+	printf("\n|         |   (Mops/s)   |   (Mops/s)   |");
+	printf("\n+---------+--------------+--------------+");
+
+	for (j = 0; j < sizeof(threads) / sizeof(threads[0]); j++)
+	{
+		rmap_init_map(&rmap, RMAP_TEST_KEYS, hash_wyhash);
+		cmap_init_map(&cmap, CONCURRENT_HASH_MAP_SHARDS, RMAP_TEST_KEYS, hash_wyhash);
+
+		for (i = 0; i < RMAP_TEST_KEYS; i++)
+		{
+			rmap_insert(rmap, keys[i], (int)i);
+			cmap_insert(cmap, keys[i], (int)i);
+		}
+
+		RMapWorker base = {NULL, cmap, keys, 0, 0, 0};
+
+		double sharded = rmap_test_run(&base, threads[j], &wrong);
+
+		base.rmap = rmap;
+
+		double rcu = rmap_test_run(&base, threads[j], &wrong);
+
+		printf("\n| %7zu | %12.2lf | %12.2lf |", threads[j], sharded, rcu);
+
+		rmap_delete_map(&rmap);
+		cmap_delete_map(&cmap);
+	}
+
+	printf("\n+---------+--------------+--------------+");
+
+	printf("\nInconsistent reads: %zu", wrong);
+
+	for (i = 0; i < RMAP_TEST_KEYS; i++)
+		free(keys[i]);
+
+	free(keys);
+
+	printf("\n");
+	return 0;
+}
@@ -10,12 +10,15 @@
 
 #include "SString.h"
 #include "Random.h"
+#include "Clock.h"
 
 int STR_IO_TESTS_0(void);
 int STR_IO_TESTS_1(void);
 int STR_REALLOC_TEST(void);
 int STR_COMPARE_TEST(void);
 int STR_COPY_TESTS(void);
+int STR_PIECE_TABLE_TEST(void);
+int STR_SEARCH_TEST(void);
 
 int SStringTests(void)
 {
@@ -32,6 +35,8 @@ int SStringTests(void)
 	//STR_REALLOC_TEST();
 	//STR_COMPARE_TEST();
 	//STR_COPY_TESTS();
+	STR_PIECE_TABLE_TEST();
+	STR_SEARCH_TEST();
 
 	String *str0, *str1, *str2, *str3;
 	Status st;
@@ -576,4 +581,225 @@ int STR_COPY_TESTS(void)
 	printf("\n");
 
 	return 0;
-}
\ No newline at end of file
+}
+
+int STR_PIECE_TABLE_TEST(void)
+{
+	printf("\n");
+	printf("\n ---------- ---------- ---------- --------- ---------- ---------- ----------");
+	printf("\n ---------- ---------- ---- STR_PIECE_TABLE_TEST ----- ---------- ----------");
+	printf("\n ---------- ---------- ---------- --------- ---------- ---------- ----------");
+	printf("\n");
+
+	String *str;
+
+	str_make(&str, "Short strings");
+	printf("\n\"%s\" is %s", str->buffer, str->buffer == str->small ? "inline" : "on the heap");
+	str_push_back(str, " move to the heap once they grow");
+	printf("\n\"%s\" is %s", str->buffer, str->buffer == str->small ? "inline" : "on the heap");
+
+	str_set_piece_table(str, true);
+	str_push_at(str, " only", 13);
+	str_remove(str, 0, 5);
+	str_display(str);
+
+	str_delete(&str);
+
+	// Splicing words into random positions of a large document and
+	// removing a few characters now and then
+	const size_t total = 1 << 22;
+	const size_t edits = 4000;
+
+	char *modes[] = {"Flat", "Piece table"};
+	char *words[] = {"lorem ", "ipsum ", "dolor ", "sit ", "amet "};
+	char line[65];
+
+	String *results[2];
+
+	size_t i, j, position;
+
+	Clock *clk;
+
+	clk_init(&clk);
+
+	for (i = 0; i < 64; i++)
+		line[i] = (char)('a' + i % 26);
+
+	line[64] = '\0';
+
+	printf("\n+-------------+------------+");
+	printf("\n|    Mode     |  time (s)  |");
+	printf("\n+-------------+------------+");
+
+	for (j = 0; j < 2; j++)
+	{
+		str_init(&results[j]);
+
+		for (i = 0; i < total / 64; i++)
+			str_push_back(results[j], line);
+
+		str_set_piece_table(results[j], j == 1);
+
+		srand(42);
+
+		clk_reset(clk);
+		clk_start(clk);
+
+		for (i = 0; i < edits; i++)
+		{
+			position = ((size_t)rand() * (RAND_MAX + (size_t)1) + (size_t)rand()) % results[j]->len;
+
+			if (i % 8 == 7)
+				str_remove(results[j], position, position);
+			else
+				str_push_at(results[j], words[i % 5], position);
+		}
+
+		clk_stop(clk);
+
+		printf("\n| %-11s | %10.3lf |", modes[j], clk->time);
+	}
+
+	printf("\n+-------------+------------+");
+
+	if (!str_equals(results[0], results[1]))
+		printf("\nResults differ between modes");
+
+	str_delete(&results[0]);
+	str_delete(&results[1]);
+
+	clk_delete(&clk);
+
+	printf("\n");
+	printf("\n ---------- ---------- ---------- --------- ---------- ---------- ----------");
+	printf("\n ---------- ---------- ---------- End tests ---------- ---------- ----------");
+	printf("\n ---------- ---------- ---------- --------- ---------- ---------- ----------");
+	printf("\n");
+
+	return 0;
+}
+
+int STR_SEARCH_TEST(void)
+{
+	printf("\n");
+	printf("\n ---------- ---------- ---------- --------- ---------- ---------- ----------");
+	printf("\n ---------- ---------- ------- STR_SEARCH_TEST ------- ---------- ----------");
+	printf("\n ---------- ---------- ---------- --------- ---------- ---------- ----------");
+	printf("\n");
+
+	String *str, *key;
+	size_t position, cursor;
+
+	str_make(&str, "One Ring to rule them all, One Ring to find them");
+	str_make(&key, "Ring");
+
+	str_find_substring(str, key, &position);
+	printf("\n\"Ring\" first found at %zu", position);
+	printf("\nHas \"them\": %s", str_substr(str, "them") ? "yes" : "no");
+	printf("\nHas \"Sauron\": %s", str_substr(str, "Sauron") ? "yes" : "no");
+	print_status_repr(str_find_substr(str, "Sauron", &position));
+
+	printf("\n\"n\" found at");
+
+	cursor = 0;
+	while (str_find_next(str, "n", &cursor, &position))
+		printf(" %zu", position);
+
+	str_delete(&str);
+	str_delete(&key);
+
+	// Counts every occurrence of needles of increasing length, taken from
+	// the middle of the text, with str_find_next and with strstr. Random
+	// text is the common case. A text of a single character with a needle
+	// that only differs in its middle character is the worst case for a
+	// naive search and for the filter, which has to fall back to Two-Way.
+	const size_t sizes[] = {1 << 24, 1 << 20};
+	const size_t lengths[] = {2, 4, 8, 16, 32, 64, 256, 1024};
+
+	char *texts[] = {"Random", "Periodic"};
+	char *text, *needle, *found;
+
+	size_t i, j, k, size, counts[2];
+
+	Clock *clk;
+
+	clk_init(&clk);
+
+	srand(42);
+
+	for (k = 0; k < 2; k++)
+	{
+		size = sizes[k];
+		text = malloc(size + 1);
+		needle = malloc(lengths[7] + 1);
+
+		for (i = 0; i < size; i++)
+			text[i] = k == 0 ? (char)('a' + rand() % 26) : 'a';
+
+		text[size] = '\0';
+
+		str_init(&str);
+		str_push_back(str, text);
+
+		printf("\n\n%s text of %zu characters", texts[k], size);
+		printf("\n+----------+---------------+---------------+");
+		printf("\n|  Needle  | find_next (s) |  strstr (s)   |");
+		printf("\n+----------+---------------+---------------+");
+
+		for (j = 0; j < 8; j++)
+		{
+			memcpy(needle, text + size / 2, lengths[j]);
+			needle[lengths[j]] = '\0';
+
+			if (k == 1)
+				needle[lengths[j] / 2] = 'b';
+
+			printf("\n| %8zu |", lengths[j]);
+
+			counts[0] = 0;
+			cursor = 0;
+
+			clk_reset(clk);
+			clk_start(clk);
+
+			while (str_find_next(str, needle, &cursor, &position))
+				counts[0]++;
+
+			clk_stop(clk);
+
+			printf(" %13.4lf |", clk->time);
+
+			counts[1] = 0;
+
+			clk_reset(clk);
+			clk_start(clk);
+
+			for (found = strstr(text, needle); found != NULL; found = strstr(found + 1, needle))
+				counts[1]++;
+
+			clk_stop(clk);
+
+			printf(" %13.4lf |", clk->time);
+
+			if (counts[0] != counts[1])
+				printf(" counts differ: %zu and %zu", counts[0], counts[1]);
+		}
+
+		printf("\n+----------+---------------+---------------+");
+
+		str_delete(&str);
+
+		free(text);
+		free(needle);
+	}
+
+	clk_delete(&clk);
+
+	printf("\n");
+	printf("\n ---------- ---------- ---------- --------- ---------- ---------- ----------");
+	printf("\n ---------- ---------- ---------- End tests ---------- ---------- ----------");
+	printf("\n ---------- ---------- ---------- --------- ---------- ---------- ----------");
+	printf("\n");
+
+	return 0;
+}
@@ -0,0 +1,171 @@
+/**
+ * @file ScanTests.c
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Test cases for vectorized integer scans
+ *
+ */
+
+#include "Scan.h"
+#include "Array.h"
+#include "DynamicArray.h"
+#include "Clock.h"
+
+int ScanTests(void)
+{
+	printf("\n");
+	printf(" +-------------------------------------+\n");
+	printf(" |                                     |\n");
+	printf(" |           C Integer Scans           |\n");
+	printf(" |                                     |\n");
+	printf(" +-------------------------------------+\n");
+	printf("\n");
+
+	DynamicArray *dar;
+	Array *arr;
+
+	int i, value;
+	size_t position, frequency;
+
+	dar_init(&dar);
+
+	for (i = 0; i < 1000; i++)
+		dar_insert_back(dar, (i * 7919) % 1000);
+
+	dar_find_max(dar, &value);
+	dar_find_max_pos(dar, &position);
+	printf("\nMaximum value: %d at position %zu", value, position);
+	dar_find_min(dar, &value);
+	dar_find_min_pos(dar, &position);
+	printf("\nMinimum value: %d at position %zu", value, position);
+
+	dar_frequency(dar, 500, &frequency);
+	printf("\nThe number 500 appears %zu times", frequency);
+
+	dar_find_occurrance_first(dar, 500, &position);
+	printf("\nFirst 500 at position %zu", position);
+	dar_find_occurrance_last(dar, 500, &position);
+	printf("\nLast 500 at position %zu", position);
+
+	print_status_repr(dar_find_occurrance_first(dar, 1000, &position));
+
+	arr_init(&arr, 1000);
+
+	for (i = 0; i < 1000; i++)
+		arr->buffer[i] = dar->buffer[i] % 10;
+
+	arr_max(arr, &value);
+	printf("\nArray maximum: %d", value);
+	arr_frequency(arr, 7, &value);
+	printf("\nThe number 7 appears %d times in the Array", value);
+
+	arr_delete(&arr);
+	dar_delete(&dar);
+
+	// Throughput of each kernel over a buffer larger than the caches. The
+	// searched value is absent so every scan reads the whole buffer and
+	// scan_remove rewrites it unchanged. No element has its high byte set so
+	// the needle of scan_find_bytes is absent too.
+	const size_t total = 1 << 24;
+	const size_t rounds = 16;
+
+	int *data = malloc(sizeof(int) * total);
+
+	size_t j, k;
+	for (j = 0; j < total; j++)
+		data[j] = (int)((j * 2654435761u) % 1000000);
+
+	char *kernels[] = {"Scalar", "SSE4.1", "AVX2", "AVX-512"};
+	char *scans[] = {"scan_count", "scan_find_first", "scan_find_last", "scan_max", "scan_min", "scan_remove", "scan_find_bytes"};
+	char needle[] = "\xff\xff\xff\xff\xff\xff\xff\xff";
+
+	double rates[7][4];
+	size_t checks[4];
+
+	Clock *clk;
+
+	clk_init(&clk);
+
+	for (k = 0; k < 4; k++)
+	{
+		if (scan_set_kernel((ScanKernel)(k + 1)) != DS_OK)
+		{
+			for (j = 0; j < 7; j++)
+				rates[j][k] = 0.0;
+
+			continue;
+		}
+
+		checks[k] = 0;
+
+		for (j = 0; j < 7; j++)
+		{
+			size_t r;
+
+			clk_reset(clk);
+			clk_start(clk);
+
+			for (r = 0; r < rounds; r++)
+			{
+				if (j == 0)
+					checks[k] += scan_count(data, total, -1);
+				else if (j == 1)
+					checks[k] += scan_find_first(data, total, -1);
+				else if (j == 2)
+					checks[k] += scan_find_last(data, total, -1);
+				else if (j == 3)
+					checks[k] += (size_t)scan_max(data, total);
+				else if (j == 4)
+					checks[k] += (size_t)scan_min(data, total);
+				else if (j == 5)
+					checks[k] += scan_remove(data, total, -1);
+				else
+					checks[k] += scan_find_bytes((const char *)data, sizeof(int) * total, needle, 8);
+			}
+
+			clk_stop(clk);
+
+			rates[j][k] = (double)(sizeof(int) * total * rounds) / clk->time / 1e9;
+		}
+	}
+
+	scan_set_kernel(SCAN_KERNEL_AUTO);
+
+	printf("\n\n+-----------------+------------+------------+------------+------------+");
+	printf("\n|      GB/s       |");
+
+	for (k = 0; k < 4; k++)
+		printf(" %10s |", kernels[k]);
+
+	printf("\n+-----------------+------------+------------+------------+------------+");
+
+	for (j = 0; j < 7; j++)
+	{
+		printf("\n| %-15s |", scans[j]);
+
+		for (k = 0; k < 4; k++)
+		{
+			if (rates[j][k] > 0.0)
+				printf(" %10.2lf |", rates[j][k]);
+			else
+				printf(" %10s |", "-");
+		}
+	}
+
+	printf("\n+-----------------+------------+------------+------------+------------+");
+
+	for (k = 1; k < 4; k++)
+	{
+		if (rates[0][k] > 0.0 && checks[k] != checks[0])
+			printf("\n%s results differ from the scalar kernel", kernels[k]);
+	}
+
+	clk_delete(&clk);
+
+	free(data);
+
+	printf("\n");
+	return 0;
+}
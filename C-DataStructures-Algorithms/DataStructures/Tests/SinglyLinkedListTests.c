@@ -12,6 +12,11 @@
 
 int SLL_IO_TESTS(void);
 
+static bool sll_test_multiple(int value, void *data)
+{
+	return value % *(int *)data == 0;
+}
+
 int SinglyLinkedListTests(void)
 {
 	printf("\n");
@@ -585,6 +590,24 @@ int SinglyLinkedListTests(void)
 	sll_delete_list(&sll1);
 	sll_delete_list(&sll2);
 
+	// Removing keys keeps the tail valid when the last nodes go
+	sll_init_list(&sll);
+
+	for (i = 0; i < 20; i++)
+		sll_insert_tail(sll, i % 5);
+
+	int divisor = 2;
+
+	printf("\n ---------- Remove 4 and then even numbers\n");
+	sll_remove_keys(sll, 4);
+	sll_display(sll);
+
+	sll_remove_if(sll, sll_test_multiple, &divisor);
+	sll_insert_tail(sll, 10);
+	sll_display(sll);
+
+	sll_delete_list(&sll);
+
 	printf("\n");
 	return 0;
 }
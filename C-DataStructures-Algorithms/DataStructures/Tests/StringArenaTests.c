@@ -0,0 +1,134 @@
+/**
+ * @file StringArenaTests.c
+ *
+ * @author Leonardo Vencovsky (https://github.com/LeoVen)
+ * @date 16/10/2026
+ *
+ * @brief Test cases and benchmarks for @c StringArena implementations in C
+ *
+ */
+
+#include "StringArena.h"
+#include "HashFunctions.h"
+#include "HashMap.h"
+#include "HashSet.h"
+#include "Clock.h"
+
+// Seconds taken to build a map of total keys, optionally using an arena
+static double arn_build_map(size_t total, bool arena)
+{
+	HashMap *map;
+	Clock *clk;
+
+	char key[64];
+
+	size_t i;
+
+	clk_init(&clk);
+
+	map_init_map(&map, 1, hash_wyhash);
+
+	if (arena)
+		map_use_arena(map, 0);
+
+	clk_start(clk);
+
+	for (i = 0; i < total; i++)
+	{
+		sprintf_s(key, sizeof(key), "user:%zu:session", i);
+
+		map_insert(map, key, (int)i);
+	}
+
+	clk_stop(clk);
+
+	double result = clk->time;
+
+	if (arena)
+		arn_display_arena(map->arena);
+
+	clk_reset(clk);
+	clk_start(clk);
+
+	map_delete_map(&map);
+
+	clk_stop(clk);
+
+	printf("\nDeleted in %lf seconds", clk->time);
+
+	clk_delete(&clk);
+
+	return result;
+}
+
+int StringArenaTests(void)
+{
+	printf("\n");
+	printf(" +-------------------------------------+\n");
+	printf(" |                                     |\n");
+	printf(" |           C String Arena            |\n");
+	printf(" |                                     |\n");
+	printf(" +-------------------------------------+\n");
+	printf("\n");
+
+	StringArena *arena;
+
+	arn_init_arena(&arena, 64);
+
+	char *s1, *s2, *s3;
+	void *block;
+
+	arn_strdup(arena, "Hello World!", &s1);
+	arn_strndup(arena, "Lorem Ipsum Dolor", 11, &s2);
+	arn_alloc(arena, 100, &block);
+	arn_strdup(arena, "Winter is Coming", &s3);
+
+	printf("\n%s\n%s\n%s", s1, s2, s3);
+
+	arn_display_arena(arena);
+
+	arn_reset(arena);
+
+	arn_display_arena(arena);
+
+	arn_delete_arena(&arena);
+
+	// HashSet entries and keys
+	HashSet *set;
+
+	set_init_set(&set, 20, set_hash_djb2, set_rehash_rj);
+
+	set_use_arena(set, 0);
+
+	set_insert(set, "Ada Lovelace");
+	set_insert(set, "Alan Turing");
+	set_insert(set, "Isaac Newton");
+	set_remove(set, "Alan Turing");
+
+	set_display_elements(set);
+
+	arn_display_arena(set->arena);
+
+	set_erase_set(&set);
+
+	set_insert(set, "Carl Friedrich Gauss");
+
+	set_display_elements(set);
+
+	set_delete_set(&set);
+
+	// HashMap build time
+	const size_t total = 500000;
+
+	double t_malloc = arn_build_map(total, false);
+	double t_arena = arn_build_map(total, true);
+
+	printf("\n\n+------------+------------+------------+");
+	printf("\n|    KEYS    |   malloc   |   arena    |");
+	printf("\n+------------+------------+------------+");
+	printf("\n| %10zu | %9.3lfs | %9.3lfs |", total, t_malloc, t_arena);
+	printf("\n+------------+------------+------------+");
+
+	printf("\n");
+	return 0;
+}